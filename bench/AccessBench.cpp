@@ -0,0 +1,190 @@
+/** \file AccessBench.cpp
+  *
+  * The cost of each path to the elements, against indexing a raw pointer. Every measurement
+  * sums the elements of a 3D container of 'int' that fits in the L2 cache, so the loops are
+  * limited by the computation of the positions and not by the memory. A path that compiles
+  * down to raw indexing has the same time as its 'raw' baseline.
+  *
+  * The variants are the overloads of 'operator()' (integral, iterable, iterator,
+  * 'std::initializer_list' and tuple), slices, static, fixed rank and dynamic shapes, fixed
+  * rank with 32 bits positions, and iteration with 'begin()' and 'end()'. The slices of the
+  * container are also compared with the slices of a 'StridedView'.
+*/
+
+#include <numeric>
+#include <tuple>
+
+#include "Benchmark.h"
+#include "Container/Strided.h"
+
+
+
+constexpr int n = 64;
+
+
+
+/// Sums the results of 'f(i, j, k)' over the indices of an 'n x n x n' container
+template <class F>
+void report (const std::string& name, const std::string& variant, F f)
+{
+    const std::size_t size = std::size_t(n) * n * n;
+
+    const double t = bench::measure([&]{
+        int s = 0;
+
+        for(int i = 0; i < n; ++i)
+            for(int j = 0; j < n; ++j)
+                for(int k = 0; k < n; ++k)
+                    s += f(i, j, k);
+
+        bench::doNotOptimize(s);
+    }, 20);
+
+    bench::report(name, variant, size, t, 1.0 * size * sizeof(int));
+}
+
+
+
+/// Every overload of 'operator()' for the container 'c'
+template <class C>
+void runAccess (const std::string& shape, C& c)
+{
+    const int* p = c.data();
+
+    report("access_" + shape, "raw", [&](int i, int j, int k){ return p[(i * n + j) * n + k]; });
+
+    report("access_" + shape, "integral", [&](int i, int j, int k){ return c(i, j, k); });
+
+    report("access_" + shape, "iterable", [&](int i, int j, int k){ return c(std::array<int, 3>{ i, j, k }); });
+
+    report("access_" + shape, "mixed", [&](int i, int j, int k){ return c(i, std::array<int, 2>{ j, k }); });
+
+    report("access_" + shape, "iterator", [&](int i, int j, int k){
+        const int idx[] = { i, j, k };
+        return c(std::begin(idx));
+    });
+
+    report("access_" + shape, "initializer_list", [&](int i, int j, int k){ return c({ i, j, k }); });
+
+    report("access_" + shape, "tuple", [&](int i, int j, int k){ return c(std::make_tuple(i, j, k)); });
+}
+
+
+
+/// Creating a slice and accessing it, against the same positions of the raw pointer
+template <class C>
+void runSlice (const std::string& shape, C& c)
+{
+    const int* p = c.data();
+
+    report("slice_" + shape, "raw", [&](int i, int j, int k){ return p[(i * n + j) * n + k]; });
+
+    report("slice_" + shape, "slice_2d", [&](int i, int j, int k){ return c.slice(i)(j, k); });
+
+    report("slice_" + shape, "slice_1d", [&](int i, int j, int k){ return c.slice(i, j)(k); });
+
+    report("slice_" + shape, "slice_1d_index", [&](int i, int j, int k){ return c.slice(i, j)[k]; });
+
+    const auto v = cnt::strided<3>(c);
+
+    report("slice_" + shape, "strided_1d", [v](int i, int j, int k){ return v.slice(i, j)(k); });
+}
+
+
+
+/// Iteration over all the elements, and over a slice, against a loop over the raw pointer
+template <class C>
+void runIteration (const std::string& shape, C& c)
+{
+    const std::size_t size = c.size();
+
+    const int* p = c.data();
+
+    auto iterate = [&](const std::string& name, const std::string& variant, std::size_t elements, auto f){
+        const double t = bench::measure([&]{
+            int s = f();
+            bench::doNotOptimize(s);
+        }, 20);
+
+        bench::report(name, variant, elements, t, 1.0 * elements * sizeof(int));
+    };
+
+
+    iterate("iterate_" + shape, "raw", size, [&]{
+        int s = 0;
+
+        for(std::size_t i = 0; i < size; ++i)
+            s += p[i];
+
+        return s;
+    });
+
+    iterate("iterate_" + shape, "range_for", size, [&]{
+        int s = 0;
+
+        for(int x : c)
+            s += x;
+
+        return s;
+    });
+
+    iterate("iterate_" + shape, "accumulate", size, [&]{
+        return std::accumulate(c.begin(), c.end(), 0);
+    });
+
+
+    auto sl = c.slice(n / 2);
+
+    const std::size_t first = std::size_t(n / 2) * n * n, sliceSize = sl.size();
+
+    iterate("iterate_slice_" + shape, "raw", sliceSize, [&]{
+        int s = 0;
+
+        for(std::size_t i = 0; i < sliceSize; ++i)
+            s += p[first + i];
+
+        return s;
+    });
+
+    iterate("iterate_slice_" + shape, "range_for", sliceSize, [&]{
+        int s = 0;
+
+        for(int x : sl)
+            s += x;
+
+        return s;
+    });
+}
+
+
+
+template <class C>
+void run (const std::string& shape, C& c)
+{
+    std::iota(c.begin(), c.end(), 0);
+
+    runAccess(shape, c);
+    runSlice(shape, c);
+    runIteration(shape, c);
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    cnt::Container<int, n, n, n> a;
+    cnt::Container<int, 0, 0, 0> b(n, n, n);
+    cnt::Container<int> c(n, n, n);
+    cnt::BasicContainer<int, cnt::Shape<0, 0, 0>, std::allocator<int>, cnt::RowMajor, std::uint32_t> d(n, n, n);
+
+    run("static", a);
+    run("fixed_rank", b);
+    run("dynamic", c);
+    run("fixed_rank_u32", d);
+
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/** \file AllocatorBench.cpp
+  *
+  * Streaming kernels (copy, triad and sum) over large containers using the default,
+  * the 64 bytes aligned and the huge page allocators. Also the construction of a container
+  * that is filled right after, with value initialized elements, with 'uninitialized' and
+  * with 'uninitialized' followed by 'parallel_fill'.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Container.h"
+#include "Container/Parallel.h"
+
+
+
+template <class Alloc>
+void run (const std::string& variant, std::size_t rows, std::size_t cols)
+{
+    using Cnt = cnt::BasicContainer<float, cnt::Shape<0, 0>, Alloc>;
+
+    Cnt a(rows, cols), b(rows, cols), c(rows, cols);
+
+    std::iota(b.begin(), b.end(), 0.0f);
+    std::fill(c.begin(), c.end(), 2.0f);
+
+    const std::size_t n = a.size();
+
+
+    double t = bench::measure([&]{
+        std::copy(b.begin(), b.end(), a.begin());
+        bench::doNotOptimize(a);
+    });
+
+    bench::report("copy", variant, n, t, 2.0 * n * sizeof(float));
+
+
+    t = bench::measure([&]{
+        float* pa = a.data();
+        const float* pb = b.data();
+        const float* pc = c.data();
+
+        for(std::size_t i = 0; i < n; ++i)
+            pa[i] = pb[i] + 3.0f * pc[i];
+
+        bench::doNotOptimize(a);
+    });
+
+    bench::report("triad", variant, n, t, 3.0 * n * sizeof(float));
+
+
+    t = bench::measure([&]{
+        float s = std::accumulate(a.begin(), a.end(), 0.0f);
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("sum", variant, n, t, 1.0 * n * sizeof(float));
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+    const std::size_t rows = 1 << 12, cols = 1 << 13;
+
+    run<std::allocator<float>>("std", rows, cols);
+    run<cnt::AlignedAllocator<float, 64>>("aligned64", rows, cols);
+    run<cnt::HugePageAllocator<float>>("hugepage", rows, cols);
+
+
+    const std::size_t n = rows * cols;
+
+    double t = bench::measure([&]{
+        cnt::Container<float, 0, 0> a(rows, cols);
+        std::fill(a.begin(), a.end(), 1.0f);
+        bench::doNotOptimize(a);
+    });
+
+    bench::report("construct_fill", "value_init", n, t, 1.0 * n * sizeof(float));
+
+
+    t = bench::measure([&]{
+        cnt::Container<float, 0, 0> a(cnt::uninitialized, rows, cols);
+        std::fill(a.begin(), a.end(), 1.0f);
+        bench::doNotOptimize(a);
+    });
+
+    bench::report("construct_fill", "uninitialized", n, t, 1.0 * n * sizeof(float));
+
+
+    t = bench::measure([&]{
+        cnt::Container<float, 0, 0> a(cnt::uninitialized, rows, cols);
+        cnt::parallel_fill(a, 1.0f);
+        bench::doNotOptimize(a);
+    });
+
+    bench::report("construct_fill", "parallel_fill", n, t, 1.0 * n * sizeof(float));
+
+
+    return 0;
+}
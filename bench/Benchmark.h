@@ -0,0 +1,83 @@
+/** \file Benchmark.h
+  *
+  * A tiny harness for the benchmarks. Each measurement is printed as a CSV line:
+  *
+  *     benchmark,variant,elements,ns_per_element,gb_per_s
+*/
+
+#ifndef CNT_BENCHMARK_H
+#define CNT_BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <limits>
+#include <algorithm>
+
+
+namespace bench
+{
+
+/// Keeps the compiler from optimizing away the computation of 'x'
+template <typename T>
+inline void doNotOptimize (T&& x)
+{
+    asm volatile("" : : "g"(&x) : "memory");
+}
+
+
+/// Best time in seconds of calling 'f' 'reps' times, after one warm up call
+template <class F>
+double measure (F f, int reps = 5)
+{
+    f();
+
+    double best = std::numeric_limits<double>::max();
+
+    for(int i = 0; i < reps; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        f();
+
+        auto end = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    return best;
+}
+
+
+/// Prints the CSV header
+inline void header ()
+{
+    std::printf("benchmark,variant,elements,ns_per_element,gb_per_s\n");
+}
+
+
+/** Prints a measurement of 'seconds' for 'elements' elements, that moved 'bytes' bytes
+  * from or to memory.
+*/
+inline void report (const std::string& name, const std::string& variant, std::size_t elements,
+                    double seconds, double bytes)
+{
+    std::printf("%s,%s,%zu,%.4f,%.3f\n", name.c_str(), variant.c_str(), elements,
+                1e9 * seconds / elements, bytes / seconds / 1e9);
+
+    std::fflush(stdout);
+}
+
+
+/** Prints a measurement of 'seconds' for 'flops' floating point operations. The operations take
+  * the place of the elements, so the last column is the rate in GFLOP/s.
+*/
+inline void reportFlops (const std::string& name, const std::string& variant, double flops, double seconds)
+{
+    report(name, variant, std::size_t(flops), seconds, flops);
+}
+
+} // namespace bench
+
+
+#endif // CNT_BENCHMARK_H
@@ -0,0 +1,72 @@
+/** \file ChunkedBench.cpp
+  *
+  * Reading a box of a 'Chunked' container element by element, through the cache of
+  * decompressed chunks, against a bulk 'read', which decompresses each chunk once. Also the
+  * compression of a dense container with 'chunked' and its decompression with 'dense'.
+*/
+
+#include <cmath>
+
+#include "Benchmark.h"
+#include "Container/Chunked.h"
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    const std::size_t n = 256;
+
+    cnt::Container<float, 0, 0, 0> a(n, n, n);
+
+    for(std::size_t i = 0; i < n; ++i)
+        for(std::size_t j = 0; j < n; ++j)
+            for(std::size_t k = 0; k < n; ++k)
+                a(i, j, k) = std::sin(0.01f * i) * std::cos(0.02f * j) + 0.001f * k;
+
+    const double bytes = 1.0 * a.size() * sizeof(float);
+
+
+    double t = bench::measure([&]{
+        auto c = cnt::chunked(a, {32, 32, 32});
+        bench::doNotOptimize(c);
+    }, 3);
+
+    bench::report("compress", "chunked", a.size(), t, bytes);
+
+
+    const auto c = cnt::chunked(a, {32, 32, 32}, 16);
+
+    t = bench::measure([&]{
+        auto d = cnt::dense(c);
+        bench::doNotOptimize(d);
+    }, 3);
+
+    bench::report("decompress", "dense", a.size(), t, bytes);
+
+
+    const std::size_t m = 128;
+
+    t = bench::measure([&]{
+        cnt::Container<float, 0, 0, 0> d(m, m, m);
+
+        for(std::size_t i = 0; i < m; ++i)
+            for(std::size_t j = 0; j < m; ++j)
+                for(std::size_t k = 0; k < m; ++k)
+                    d(i, j, k) = c(i + 16, j + 16, k + 16);
+
+        bench::doNotOptimize(d);
+    }, 3);
+
+    bench::report("read_box", "elements", m * m * m, t, m * m * m * sizeof(float));
+
+
+    t = bench::measure([&]{
+        auto d = c.read({16, 16, 16}, {16 + m, 16 + m, 16 + m});
+        bench::doNotOptimize(d);
+    }, 3);
+
+    bench::report("read_box", "bulk", m * m * m, t, m * m * m * sizeof(float));
+}
@@ -0,0 +1,96 @@
+/** \file GemmBench.cpp
+  *
+  * 'matmul' against the triple loop over 'operator()', for square matrices of 'float' and
+  * 'double', with a transposed operand and for a stack of small matrices. The rates are printed
+  * with 'bench::reportFlops', so the last column is in GFLOP/s.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Gemm.h"
+#include "Container/Permute.h"
+
+
+
+template <typename T>
+void run (const std::string& type)
+{
+    for(std::size_t n : { 256, 512, 1024 })
+    {
+        cnt::Container<T, 0, 0> a(n, n), b(n, n), c(n, n);
+
+        std::iota(a.begin(), a.end(), T(0));
+        std::iota(b.begin(), b.end(), T(1));
+
+        const double flops = 2.0 * n * n * n;
+
+        const std::string name = "gemm_" + type + "_" + std::to_string(n);
+
+
+        if(n <= 512)
+        {
+            double t = bench::measure([&]{
+                for(std::size_t i = 0; i < n; ++i)
+                    for(std::size_t j = 0; j < n; ++j)
+                    {
+                        T s = T(0);
+
+                        for(std::size_t p = 0; p < n; ++p)
+                            s += a(i, p) * b(p, j);
+
+                        c(i, j) = s;
+                    }
+
+                bench::doNotOptimize(c);
+            }, 1);
+
+            bench::reportFlops(name, "naive", flops, t);
+        }
+
+
+        double t = bench::measure([&]{
+            cnt::matmul(a, b, c);
+            bench::doNotOptimize(c);
+        });
+
+        bench::reportFlops(name, "matmul", flops, t);
+
+
+        t = bench::measure([&]{
+            cnt::matmul(cnt::permuted(a, {1, 0}), b, c);
+            bench::doNotOptimize(c);
+        });
+
+        bench::reportFlops(name, "matmul_transposed", flops, t);
+    }
+
+
+    {
+        const std::size_t batches = 256, n = 64;
+
+        cnt::Container<T, 0, 0, 0> a(batches, n, n), b(batches, n, n), c(batches, n, n);
+
+        std::iota(a.begin(), a.end(), T(0));
+        std::iota(b.begin(), b.end(), T(1));
+
+        double t = bench::measure([&]{
+            cnt::matmul(a, b, c);
+            bench::doNotOptimize(c);
+        });
+
+        bench::reportFlops("batched_" + type + "_256x64", "matmul", 2.0 * batches * n * n * n, t);
+    }
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+    run<float>("float");
+    run<double>("double");
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/** \file KernelsBench.cpp
+  *
+  * The reductions and elementwise kernels of 'Kernels.h' with each supported instruction set,
+  * against the standard algorithms over the iterators of the container.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Kernels.h"
+
+
+
+template <typename T>
+void runStd (const std::string& type, std::size_t n)
+{
+    cnt::Container<T> a(n), b(n);
+
+    std::iota(a.begin(), a.end(), T(0));
+    std::fill(b.begin(), b.end(), T(1));
+
+
+    double t = bench::measure([&]{
+        T s = std::accumulate(a.begin(), a.end(), T(0));
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("sum_" + type, "std", n, t, 1.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        T s = *std::max_element(a.begin(), a.end());
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("max_" + type, "std", n, t, 1.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        T s = std::inner_product(a.begin(), a.end(), b.begin(), T(0));
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("dot_" + type, "std", n, t, 2.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        std::transform(a.begin(), a.end(), b.begin(), b.begin(), [](T x, T y){ return T(2) * x + y; });
+        bench::doNotOptimize(b);
+    });
+
+    bench::report("axpy_" + type, "std", n, t, 3.0 * n * sizeof(T));
+}
+
+
+template <typename T>
+void runKernels (const std::string& type, const std::string& variant, std::size_t n)
+{
+    cnt::Container<T> a(n), b(n);
+
+    std::iota(a.begin(), a.end(), T(0));
+    cnt::fill(b, T(1));
+
+
+    double t = bench::measure([&]{
+        T s = cnt::sum(a);
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("sum_" + type, variant, n, t, 1.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        T s = cnt::max(a);
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("max_" + type, variant, n, t, 1.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        T s = cnt::dot(a, b);
+        bench::doNotOptimize(s);
+    });
+
+    bench::report("dot_" + type, variant, n, t, 2.0 * n * sizeof(T));
+
+
+    t = bench::measure([&]{
+        cnt::axpy(T(2), a, b);
+        bench::doNotOptimize(b);
+    });
+
+    bench::report("axpy_" + type, variant, n, t, 3.0 * n * sizeof(T));
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+    const std::size_t n = 1 << 16;     // Fits in the L2 cache, so the kernels are not memory bound
+
+    const std::pair<cnt::Isa, std::string> isas[] = { { cnt::Isa::Scalar, "scalar" }, { cnt::Isa::SSE, "sse" },
+                                                      { cnt::Isa::AVX2, "avx2" }, { cnt::Isa::AVX512, "avx512" } };
+
+    runStd<float>("float", n);
+    runStd<double>("double", n);
+    runStd<int>("int", n);
+
+    for(const auto& isa : isas)
+    {
+        if(isa.first > cnt::bestIsa())
+            continue;
+
+        cnt::activeIsa() = isa.first;
+
+        runKernels<float>("float", isa.second, n);
+        runKernels<double>("double", isa.second, n);
+        runKernels<int>("int", isa.second, n);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/** \file LayoutBench.cpp
+  *
+  * Neighbour access through 'operator()' for each layout: a 5 point stencil over a 2D
+  * container and a 7 point stencil over a 3D one, sweeping the indices in row major order and
+  * in column major order.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Container.h"
+
+
+
+template <class L>
+using Grid2 = cnt::BasicContainer<float, cnt::Shape<0, 0>, std::allocator<float>, L>;
+
+template <class L>
+using Grid3 = cnt::BasicContainer<float, cnt::Shape<0, 0, 0>, std::allocator<float>, L>;
+
+
+
+template <class C>
+float stencil2 (const C& c, bool rowOrder)
+{
+    const int n = c.size(0), m = c.size(1);
+
+    float s = 0.0f;
+
+    auto point = [&](int i, int j){
+        s += 4.0f * c(i, j) - c(i - 1, j) - c(i + 1, j) - c(i, j - 1) - c(i, j + 1);
+    };
+
+    if(rowOrder)
+        for(int i = 1; i < n - 1; ++i)
+            for(int j = 1; j < m - 1; ++j)
+                point(i, j);
+
+    else
+        for(int j = 1; j < m - 1; ++j)
+            for(int i = 1; i < n - 1; ++i)
+                point(i, j);
+
+    return s;
+}
+
+
+template <class C>
+float stencil3 (const C& c, bool rowOrder)
+{
+    const int n = c.size(0), m = c.size(1), o = c.size(2);
+
+    float s = 0.0f;
+
+    auto point = [&](int i, int j, int k){
+        s += 6.0f * c(i, j, k) - c(i - 1, j, k) - c(i + 1, j, k) - c(i, j - 1, k)
+                               - c(i, j + 1, k) - c(i, j, k - 1) - c(i, j, k + 1);
+    };
+
+    if(rowOrder)
+        for(int i = 1; i < n - 1; ++i)
+            for(int j = 1; j < m - 1; ++j)
+                for(int k = 1; k < o - 1; ++k)
+                    point(i, j, k);
+
+    else
+        for(int k = 1; k < o - 1; ++k)
+            for(int j = 1; j < m - 1; ++j)
+                for(int i = 1; i < n - 1; ++i)
+                    point(i, j, k);
+
+    return s;
+}
+
+
+
+template <class L2, class L3>
+void run (const std::string& variant, std::size_t n2, std::size_t n3)
+{
+    Grid2<L2> a(n2, n2);
+    Grid3<L3> b(n3, n3, n3);
+
+    std::iota(a.begin(), a.end(), 0.0f);
+    std::iota(b.begin(), b.end(), 0.0f);
+
+
+    for(bool rowOrder : { true, false })
+    {
+        const std::string order = rowOrder ? "_rows" : "_columns";
+
+        double t = bench::measure([&]{
+            float s = stencil2(a, rowOrder);
+            bench::doNotOptimize(s);
+        });
+
+        bench::report("stencil2d" + order, variant, a.size(), t, 1.0 * a.size() * sizeof(float));
+
+
+        t = bench::measure([&]{
+            float s = stencil3(b, rowOrder);
+            bench::doNotOptimize(s);
+        });
+
+        bench::report("stencil3d" + order, variant, b.size(), t, 1.0 * b.size() * sizeof(float));
+    }
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+    const std::size_t n2 = 2048, n3 = 128;     // 16 MB and 8 MB, larger than the caches
+
+    run<cnt::RowMajor, cnt::RowMajor>("row_major", n2, n3);
+    run<cnt::ColumnMajor, cnt::ColumnMajor>("column_major", n2, n3);
+    run<cnt::Tiled<4, 4>, cnt::Tiled<4, 4, 4>>("tiled_4", n2, n3);
+    run<cnt::Tiled<8, 8>, cnt::Tiled<8, 8, 8>>("tiled_8", n2, n3);
+    run<cnt::Morton, cnt::Morton>("morton", n2, n3);
+
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+/** \file NdIndexBench.cpp
+  *
+  * Writing every element from its indices: nested loops over 'operator()' against 'ndindex',
+  * for containers with a fixed and a runtime number of dimensions, a slice and a strided view.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/NdIndex.h"
+
+
+
+/// Nested loops over the 3 dimensions of 'c', calling 'operator()'
+template <class C>
+void nested (C& c)
+{
+    for(std::size_t i = 0; i < c.size(0); ++i)
+        for(std::size_t j = 0; j < c.size(1); ++j)
+            for(std::size_t k = 0; k < c.size(2); ++k)
+                c(i, j, k) = float(i + 2 * j + 3 * k);
+}
+
+
+template <class C>
+void indexed (C& c)
+{
+    for(auto e : cnt::ndindex(c))
+        e.value = float(e.index[0] + 2 * e.index[1] + 3 * e.index[2]);
+}
+
+
+
+template <class C>
+void run (const std::string& name, C& c)
+{
+    const std::size_t n = c.size(0) * c.size(1) * c.size(2);
+
+    double t = bench::measure([&]{
+        nested(c);
+        bench::doNotOptimize(c);
+    });
+
+    bench::report(name, "operator()", n, t, 1.0 * n * sizeof(float));
+
+
+    t = bench::measure([&]{
+        indexed(c);
+        bench::doNotOptimize(c);
+    });
+
+    bench::report(name, "ndindex", n, t, 1.0 * n * sizeof(float));
+}
+
+
+
+int main ()
+{
+    bench::header();
+
+    const std::size_t n = 128;
+
+
+    cnt::Container<float, 0, 0, 0> a(n, n, n);
+    cnt::Container<float> b(n, n, n);
+    cnt::Container<float> c(4, n, n, n);
+
+    std::iota(a.begin(), a.end(), 0.0f);
+    std::iota(b.begin(), b.end(), 0.0f);
+    std::iota(c.begin(), c.end(), 0.0f);
+
+
+    run("fixed_rank", a);
+    run("runtime_rank", b);
+    auto s = c.slice(2);
+    auto v = cnt::strided(a, cnt::all, cnt::range(0, n, 2), cnt::all);
+
+    run("slice", s);
+    run("strided", v);
+
+
+    return 0;
+}
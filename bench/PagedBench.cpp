@@ -0,0 +1,77 @@
+/** \file PagedBench.cpp
+  *
+  * Sums of a paged container with a budget of an eighth of its size, scanning the slabs in
+  * increasing order, which are read ahead, and in a shuffled order. The same scan of a
+  * 'Container' in memory is the baseline. Also the write of every slab, whose write back to
+  * the scratch file runs in the background.
+*/
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "Benchmark.h"
+#include "Container/Paged.h"
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    const std::size_t slabs = 512, n = 256;
+
+    const double bytes = 1.0 * slabs * n * n * sizeof(float);
+
+    cnt::Container<float, 0, 0, 0> a(slabs, n, n);
+
+    std::iota(a.begin(), a.end(), 0.0f);
+
+    cnt::PagedContainer<float, 0, 0, 0> p("paged_bench.bin", std::size_t(bytes / 8), slabs, n, n);
+
+
+    double t = bench::measure([&]{
+        for(std::size_t i = 0; i < slabs; ++i)
+        {
+            auto s = p.slice(i);
+            std::copy(a.begin() + i * n * n, a.begin() + (i + 1) * n * n, s.begin());
+        }
+    }, 3);
+
+    bench::report("write_slabs", "paged", a.size(), t, bytes);
+
+
+    t = bench::measure([&]{
+        float s = std::accumulate(a.begin(), a.end(), 0.0f);
+        bench::doNotOptimize(s);
+    }, 3);
+
+    bench::report("sum", "memory", a.size(), t, bytes);
+
+
+    std::vector<std::size_t> order(slabs);
+
+    std::iota(order.begin(), order.end(), 0);
+
+    for(int shuffled = 0; shuffled < 2; ++shuffled)
+    {
+        if(shuffled)
+            std::shuffle(order.begin(), order.end(), std::mt19937(7));
+
+        t = bench::measure([&]{
+            float sum = 0.0f;
+
+            for(auto i : order)
+            {
+                const auto& cp = p;
+                auto s = cp.slice(i);
+                sum = std::accumulate(s.begin(), s.end(), sum);
+            }
+
+            bench::doNotOptimize(sum);
+        }, 3);
+
+        bench::report("sum", shuffled ? "paged_shuffled" : "paged_sequential", a.size(), t, bytes);
+    }
+}
@@ -0,0 +1,117 @@
+/** \file PermuteBench.cpp
+  *
+  * 'permute' against copying the elements one by one, with nested loops over 'operator()' and
+  * with the iterators of the permuted view, for a 2D transpose and for 'NCHW' to 'NHWC'. The
+  * 'permute' variant allocates the result, and 'permute_into' writes to an existing container.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Permute.h"
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    {
+        const std::size_t n = 4096;
+
+        cnt::Container<float, 0, 0> a(n, n), b(n, n);
+
+        std::iota(a.begin(), a.end(), 0.0f);
+
+        const double bytes = 2.0 * a.size() * sizeof(float);
+
+
+        double t = bench::measure([&]{
+            for(std::size_t i = 0; i < n; ++i)
+                for(std::size_t j = 0; j < n; ++j)
+                    b(i, j) = a(j, i);
+
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("transpose", "naive", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto v = cnt::permuted(a, {1, 0});
+            std::copy(v.begin(), v.end(), b.begin());
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("transpose", "view_iterator", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto r = cnt::permute(a, {1, 0});
+            bench::doNotOptimize(r);
+        });
+
+        bench::report("transpose", "permute", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            cnt::permute(a, {1, 0}, b);
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("transpose", "permute_into", a.size(), t, bytes);
+    }
+
+
+    {
+        const std::size_t N = 16, C = 32, H = 112, W = 112;
+
+        cnt::Container<float, 0, 0, 0, 0> a(N, C, H, W), b(N, H, W, C);
+
+        std::iota(a.begin(), a.end(), 0.0f);
+
+        const double bytes = 2.0 * a.size() * sizeof(float);
+
+
+        double t = bench::measure([&]{
+            for(std::size_t n = 0; n < N; ++n)
+                for(std::size_t h = 0; h < H; ++h)
+                    for(std::size_t w = 0; w < W; ++w)
+                        for(std::size_t c = 0; c < C; ++c)
+                            b(n, h, w, c) = a(n, c, h, w);
+
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("nchw_to_nhwc", "naive", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto v = cnt::permuted(a, {0, 2, 3, 1});
+            std::copy(v.begin(), v.end(), b.begin());
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("nchw_to_nhwc", "view_iterator", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto r = cnt::permute(a, {0, 2, 3, 1});
+            bench::doNotOptimize(r);
+        });
+
+        bench::report("nchw_to_nhwc", "permute", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            cnt::permute(a, {0, 2, 3, 1}, b);
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("nchw_to_nhwc", "permute_into", a.size(), t, bytes);
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/** \file ReduceBench.cpp
+  *
+  * 'reduce' along each dimension of a 3D container against nested loops over 'operator()',
+  * with the loop over the reduced dimension innermost, for the sum and the argmax.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Reduce.h"
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    const std::size_t n = 256;
+
+    cnt::Container<float, 0, 0, 0> a(n, n, n);
+
+    std::iota(a.begin(), a.end(), 0.0f);
+
+    const double bytes = 1.0 * a.size() * sizeof(float);
+
+    const std::string names[] = { "sum_axis0", "sum_axis1", "sum_axis2" };
+
+
+    for(std::size_t axis = 0; axis < 3; ++axis)
+    {
+        cnt::Container<float, 0, 0> r(n, n);
+
+        double t = bench::measure([&]{
+            for(std::size_t i = 0; i < n; ++i)
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    float s = 0.0f;
+
+                    for(std::size_t k = 0; k < n; ++k)
+                        s += axis == 0 ? a(k, i, j) : axis == 1 ? a(i, k, j) : a(i, j, k);
+
+                    r(i, j) = s;
+                }
+
+            bench::doNotOptimize(r);
+        });
+
+        bench::report(names[axis], "naive", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto s = cnt::reduce(a, axis, cnt::Sum());
+            bench::doNotOptimize(s);
+        });
+
+        bench::report(names[axis], "reduce", a.size(), t, bytes);
+    }
+
+
+    {
+        cnt::Container<std::size_t, 0, 0> r(n, n);
+
+        double t = bench::measure([&]{
+            for(std::size_t j = 0; j < n; ++j)
+                for(std::size_t k = 0; k < n; ++k)
+                {
+                    std::size_t m = 0;
+
+                    for(std::size_t i = 1; i < n; ++i)
+                        if(a(m, j, k) < a(i, j, k))
+                            m = i;
+
+                    r(j, k) = m;
+                }
+
+            bench::doNotOptimize(r);
+        });
+
+        bench::report("argmax_axis0", "naive", a.size(), t, bytes);
+
+
+        t = bench::measure([&]{
+            auto s = cnt::reduce(a, 0, cnt::ArgMax());
+            bench::doNotOptimize(s);
+        });
+
+        bench::report("argmax_axis0", "reduce", a.size(), t, bytes);
+    }
+
+
+    {
+        double t = bench::measure([&]{
+            auto s = cnt::reduce(a, {0, 2}, cnt::Sum());
+            bench::doNotOptimize(s);
+        });
+
+        bench::report("sum_axes02", "reduce", a.size(), t, bytes);
+    }
+
+
+    return 0;
+}
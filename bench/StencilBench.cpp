@@ -0,0 +1,113 @@
+/** \file StencilBench.cpp
+  *
+  * 'stencil' against the loops written by hand, with nested loops over 'operator()' and the
+  * boundary handled by 'if's in the innermost loop. The cases are a 7 point laplacian with a
+  * dense kernel, and a 5 x 5 x 5 box filter with a separable kernel, both with clamping.
+*/
+
+#include <numeric>
+
+#include "Benchmark.h"
+#include "Container/Stencil.h"
+
+
+
+int main ()
+{
+    bench::header();
+
+
+    const int n = 192;
+
+    cnt::Container<float, 0, 0, 0> a(n, n, n), b(n, n, n);
+
+    std::iota(a.begin(), a.end(), 0.0f);
+
+    const double bytes = 2.0 * a.size() * sizeof(float);
+
+
+    {
+        double t = bench::measure([&]{
+            for(int i = 0; i < n; ++i)
+                for(int j = 0; j < n; ++j)
+                    for(int k = 0; k < n; ++k)
+                    {
+                        float s = -6.0f * a(i, j, k);
+
+                        s += a(i > 0 ? i - 1 : 0, j, k) + a(i < n - 1 ? i + 1 : n - 1, j, k);
+                        s += a(i, j > 0 ? j - 1 : 0, k) + a(i, j < n - 1 ? j + 1 : n - 1, k);
+                        s += a(i, j, k > 0 ? k - 1 : 0) + a(i, j, k < n - 1 ? k + 1 : n - 1);
+
+                        b(i, j, k) = s;
+                    }
+
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("laplacian", "naive", a.size(), t, bytes);
+
+
+        std::vector<float> w(27, 0.0f);
+
+        w[4] = w[10] = w[12] = w[14] = w[16] = w[22] = 1.0f;
+        w[13] = -6.0f;
+
+        const cnt::DenseKernel<float, 3> kernel({3, 3, 3}, w);
+
+        t = bench::measure([&]{
+            cnt::stencil(a, b, kernel, cnt::Boundary::clamp);
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("laplacian", "stencil", a.size(), t, bytes);
+    }
+
+
+    {
+        const int r = 2;
+
+        double t = bench::measure([&]{
+            for(int i = 0; i < n; ++i)
+                for(int j = 0; j < n; ++j)
+                    for(int k = 0; k < n; ++k)
+                    {
+                        float s = 0.0f;
+
+                        for(int x = i - r; x <= i + r; ++x)
+                            for(int y = j - r; y <= j + r; ++y)
+                                for(int z = k - r; z <= k + r; ++z)
+                                    s += a(x < 0 ? 0 : x >= n ? n - 1 : x, y < 0 ? 0 : y >= n ? n - 1 : y,
+                                           z < 0 ? 0 : z >= n ? n - 1 : z);
+
+                        b(i, j, k) = s / 125.0f;
+                    }
+
+            bench::doNotOptimize(b);
+        }, 1);
+
+        bench::report("box5", "naive", a.size(), t, bytes);
+
+
+        const cnt::DenseKernel<float, 3> dense({5, 5, 5}, std::vector<float>(125, 1.0f / 125.0f));
+
+        t = bench::measure([&]{
+            cnt::stencil(a, b, dense, cnt::Boundary::clamp);
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("box5", "stencil_dense", a.size(), t, bytes);
+
+
+        const cnt::SeparableKernel<float, 3> separable(std::vector<float>(5, 0.2f));
+
+        t = bench::measure([&]{
+            cnt::stencil(a, b, separable, cnt::Boundary::clamp);
+            bench::doNotOptimize(b);
+        });
+
+        bench::report("box5", "stencil_separable", a.size(), t, bytes);
+    }
+
+
+    return 0;
+}
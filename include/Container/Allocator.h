@@ -0,0 +1,191 @@
+/** \file Allocator.h
+  *
+  * Allocators that can be given to 'Vector' and 'Container' to control the alignment
+  * of the dynamically allocated storage and to request transparent huge pages.
+*/
+
+#ifndef CNT_ALLOCATOR_H
+#define CNT_ALLOCATOR_H
+
+#include <cstdlib>
+#include <new>
+#include <limits>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#else
+    #include <stdlib.h>
+#endif
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+/** Allocates 'n' bytes aligned to 'alignment', which must be a power of two multiple of
+  * 'sizeof(void*)'. Throws 'std::bad_alloc' on failure.
+*/
+inline void* alignedAlloc (std::size_t n, std::size_t alignment)
+{
+    void* p = nullptr;
+
+#if defined(_WIN32)
+    p = _aligned_malloc(n ? n : 1, alignment);
+#else
+    if(posix_memalign(&p, alignment, n ? n : 1))
+        p = nullptr;
+#endif
+
+    if(!p)
+        throw std::bad_alloc();
+
+    return p;
+}
+
+
+/// Releases memory allocated by 'alignedAlloc'
+inline void alignedFree (void* p)
+{
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+
+} // namespace help
+
+
+
+
+/** Allocator returning memory aligned to 'Alignment' bytes. The default of 64 bytes is the
+  * size of a cache line, and the width of an AVX-512 register.
+  *
+  * \tparam T The type of the elements
+  * \tparam Alignment The alignment in bytes. Must be a power of two.
+*/
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator
+{
+    static_assert(Alignment && !(Alignment & (Alignment - 1)), "The alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "The alignment can not be less than the alignment of 'T'");
+
+
+    using value_type = T;
+
+    static constexpr std::size_t alignment = Alignment < sizeof(void*) ? sizeof(void*) : Alignment;
+
+
+    /// The non-type parameter 'Alignment' does not let 'std::allocator_traits' do the rebinding
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+
+
+    AlignedAllocator () = default;
+
+    template <typename U>
+    AlignedAllocator (const AlignedAllocator<U, Alignment>&) {}
+
+
+
+    T* allocate (std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T*>(help::alignedAlloc(n * sizeof(T), alignment));
+    }
+
+    void deallocate (T* p, std::size_t)
+    {
+        help::alignedFree(p);
+    }
+};
+
+
+template <typename T, typename U, std::size_t A>
+bool operator == (const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) { return true; }
+
+template <typename T, typename U, std::size_t A>
+bool operator != (const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) { return false; }
+
+
+
+
+/** Allocator for large buffers that asks the kernel to back them by transparent huge pages,
+  * reducing TLB misses on streaming access. Allocations of at least 'HugePageSize' bytes are
+  * aligned to a huge page boundary and advised with 'madvise(MADV_HUGEPAGE)'. Smaller ones
+  * are only aligned to a cache line. On systems other than Linux there is no advice.
+  *
+  * \tparam T The type of the elements
+  * \tparam HugePageSize The size of a huge page in bytes
+*/
+template <typename T, std::size_t HugePageSize = (std::size_t(1) << 21)>
+struct HugePageAllocator
+{
+    using value_type = T;
+
+
+    template <typename U>
+    struct rebind { using other = HugePageAllocator<U, HugePageSize>; };
+
+
+
+    HugePageAllocator () = default;
+
+    template <typename U>
+    HugePageAllocator (const HugePageAllocator<U, HugePageSize>&) {}
+
+
+
+    T* allocate (std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        std::size_t bytes = n * sizeof(T);
+
+        if(bytes < HugePageSize)
+            return static_cast<T*>(help::alignedAlloc(bytes, alignof(T) > 64 ? alignof(T) : 64));
+
+
+        /// Round up to whole huge pages, so the advice covers the entire buffer
+        bytes = (bytes + HugePageSize - 1) / HugePageSize * HugePageSize;
+
+        void* p = help::alignedAlloc(bytes, HugePageSize);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+        return static_cast<T*>(p);
+    }
+
+    void deallocate (T* p, std::size_t)
+    {
+        help::alignedFree(p);
+    }
+};
+
+
+template <typename T, typename U, std::size_t S>
+bool operator == (const HugePageAllocator<T, S>&, const HugePageAllocator<U, S>&) { return true; }
+
+template <typename T, typename U, std::size_t S>
+bool operator != (const HugePageAllocator<T, S>&, const HugePageAllocator<U, S>&) { return false; }
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_ALLOCATOR_H
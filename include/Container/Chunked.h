@@ -0,0 +1,1029 @@
+/** \file Chunked.h
+  *
+  * A container split into chunks of a fixed shape, each one compressed in memory, like the
+  * datasets of HDF5 or zarr:
+  *
+  *     cnt::Chunked<float> c({4096, 4096, 256}, {64, 64, 64});
+  *
+  *     c(1, 2, 3) = 1.5f;                              // Through a cache of decompressed chunks
+  *     float x = c(1, 2, 3);
+  *
+  *     auto box = c.read({0, 0, 0}, {128, 128, 64});   // A 'Container' with a copy of the elements
+  *     c.write({128, 0, 0}, box);
+  *
+  *     auto d = cnt::chunked(dense, {64, 64, 64});     // Compressing a dense container
+  *
+  * The chunks at the end of a dimension whose size is not a multiple of the chunk size are
+  * smaller. A chunk that was never written is not stored, and all of its elements are 'T{}'.
+  *
+  * Each chunk is compressed by 'help::encodeChunk': the elements are delta coded, their bytes
+  * are shuffled so the bytes of the same significance are together, and the result goes through
+  * a LZ77 compressor with the block format of LZ4. Smooth or repetitive data gives long runs of
+  * equal bytes in the most significant planes, which the compressor removes.
+*/
+
+#ifndef CNT_CHUNKED_H
+#define CNT_CHUNKED_H
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Parallel.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+// ---------------------------------------- Codec ---------------------------------------------- //
+
+
+/// The unsigned integer with 'S' bytes, used to delta code the elements, or 'void' if there is none
+//@{
+template <std::size_t S> struct UIntOf { using type = void; };
+
+template <> struct UIntOf<1> { using type = std::uint8_t; };
+template <> struct UIntOf<2> { using type = std::uint16_t; };
+template <> struct UIntOf<4> { using type = std::uint32_t; };
+template <> struct UIntOf<8> { using type = std::uint64_t; };
+//@}
+
+
+/** Replaces the 'n' elements of 'S' bytes in 'p' by their differences to the previous one, or
+  * back, as unsigned integers. Elements of other sizes are left as they are.
+*/
+//@{
+template <typename U>
+void deltaEncode (std::uint8_t* p, std::size_t n)
+{
+    U prev = 0;
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        U x;
+
+        std::memcpy(&x, p + i * sizeof(U), sizeof(U));
+
+        const U d = U(x - prev);
+
+        std::memcpy(p + i * sizeof(U), &d, sizeof(U));
+
+        prev = x;
+    }
+}
+
+template <typename U>
+void deltaDecode (std::uint8_t* p, std::size_t n)
+{
+    U prev = 0;
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        U d;
+
+        std::memcpy(&d, p + i * sizeof(U), sizeof(U));
+
+        prev = U(prev + d);
+
+        std::memcpy(p + i * sizeof(U), &prev, sizeof(U));
+    }
+}
+
+template <>
+inline void deltaEncode<void> (std::uint8_t*, std::size_t) {}
+
+template <>
+inline void deltaDecode<void> (std::uint8_t*, std::size_t) {}
+//@}
+
+
+
+/** Compresses the 'n' bytes of 'src', appending them to 'out' in the block format of LZ4: a
+  * sequence of tokens, each with a run of literals and a match of at least 4 bytes at an offset
+  * of at most 65535 bytes, found with a hash table of the last position of each 4 bytes. The
+  * last token has only literals.
+*/
+inline void lzCompress (const std::uint8_t* src, std::size_t n, std::vector<std::uint8_t>& out)
+{
+    constexpr std::size_t hashBits = 14, minMatch = 4, maxOffset = 65535;
+
+    std::vector<std::uint32_t> table(std::size_t(1) << hashBits, std::uint32_t(-1));
+
+
+    auto putLength = [&](std::size_t len){
+        for(; len >= 255; len -= 255)
+            out.push_back(255);
+
+        out.push_back(std::uint8_t(len));
+    };
+
+    auto putSequence = [&](std::size_t anchor, std::size_t literals, std::size_t offset, std::size_t match){
+        const std::size_t m = match ? match - minMatch : 0;
+
+        out.push_back(std::uint8_t((std::min<std::size_t>(literals, 15) << 4) | std::min<std::size_t>(m, 15)));
+
+        if(literals >= 15)
+            putLength(literals - 15);
+
+        out.insert(out.end(), src + anchor, src + anchor + literals);
+
+        if(!match)
+            return;
+
+        out.push_back(std::uint8_t(offset));
+        out.push_back(std::uint8_t(offset >> 8));
+
+        if(m >= 15)
+            putLength(m - 15);
+    };
+
+
+    std::size_t anchor = 0, i = 0;
+
+    while(i + minMatch <= n)
+    {
+        std::uint32_t v;
+
+        std::memcpy(&v, src + i, 4);
+
+        const std::size_t h = (v * 2654435761u) >> (32 - hashBits);
+        const std::size_t candidate = table[h];
+
+        table[h] = std::uint32_t(i);
+
+        if(candidate == std::uint32_t(-1) || i - candidate > maxOffset || std::memcmp(src + candidate, src + i, minMatch))
+        {
+            ++i;
+            continue;
+        }
+
+        std::size_t len = minMatch;
+
+        while(i + len < n && src[candidate + len] == src[i + len])
+            ++len;
+
+        putSequence(anchor, i - anchor, i - candidate, len);
+
+        i += len;
+        anchor = i;
+    }
+
+    putSequence(anchor, n - anchor, 0, 0);
+}
+
+
+/** Decompresses the block 'src' of 'size' bytes made by 'lzCompress' to the 'n' bytes of 'dst'.
+  * Throws 'std::runtime_error' if the block does not decompress to exactly 'n' bytes.
+*/
+inline void lzDecompress (const std::uint8_t* src, std::size_t size, std::uint8_t* dst, std::size_t n)
+{
+    const std::uint8_t* end = src + size;
+
+    std::size_t pos = 0;
+
+    auto fail = []{ throw std::runtime_error("The compressed chunk is corrupted"); };
+
+    auto getLength = [&](std::size_t len){
+        for(std::uint8_t b = 255; b == 255; len += b)
+        {
+            if(src == end)
+                fail();
+
+            b = *src++;
+        }
+
+        return len;
+    };
+
+
+    while(src < end)
+    {
+        const std::uint8_t token = *src++;
+
+        std::size_t literals = token >> 4;
+
+        if(literals == 15)
+            literals = getLength(literals);
+
+        if(std::size_t(end - src) < literals || n - pos < literals)
+            fail();
+
+        std::memcpy(dst + pos, src, literals);
+
+        src += literals;
+        pos += literals;
+
+        if(src == end)
+            break;
+
+
+        if(end - src < 2)
+            fail();
+
+        const std::size_t offset = src[0] | (std::size_t(src[1]) << 8);
+
+        src += 2;
+
+        std::size_t len = token & 15;
+
+        if(len == 15)
+            len = getLength(len);
+
+        len += 4;
+
+        if(!offset || offset > pos || n - pos < len)
+            fail();
+
+        for(std::size_t j = 0; j < len; ++j, ++pos)
+            dst[pos] = dst[pos - offset];
+    }
+
+    if(pos != n)
+        fail();
+}
+
+
+
+/** Compresses the 'n' elements of 'p': delta coding, shuffling of the bytes and 'lzCompress'.
+  * 'T' must be trivially copyable.
+*/
+template <typename T>
+std::vector<std::uint8_t> encodeChunk (const T* p, std::size_t n)
+{
+    constexpr std::size_t S = sizeof(T);
+
+    std::vector<std::uint8_t> bytes(n * S), shuffled(n * S), res;
+
+    std::memcpy(bytes.data(), p, n * S);
+
+    deltaEncode<typename UIntOf<S>::type>(bytes.data(), n);
+
+    for(std::size_t i = 0; i < n; ++i)
+        for(std::size_t b = 0; b < S; ++b)
+            shuffled[b * n + i] = bytes[i * S + b];
+
+    lzCompress(shuffled.data(), shuffled.size(), res);
+
+    return res;
+}
+
+
+/// Decompresses the 'n' elements made by 'encodeChunk' to 'p'
+template <typename T>
+void decodeChunk (const std::vector<std::uint8_t>& src, T* p, std::size_t n)
+{
+    constexpr std::size_t S = sizeof(T);
+
+    std::vector<std::uint8_t> shuffled(n * S), bytes(n * S);
+
+    lzDecompress(src.data(), src.size(), shuffled.data(), shuffled.size());
+
+    for(std::size_t b = 0; b < S; ++b)
+        for(std::size_t i = 0; i < n; ++i)
+            bytes[i * S + b] = shuffled[b * n + i];
+
+    deltaDecode<typename UIntOf<S>::type>(bytes.data(), n);
+
+    std::memcpy(p, bytes.data(), n * S);
+}
+
+
+
+/** Copies the box of 'box' elements starting at 'from' in the row major elements 'src' with
+  * sizes 'srcSizes' to the position 'to' in 'dst' with sizes 'dstSizes'. The rows of the last
+  * dimension are copied at once.
+*/
+template <typename T>
+void copyBox (const T* src, const std::vector<std::size_t>& srcSizes, const std::vector<std::size_t>& from,
+              T* dst, const std::vector<std::size_t>& dstSizes, const std::vector<std::size_t>& to,
+              const std::vector<std::size_t>& box)
+{
+    const std::size_t n = box.size();
+
+    for(auto b : box)
+        if(!b)
+            return;
+
+
+    std::vector<std::size_t> srcWeights(n, 1), dstWeights(n, 1);
+
+    for(std::size_t k = n - 1; k-- > 0;)
+    {
+        srcWeights[k] = srcWeights[k+1] * srcSizes[k+1];
+        dstWeights[k] = dstWeights[k+1] * dstSizes[k+1];
+    }
+
+    for(std::size_t k = 0; k < n; ++k)
+    {
+        src += from[k] * srcWeights[k];
+        dst += to[k] * dstWeights[k];
+    }
+
+
+    std::vector<std::size_t> index(n, 0);
+
+    while(true)
+    {
+        std::copy(src, src + box[n-1], dst);
+
+        std::size_t k = n - 1;
+
+        while(k-- > 0)
+        {
+            src += srcWeights[k];
+            dst += dstWeights[k];
+
+            if(++index[k] < box[k])
+                break;
+
+            src -= index[k] * srcWeights[k];
+            dst -= index[k] * dstWeights[k];
+
+            index[k] = 0;
+        }
+
+        if(k >= n - 1)
+            return;
+    }
+}
+
+
+
+template <typename T>
+class ChunkedReference;
+
+
+} // namespace help
+
+
+
+
+/** Container of elements of type 'T' stored in compressed chunks, with the sizes of the
+  * dimensions given at runtime. The last used chunks are kept decompressed in a cache of a
+  * bounded number of chunks, with the least recently used chunk evicted first and compressed
+  * again if it was written. The accessors are the same of 'Container', but the ones of a
+  * non const container return a 'help::ChunkedReference', since an element in the cache can be
+  * evicted at any time.
+  *
+  * The member functions can be called from several threads. Each chunk has its own mutex, held
+  * while it is decompressed, compressed or accessed, and a global mutex protects only the order
+  * of use of the cache, so threads working on different chunks do not wait for each other. The
+  * bulk reads and writes decompress and compress their chunks in parallel.
+*/
+template <typename T>
+class Chunked
+{
+public:
+
+    static_assert(std::is_trivially_copyable<T>::value, "The elements must be trivially copyable");
+
+
+    /** Some type definitions */
+    //@{
+    using value_type = T;
+
+    using reference = help::ChunkedReference<T>;
+    //@}
+
+
+
+    /** A container with the given sizes, chunks of the given shape and a cache of 'cacheSize'
+      * chunks. All elements are 'T{}'. Throws 'std::invalid_argument' if there are no dimensions,
+      * if the chunk shape does not have a size for each dimension or if one of them is 0.
+    */
+    Chunked (std::vector<std::size_t> sizes, std::vector<std::size_t> chunkShape, std::size_t cacheSize = 64) :
+             dimSize(std::move(sizes)), shape(std::move(chunkShape)), counts(dimSize.size()),
+             cacheSize(std::max<std::size_t>(cacheSize, 1)), mutex(std::make_unique<std::mutex>())
+    {
+        if(dimSize.empty())
+            throw std::invalid_argument("There must be at least one dimension");
+
+        if(shape.size() != dimSize.size())
+            throw std::invalid_argument("There must be a chunk size for each dimension");
+
+        std::size_t n = 1;
+
+        for(std::size_t k = 0; k < dimSize.size(); ++k)
+        {
+            if(!shape[k])
+                throw std::invalid_argument("The chunk sizes must be positive");
+
+            counts[k] = (dimSize[k] + shape[k] - 1) / shape[k];
+
+            n *= counts[k];
+        }
+
+        slots = std::vector<Slot>(n);
+    }
+
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+    /** Access to an element by integrals or iterables of integrals, as in 'Container'. The
+      * element is read or written through the cache.
+    */
+    //@{
+    template <typename... Args, help::EnableIfIntegralOrIterable<Args...> = 0>
+    T operator () (const Args&... args) const
+    {
+        const auto pos = locate(args...);
+
+        T res;
+
+        access(pos.first, false, [&](T* p){ res = p[pos.second]; });
+
+        return res;
+    }
+
+    template <typename... Args, help::EnableIfIntegralOrIterable<Args...> = 0>
+    reference operator () (const Args&... args)
+    {
+        const auto pos = locate(args...);
+
+        return reference(*this, pos.first, pos.second);
+    }
+    //@}
+
+
+
+    /** The box of elements from 'first' up to, but not including, 'last', as a new row major
+      * 'Container'. Each chunk in the box is decompressed once, in parallel, or copied from the
+      * cache if it is there. The chunks are not added to the cache, so a large read does not
+      * evict the chunks used by the element accessors. Throws 'std::invalid_argument' if the box
+      * is not inside the container.
+    */
+    Container<T> read (const std::vector<std::size_t>& first, const std::vector<std::size_t>& last) const
+    {
+        checkBox(first, last);
+
+        std::vector<std::size_t> sizes(first.size());
+
+        for(std::size_t k = 0; k < sizes.size(); ++k)
+            sizes[k] = last[k] - first[k];
+
+        Container<T> res(uninitialized, sizes.begin(), sizes.end());
+
+        readBox(first, last, res.data());
+
+        return res;
+    }
+
+
+    /** Writes the row major elements of 'src' to the box starting at 'first', with the sizes of
+      * 'src', in parallel. The chunks entirely inside the box are compressed directly, and the
+      * others are decompressed once, updated and compressed again. Throws 'std::invalid_argument'
+      * if the box is not inside the container.
+    */
+    template <class C>
+    void write (const std::vector<std::size_t>& first, const C& src)
+    {
+        static_assert(help::isRowMajor<help::LayoutOf<C>>, "The source must be row major");
+
+        const auto srcSizes = src.sizes();
+
+        std::vector<std::size_t> last(first.size());
+
+        if(srcSizes.size() != first.size())
+            throw std::invalid_argument("The box must be inside of the container");
+
+        for(std::size_t k = 0; k < first.size(); ++k)
+            last[k] = first[k] + srcSizes[k];
+
+        checkBox(first, last);
+
+        writeBox(first, last, help::constData(src));
+    }
+
+
+    /** The elements with the first index 'i', as a new row major 'Container' with the other
+      * dimensions. The result is a const copy, so writing to it, like 'c.slice(i)(j, k) = x',
+      * does not compile instead of being lost. Use 'write' to change a slice. Throws
+      * 'std::invalid_argument' if there is only one dimension.
+    */
+    const Container<T> slice (std::size_t i) const
+    {
+        if(numDimensions() < 2)
+            throw std::invalid_argument("A slice needs at least two dimensions");
+
+        std::vector<std::size_t> first(numDimensions(), 0), last = dimSize;
+
+        first[0] = i;
+        last[0] = i + 1;
+
+        checkBox(first, last);
+
+        Container<T> res(uninitialized, dimSize.begin() + 1, dimSize.end());
+
+        readBox(first, last, res.data());
+
+        return res;
+    }
+
+
+    /// Compresses the chunks of the cache that were written, keeping them in the cache
+    void flush ()
+    {
+        for(auto& slot : slots)
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+
+            if(slot.dirty)
+            {
+                slot.code = help::encodeChunk(slot.data.data(), slot.data.size());
+
+                slot.dirty = false;
+            }
+        }
+    }
+
+
+
+
+    /// Size of each dimension
+    std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size
+    std::size_t size () const
+    {
+        return std::accumulate(dimSize.begin(), dimSize.end(), std::size_t(1), std::multiplies<std::size_t>());
+    }
+
+    /// Sizes of all dimensions
+    const std::vector<std::size_t>& sizes () const { return dimSize; }
+
+    /// Number of dimensions
+    std::size_t numDimensions () const { return dimSize.size(); }
+
+
+    /// Sizes of the chunks that are not at the end of a dimension
+    const std::vector<std::size_t>& chunkShape () const { return shape; }
+
+    /// Number of chunks
+    std::size_t numChunks () const { return slots.size(); }
+
+
+    /// Bytes used by the compressed chunks. The chunks written in the cache count after 'flush'.
+    std::size_t compressedBytes () const
+    {
+        std::size_t res = 0;
+
+        for(auto& slot : slots)
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+
+            res += slot.code.size();
+        }
+
+        return res;
+    }
+
+
+
+private:
+
+    friend class help::ChunkedReference<T>;
+
+
+    /// A chunk, with its compressed form and, if it is in the cache, its elements
+    struct Slot
+    {
+        std::mutex mutex;                   /// Held while the chunk is read, written or (de)compressed
+
+        std::vector<std::uint8_t> code;     /// Compressed elements, empty if never written
+
+        std::vector<T> data;                /// Decompressed elements, empty if not in the cache
+
+        bool dirty = false;                 /// If 'data' was written after it was decompressed
+    };
+
+
+
+    /// The chunk and the position inside of it of the element given by 'args'
+    template <typename... Args>
+    std::pair<std::size_t, std::size_t> locate (const Args&... args) const
+    {
+        std::size_t k = 0, chunk = 0, offset = 0;
+
+        auto add = [&](std::size_t i){
+            if(k >= numDimensions() || i >= dimSize[k])
+                throw std::invalid_argument("The position is outside of the container");
+
+            const std::size_t c = i / shape[k];
+
+            chunk = chunk * counts[k] + c;
+            offset = offset * std::min(shape[k], dimSize[k] - c * shape[k]) + i % shape[k];
+
+            ++k;
+        };
+
+        const auto& dummy = { (forEachIndex(args, add), int{})..., int{} };
+
+        if(k != numDimensions())
+            throw std::invalid_argument("There must be an index for each dimension");
+
+        return std::make_pair(chunk, offset);
+    }
+
+
+    template <typename U, class F, help::EnableIfIntegral<U> = 0>
+    static void forEachIndex (const U& i, F& f) { f(std::size_t(i)); }
+
+    template <typename U, class F, help::EnableIfIterable<U> = 0>
+    static void forEachIndex (const U& u, F& f)
+    {
+        for(const auto& i : u)
+            f(std::size_t(i));
+    }
+
+
+
+    /** Calls 'f' with the elements of the chunk 'c' in the cache, decompressing it if it is not
+      * there, and then evicts the least recently used chunk if the cache is full. Only the mutex
+      * of 'c' is held while it is decompressed and accessed.
+    */
+    template <class F>
+    void access (std::size_t c, bool write, F f) const
+    {
+        {
+            Slot& slot = slots[c];
+
+            std::lock_guard<std::mutex> lock(slot.mutex);
+
+            if(slot.data.empty())
+                slot.data = decompress(c);
+
+            slot.dirty = slot.dirty || write;
+
+            f(slot.data.data());
+        }
+
+        const std::size_t old = touch(c);
+
+        if(old != c)
+            evict(old);
+    }
+
+
+    /** Moves the chunk 'c' to the front of 'recent'. If the cache is then over its size, the
+      * least recently used chunk is removed from it and returned, otherwise 'c' is returned.
+    */
+    std::size_t touch (std::size_t c) const
+    {
+        std::lock_guard<std::mutex> lock(*mutex);
+
+        auto it = positions.find(c);
+
+        if(it != positions.end())
+            recent.splice(recent.begin(), recent, it->second);
+
+        else
+        {
+            recent.push_front(c);
+            positions.emplace(c, recent.begin());
+        }
+
+        if(recent.size() <= cacheSize)
+            return c;
+
+        const std::size_t old = recent.back();
+
+        positions.erase(old);
+        recent.pop_back();
+
+        return old;
+    }
+
+
+    /** Compresses the chunk 'old' if it was written and frees its elements, unless it was used
+      * again after it was removed from 'recent'. The mutex of the chunk is locked before the
+      * global one.
+    */
+    void evict (std::size_t old) const
+    {
+        Slot& slot = slots[old];
+
+        std::lock_guard<std::mutex> lock(slot.mutex);
+
+        {
+            std::lock_guard<std::mutex> lockRecent(*mutex);
+
+            if(positions.count(old))
+                return;
+        }
+
+        if(slot.dirty)
+            slot.code = help::encodeChunk(slot.data.data(), slot.data.size());
+
+        slot.dirty = false;
+
+        std::vector<T>().swap(slot.data);
+    }
+
+
+    /// The elements of the chunk 'c', from its compressed form. The mutex of 'c' must be locked.
+    std::vector<T> decompress (std::size_t c) const
+    {
+        std::vector<T> res(chunkSizes(c).second, T{});
+
+        if(!slots[c].code.empty())
+            help::decodeChunk(slots[c].code, res.data(), res.size());
+
+        return res;
+    }
+
+
+    /// The position of the first element and the sizes of the chunk 'c', with the number of elements
+    std::pair<std::vector<std::size_t>, std::size_t> chunkSizes (std::size_t c, std::vector<std::size_t>* origin = nullptr) const
+    {
+        std::vector<std::size_t> sizes(numDimensions());
+
+        std::size_t n = 1;
+
+        for(std::size_t k = numDimensions(); k-- > 0; c /= counts[k])
+        {
+            const std::size_t first = (c % counts[k]) * shape[k];
+
+            sizes[k] = std::min(shape[k], dimSize[k] - first);
+
+            if(origin)
+                (*origin)[k] = first;
+
+            n *= sizes[k];
+        }
+
+        return std::make_pair(sizes, n);
+    }
+
+
+
+    /// Throws 'std::invalid_argument' if the box from 'first' to 'last' is not inside the container
+    void checkBox (const std::vector<std::size_t>& first, const std::vector<std::size_t>& last) const
+    {
+        if(first.size() != numDimensions() || last.size() != numDimensions())
+            throw std::invalid_argument("The box must be inside of the container");
+
+        for(std::size_t k = 0; k < numDimensions(); ++k)
+            if(first[k] > last[k] || last[k] > dimSize[k])
+                throw std::invalid_argument("The box must be inside of the container");
+    }
+
+
+    /** Calls 'f(c, origin, sizes, from, to, box)' in parallel for each chunk 'c' intersecting the
+      * box from 'first' to 'last'. 'origin' and 'sizes' are the position and sizes of the chunk,
+      * and the intersection starts at 'from' in the chunk and at 'to' in the box, with sizes 'box'.
+    */
+    template <class F>
+    void forEachChunk (const std::vector<std::size_t>& first, const std::vector<std::size_t>& last, F f) const
+    {
+        const std::size_t n = numDimensions();
+
+        std::vector<std::size_t> lo(n), hi(n);
+
+        std::size_t total = 1;
+
+        for(std::size_t k = 0; k < n; ++k)
+        {
+            if(first[k] == last[k])
+                return;
+
+            lo[k] = first[k] / shape[k];
+            hi[k] = (last[k] - 1) / shape[k] + 1;
+
+            total *= hi[k] - lo[k];
+        }
+
+
+        auto& pool = ThreadPool::global();
+
+        pool.parallelFor(0, total, 1, [&](std::size_t begin, std::size_t end){
+            std::vector<std::size_t> origin(n), from(n), to(n), box(n);
+
+            for(std::size_t t = begin; t < end; ++t)
+            {
+                std::size_t c = 0;
+
+                for(std::size_t k = 0, r = t, w = total; k < n; ++k)
+                {
+                    w /= hi[k] - lo[k];
+
+                    c = c * counts[k] + lo[k] + r / w;
+                    r %= w;
+                }
+
+                const auto sizes = chunkSizes(c, &origin).first;
+
+                for(std::size_t k = 0; k < n; ++k)
+                {
+                    const std::size_t a = std::max(first[k], origin[k]), b = std::min(last[k], origin[k] + sizes[k]);
+
+                    from[k] = a - origin[k];
+                    to[k] = a - first[k];
+                    box[k] = b - a;
+                }
+
+                f(c, sizes, from, to, box);
+            }
+        });
+    }
+
+
+    /// Reads the box from 'first' to 'last' to the row major elements 'out'
+    void readBox (const std::vector<std::size_t>& first, const std::vector<std::size_t>& last, T* out) const
+    {
+        std::vector<std::size_t> outSizes(numDimensions());
+
+        for(std::size_t k = 0; k < numDimensions(); ++k)
+            outSizes[k] = last[k] - first[k];
+
+        forEachChunk(first, last, [&](std::size_t c, const auto& sizes, const auto& from, const auto& to, const auto& box){
+            Slot& slot = slots[c];
+
+            std::lock_guard<std::mutex> lock(slot.mutex);
+
+            if(!slot.data.empty())
+                return help::copyBox(slot.data.data(), sizes, from, out, outSizes, to, box);
+
+            const auto data = decompress(c);
+
+            help::copyBox(data.data(), sizes, from, out, outSizes, to, box);
+        });
+    }
+
+
+    /// Writes the row major elements 'in' to the box from 'first' to 'last'
+    void writeBox (const std::vector<std::size_t>& first, const std::vector<std::size_t>& last, const T* in)
+    {
+        std::vector<std::size_t> inSizes(numDimensions());
+
+        for(std::size_t k = 0; k < numDimensions(); ++k)
+            inSizes[k] = last[k] - first[k];
+
+        forEachChunk(first, last, [&](std::size_t c, const auto& sizes, const auto& from, const auto& to, const auto& box){
+            Slot& slot = slots[c];
+
+            std::lock_guard<std::mutex> lock(slot.mutex);
+
+            if(!slot.data.empty())
+            {
+                help::copyBox(in, inSizes, to, slot.data.data(), sizes, from, box);
+
+                slot.dirty = true;
+
+                return;
+            }
+
+            std::vector<T> data = sizes == box ? std::vector<T>(std::accumulate(sizes.begin(), sizes.end(), std::size_t(1),
+                                                                                std::multiplies<std::size_t>()))
+                                               : decompress(c);
+
+            help::copyBox(in, inSizes, to, data.data(), sizes, from, box);
+
+            slot.code = help::encodeChunk(data.data(), data.size());
+        });
+    }
+
+
+
+    std::vector<std::size_t> dimSize;       /// Sizes of the container
+
+    std::vector<std::size_t> shape;         /// Sizes of the full chunks
+
+    std::vector<std::size_t> counts;        /// Number of chunks along each dimension
+
+    std::size_t cacheSize;                  /// Maximum number of chunks in the cache
+
+
+    mutable std::vector<Slot> slots;                            /// The chunks
+
+    mutable std::list<std::size_t> recent;                      /// Chunks in the cache, the most recently used first
+
+    mutable std::unordered_map<std::size_t, std::list<std::size_t>::iterator> positions;   /// Position in 'recent'
+
+    std::unique_ptr<std::mutex> mutex;                          /// Protects 'recent' and 'positions'
+};
+
+
+
+
+namespace help
+{
+
+/** An element of a non const 'Chunked', read or written through the cache on each access */
+template <typename T>
+class ChunkedReference
+{
+public:
+
+    ChunkedReference (Chunked<T>& c, std::size_t chunk, std::size_t offset) : c(c), chunk(chunk), offset(offset) {}
+
+
+    operator T () const
+    {
+        T res;
+
+        c.access(chunk, false, [&](T* p){ res = p[offset]; });
+
+        return res;
+    }
+
+    ChunkedReference& operator = (const T& x)
+    {
+        c.access(chunk, true, [&](T* p){ p[offset] = x; });
+
+        return *this;
+    }
+
+    ChunkedReference& operator = (const ChunkedReference& r)
+    {
+        return *this = T(r);
+    }
+
+
+    /// Compound assignments, reading and writing the element under the same lock
+    //@{
+    ChunkedReference& operator += (const T& x)
+    {
+        c.access(chunk, true, [&](T* p){ p[offset] += x; });
+
+        return *this;
+    }
+
+    ChunkedReference& operator -= (const T& x)
+    {
+        c.access(chunk, true, [&](T* p){ p[offset] -= x; });
+
+        return *this;
+    }
+
+    ChunkedReference& operator *= (const T& x)
+    {
+        c.access(chunk, true, [&](T* p){ p[offset] *= x; });
+
+        return *this;
+    }
+
+    ChunkedReference& operator /= (const T& x)
+    {
+        c.access(chunk, true, [&](T* p){ p[offset] /= x; });
+
+        return *this;
+    }
+    //@}
+
+
+private:
+
+    Chunked<T>& c;
+
+    std::size_t chunk;
+
+    std::size_t offset;
+};
+
+} // namespace help
+
+
+
+
+/** A 'Chunked' with the elements of the row major container 'c', in chunks of 'chunkShape'.
+  * The chunks are compressed in parallel.
+*/
+template <class C>
+auto chunked (const C& c, std::vector<std::size_t> chunkShape, std::size_t cacheSize = 64)
+{
+    using T = typename std::decay_t<C>::value_type;
+
+    const auto sizes = c.sizes();
+
+    Chunked<T> res(std::vector<std::size_t>(sizes.begin(), sizes.end()), std::move(chunkShape), cacheSize);
+
+    res.write(std::vector<std::size_t>(sizes.size(), 0), c);
+
+    return res;
+}
+
+
+/// A row major 'Container' with the elements of 'c'
+template <typename T>
+Container<T> dense (const Chunked<T>& c)
+{
+    return c.read(std::vector<std::size_t>(c.numDimensions(), 0), c.sizes());
+}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_CHUNKED_H
@@ -1,477 +1,757 @@
-/** \file Container.h
-  *
-  * An interface to easily access multidimensional data, having total 
-  * compatibility with STL algorithms and containers.
-*/
-
-#ifndef CNT_CONTAINER_H
-#define CNT_CONTAINER_H
-
-#include <tuple>
-#include <algorithm>
-#include <cmath>
-#include <numeric>
-
-#include "Vector.h"
-#include "Slice.h"
-
-
-
-// #include <iostream>
-// #define DB(...) std::cout << __VA_ARGS__ << "\n" << std::flush
-
-
-namespace cnt
-{
-
-namespace help
-{
-
-template <class>
-struct Accessor;
-
-
-
-/** Class to easily create and manipulate multidimensional data. Interacts easily
-  * with STL algorithms and can be either statically or dinamically allocated.
-  *
-  * \tparam T The Containers type
-  * \tparam Is The compile time size of each dimension. The total size is the 
-  *         multiplication of these sizes. See the 'Vector' class.
-*/
-template <typename T, std::size_t... Is>
-class Container : public Vector<T, help::multiply_v<Is...>>
-{
-public:
-
-
-    /** Some type definitions */
-    //@{
-    using Base = Vector<T, help::multiply_v<Is...>>;
-
-
-    using value_type = typename Base::value_type;
-
-    using reference = typename Base::reference;
-
-    using const_reference = typename Base::const_reference;
-
-
-    using Base::Size;
-    //@}
-
-
-
-    friend class Slice<Container>;     /// Friend definition for the 'Slice' class
-    friend class Slice<const Container>;     /// Friend definition for the 'Slice' class
-
-
-
-
-// --------------------------------- Constructors ---------------------------------------------- //
-
-
-    /** Constructor defined when inheriting from 'std::array'. Simulates 'std::array' list 
-      * initialization. The number of dimensions is given by 'Is'.
-      *
-      * \params[in] args Variadic arguments. 'Vector' checks if they are of type 'T'.
-    */
-    template <typename... Args, std::size_t M = Size, help::EnableIfArray< M > = 0>
-    Container (Args&&... args) : Base{ std::forward<Args>(args)... }, 
-                                 numDimensions_(sizeof...(Is)),
-                                 dimSize( Is... )
-    {
-        initWeights();
-    }
-
-
-    /** Same as above, but now for a 'Container' inheriting from 'std::vector' with 'Size'
-      * greater than the maximum stack allocation size. In this case, we must resize to
-      * 'Size' after intiallizing with 'args'.
-      *
-      * \params[in] args Variadic arguments. 'Vector' checks if they are of type 'T'.
-    */
-    template <typename... Args, std::size_t M = Size, std::enable_if_t<( M >= help::maxSize ), int > = 0>
-    Container (Args&&... args) : Base{std::forward<Args>(args)...}, 
-                                 numDimensions_(sizeof...(Is)),
-                                 dimSize(Is...)
-    {
-        initWeights();
-
-        Base::resize(Size);
-    }
-
-
-    /// Empty constructor for the case where 'Size' is 0 (no compile time size is given)
-    template <std::size_t M = Size, help::EnableIfZero< M > = 0>
-    Container () {}
-
-
-    /** Constructor for the case when 'Size' is 0 (inheriting from 'std::vector').
-      * This time the parameters are integral values that define the size of each
-      * dimension. So, '3, 4, 7' would gives us a 'Container' with thre dimensions
-      * with sizes 3, 4 and 7, respectivelly.
-      *
-      * \param[in] args Variadic integral types defining the size of each dimension.
-                        Only integral types are accepted.
-    */
-    template <typename... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
-              help::EnableIfIntegral< std::decay_t< Args >... > = 0 >
-    Container (Args... args) : numDimensions_(sizeof...(args)), 
-                               dimSize{std::size_t(args)...},
-                               weights(sizeof...(args))
-    {
-        initWeights();
-
-
-        /// Total size is equal to this multiplication. See the 'initWeights' function.
-        Base::resize(weights.front() * dimSize.front());
-    }
-
-
-
-    /** Another constructor defined when 'Size' is 0. Each element is an iterable type
-      * containing integral elements, that is, has both 'std::begin' and 'std::end' defined.
-      * The number of dimensions is the sum of the sizes of the iterables. For example, if you pass 
-      * 'vector<int>{2, 3}, list<long>{4, 5}', a 'Container' with 4 dimensions of sizes 2, 3, 4 and 
-      * 5 will be created. Only iterables of integral types are accepted.
-      *
-      * \param[in] args Variadic iterable types of integrals
-    */
-    template <class... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
-              help::EnableIfIterable< std::remove_reference_t< Args >... > = 0>
-    Container (const Args&... args) : numDimensions_(0)
-    {
-    	/** For each iterable we increase the number of dimensions (sum of args.size() for each
-    	  * iterable) and insert the dimensions at the end of 'dimSize' 'Vector'.
-    	*/
-        auto dummy = { (numDimensions_ += args.size(),
-                         dimSize.insert(dimSize.end(), std::begin(args), std::end(args)))... };
-
-        weights.resize(numDimensions_);
-
-        initWeights();
-
-        /// Total size is equal to this multiplication. See the 'initWeights' function.
-        Base::resize(weights.front() * dimSize.front());
-    }
-
-
-    /** One more constructor defined when 'Size' is 0. In this case, the argument is the starting
-      * and ending positions of a iterator. You can also use pointers. If you have for example
-      * int v[3] = {4, 1, 7}, and pass it like: 'Container<double> c(v, v+3)', a 'Container' with
-      * dimensions of sizes 4, 1 and 7 will be created.
-      *
-      * \param[in] begin Initial position of the iterator/pointer of integral types
-      * \param[in] end Final position of the iterator/pointer of integral types
-    */
-    template <typename U, typename V, std::size_t M = Size, help::EnableIfZero< M > = 0,
-              help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
-    Container (const U& begin, const V& end) : numDimensions_(std::distance(begin, end)), 
-                                               dimSize(begin, end),
-                                               weights(std::distance(begin, end))
-    {
-        initWeights();
-
-        /// Total size is equal to this multiplication. See the 'initWeights' function.
-        Base::resize(weights.front() * dimSize.front());
-    }
-
-
-    /** A constructor taking a 'std::initializer_list', so you can also construct a
-      * container with a single dimension, like that: 'Container<int> c{1, 2, 3}'. The
-      * 'Container' in this case will have a single dimension with three elements.
-      *
-      * \param[in] il Initializer list of type 'T' (same as 'Container')
-    */
-    template<typename U, std::size_t M = Size, help::EnableIfZero< M > = 0,
-      		 help::EnableIfIntegral<std::decay_t<U>> = 0>
-    Container (std::initializer_list<U> il) : Container(il.begin(), il.end()) {}
-
-
-    /** This function is called from all constructors. It will initialize the 'weights' to 
-      * access a given position in the continuous array created either by 'std::vector' or
-      * 'std::array' by performing an inner product, given the size of each dimension.
-    */
-  	void initWeights ()
-    {
-    	weights.back() = 1;
-
-    	std::partial_sum(dimSize.rbegin() , dimSize.rend() - 1,
-    					 weights.rbegin() + 1, std::multiplies<std::size_t>());
-    }
-
-
-
-
-// ------------------------------- Access - operator() --------------------------------------------- //
-
-
-
-    /** These functions get either a integral type or a iterable of integrals
-      * and multiply each element with the iterator 'iter', given by a position
-      * in the variable 'weights'. The iterator is incremented, and the value
-      * of the multiplication is returned.
-      *
-      * \param[in] u Either a integral type or a iterable of integrals
-      * \param[in] iter A reference to a iterator. 
-      * \return Result after multiplication(s).
-    */
-    //@
-    template <typename U, typename Iter, help::EnableIfIntegral<std::decay_t<U>> = 0>
-    static std::size_t increment (U u, Iter& iter)
-    {
-    	return *iter++ * u;
-    }
-
-
-    template <typename U, typename Iter, help::EnableIfIterable<std::decay_t<U>> = 0>
-    static std::size_t increment (const U& u, Iter& iter)
-    {
-    	std::size_t res = 0;
-
-    	for(auto x : u)
-    		res += *iter++ * x;
-
-    	return res;
-    }
-    //@}
-
-
-
-    /** This access operator lets you pass variadic arguments being either integral
-      * types or iterables of integral types. The order of the arguments determines
-      * the position in each dimension. For example: 'Container<int> c(4, 1, 3);
-      * c(vector<long>{1, 0}, 2);' will give you the positions 1, 0 and 2 in the
-      * first, second and third dimension, respectivelly.
-      *
-      * \note The 'Dummie' template stuff is a trick to only allow the call if
-      * the arguments are either integral or iterable of integrals types.
-      *
-      * \param[in] args Either integral types or a iterables of integrals
-    */
-    //@{
-    template <typename... Args>
-    const_reference operator () (IntegralType, const Args&... args) const
-    {
-        std::size_t pos = 0;
-
-        auto iter = weights.begin();
-
-        const auto& dummy = { (pos += increment(args, iter), int{})... };
-
-        return this->operator[](pos);
-    }
-
-
-
-    /** Access operator for an iterator defined by the starting position 'begin'.
-      * The dimensions to access are defined by the order of the integral elements
-      * of the iterator.
-      *
-      * \param[in] begin Initial position of the iterator/pointer of integral types
-    */
-    //@{
-    template <typename U>
-    const_reference operator () (IteratorType, const U& begin) const
-    {
-        return this->operator[](std::inner_product(weights.begin(), weights.end(), begin, 0));
-    }
-    //@}
-
-
-    /** Access for a 'std::initializer_list' of integral type. You can then access a
-      * 'Container' as easily as: 'Container<int, 2, 3, 4> c;  c({1, 2, 3}) = 10'.
-      *
-      * \param[in] il Initializer list defining the position to access
-    */
-    //@{
-    template <typename U>
-    const_reference operator () (std::initializer_list<U> il) const
-    {
-        return this->operator[](std::inner_product(weights.begin(), weights.end(), il.begin(), 0));
-    }
-    //@}
-
-
-
-
-    /// Size of each dimension
-    constexpr std::size_t size (int p) const { return dimSize[p]; }
-
-    /// Total size
-    constexpr std::size_t size ()      const { return Base::size(); }
-
-    constexpr auto sizes ()      	   const { return dimSize; }
-
-    constexpr std::size_t numDimensions () const { return numDimensions_; }
-
-
-
-
-
-
-//---------------------------------- Slice ---------------------------------------------- //
-    
-
-
-    /** As the name says, it takes a 'Slice' of the container. If you use for example:
-      * 'Container<int, 2, 3, 4> c;   auto slc = c.slice(1);', the variable 'slc' will
-      * a proxy to access the container 'c', having two dimensions and starting from
-      * position 1 from the first dimension. For more, see the examples.
-      *
-      * \param[in] args Variadic integral arguments defining the dimensions to 'take a slice'.
-    */
-    //@{
-    template <typename... Args>
-    auto slice (const Args&... args) const
-    {
-        return Accessor<Slice<const Container>>(*this, args...);
-    }
-
-    template <typename... Args>
-    auto slice (const Args&... args)
-    {
-        return Accessor<Slice<Container>>(*this, args...);
-    }
-    //@}
-
-
-
-private:
-
-
-	/// Number of dimensions
-   	std::size_t numDimensions_;
-
-
-    /// The size of each dimension
-    Vector<std::size_t, bool(Size) * sizeof...(Is)> dimSize;
-
-
-    /// The weights to access given the position and sizes of the dimensions
-    Vector<std::size_t, bool(Size) * sizeof...(Is)> weights;
-
-};
-
-
-
-
-// ----------------------------------- Accessors -------------------------- //
-
-
-/** The only purpose of this class is to delegate calls to the accessors of 'Container' 
-  * or 'Slice', so we dont have duplication of code and the classes can be written more clearly.
-  *
-*/
-template <class BaseType>
-struct Accessor : public BaseType	/// We inherit from either 'Container' or 'Slice'
-{
-	/** Some type definitions */
-    //@{
-	using Base = BaseType;
-
-	using Base::Base;
-
-
-    using value_type = typename Base::value_type;
-
-    using reference = typename Base::reference;
-
-    using const_reference = typename Base::const_reference;
-    //@}
-
-
-    /** These functions simply delegate the access to either 'Container' or 'Slice', which
-      * have the same interface for access. They are also responsible to handle the SFINAE
-      * to treat all different types of access.
-    */
-    //@{
-
-    /// Integral or Iterable types
-    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
-    const_reference operator () (const Args&... args) const
-    {
-    	return Base::operator()(IntegralType{}, args...);
-    }
-
-    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
-    reference operator () (const Args&... args)
-    {
-    	return const_cast<reference>(static_cast<const Accessor&>(*this)(args...));
-    }
-
-
-
-    /// Iterators
-    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
-    const_reference operator () (const U& begin) const
-    {
-        return Base::operator()(IteratorType{}, begin);
-    }
-
-    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
-    reference operator () (const U& begin)
-    {
-        return const_cast<reference>(static_cast<const Accessor&>(*this)(begin));
-    }
-
-
-
-    /// Specific for 'std::initializer_list'
-    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
-    const_reference operator () (std::initializer_list<U> il) const
-    {
-        return Base::operator()(il);
-    }
-
-    template <typename U, help::EnableIfIntegral< std::decay_t< U > > = 0 >
-    reference operator () (std::initializer_list<U> il)
-    {
-        return const_cast<reference>(static_cast<const Accessor&>(*this)(il));
-    }
-
-
-
-    /// For tuples containing integrals or iterables
-    template <typename... Args, help::EnableIfIntegral<std::decay_t<Args>...> = 0>
-    constexpr const_reference operator () (const std::tuple<Args...>& tup) const
-    {
-        return this->operator()(tup, std::make_index_sequence<sizeof...(Args)>());
-    }
-
-    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args>...> = 0 >
-    constexpr reference operator () (const std::tuple<Args...>& tup)
-    {
-        return const_cast<reference>(static_cast<const Accessor&>(*this)(tup));
-    }
-
-    template <typename... Args, std::size_t... Js>
-    constexpr const_reference operator () (const std::tuple<Args...>& tup, std::index_sequence<Js...>) const
-    {
-        return this->operator()(std::get<Js>(tup)...);
-    }
-    //@}
-};
-
-
-
-} // namespace help
-
-
-
-/** These are the classes you will use: the 'Accessor' class over a 'Container' or a 'Slice' */
-//@{
-template <typename T, std::size_t... Is>
-using Container = help::Accessor<help::Container<T, Is...>>;
-
-template <typename T, std::size_t... Is>
-using Slice = help::Accessor<help::Container<T, Is...>>;
-//@}
-
-
-
-
-} // namespace cnt
-
-#endif  // CNT_CONTAINER_H
+/** \file Container.h
+  *
+  * An interface to easily access multidimensional data, having total 
+  * compatibility with STL algorithms and containers.
+*/
+
+#ifndef CNT_CONTAINER_H
+#define CNT_CONTAINER_H
+
+#include <tuple>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "Vector.h"
+#include "Allocator.h"
+#include "Dimensions.h"
+#include "Layout.h"
+#include "Slice.h"
+
+
+
+// #include <iostream>
+// #define DB(...) std::cout << __VA_ARGS__ << "\n" << std::flush
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+template <class>
+struct Accessor;
+
+template <typename T, class S>
+class View;
+
+
+template <typename T, class S, class Alloc = std::allocator<T>, class L = RowMajor, typename Index = std::size_t>
+class Container;
+
+
+/// Defined in 'Expression.h'
+//@{
+template <class>
+struct Expression;
+
+template <class C, class U, class Op>
+void evaluate (C& c, const U& u, Op op);
+//@}
+
+
+
+/** Class to easily create and manipulate multidimensional data. Interacts easily
+  * with STL algorithms and can be either statically or dinamically allocated.
+  *
+  * \tparam T The Containers type
+  * \tparam Is The compile time size of each dimension. The total size is the 
+  *         multiplication of these sizes. See the 'Vector' class. If every size is
+  *         '0', only the number of dimensions is fixed, and the sizes are given at
+  *         construction, like in 'Container<T, 0, 0, 0> c(4, 5, 6)'.
+  * \tparam Alloc The allocator used when the elements are kept in a 'std::vector'
+  * \tparam L The order of the elements in memory (see 'Layout.h')
+  * \tparam Index The integral type of the positions of the elements in row major order (see
+  *         'BasicDimensions'). The total size must fit in it.
+*/
+template <typename T, std::size_t... Is, class Alloc, class L, typename Index>
+class Container<T, Shape<Is...>, Alloc, L, Index> : public Vector<T, help::multiply_v<Is...>, InitAllocator<Alloc>>,
+                                                    public BasicDimensions<Index, Is...>,
+                                                    private LayoutMap<L, sizeof...(Is)>
+{
+public:
+
+
+    /** Some type definitions */
+    //@{
+    using Base = Vector<T, help::multiply_v<Is...>, InitAllocator<Alloc>>;
+
+    using Dims = BasicDimensions<Index, Is...>;
+
+    using Map = LayoutMap<L, sizeof...(Is)>;
+
+    using Layout = L;
+
+
+    using value_type = typename Base::value_type;
+
+    using reference = typename Base::reference;
+
+    using const_reference = typename Base::const_reference;
+
+    using allocator_type = Alloc;
+
+
+    using Base::Size;
+    //@}
+
+
+    /** The allocator of the elements. The 'std::vector' keeps them with 'InitAllocator<Alloc>',
+      * which is only used to skip the initialization of the constructors taking 'Uninitialized'.
+    */
+    template <std::size_t M = Size, help::EnableIfVector< M > = 0>
+    Alloc get_allocator () const { return Base::get_allocator(); }
+
+
+
+    friend class Slice<Container>;     /// Friend definition for the 'Slice' class
+    friend class Slice<const Container>;     /// Friend definition for the 'Slice' class
+
+
+
+
+// --------------------------------- Constructors ---------------------------------------------- //
+
+
+    /** Constructor defined when inheriting from 'std::array'. Simulates 'std::array' list 
+      * initialization. The number of dimensions is given by 'Is', and the sizes and weights
+      * are compile time constants (see 'Dimensions').
+      *
+      * \params[in] args Variadic arguments. 'Vector' checks if they are of type 'T'.
+    */
+    template <typename... Args, std::size_t M = Size, help::EnableIfArray< M > = 0>
+    Container (Args&&... args) : Base{ std::forward<Args>(args)... }
+    {
+        Map::init(dimSize);
+    }
+
+
+    /** Same as above, but now for a 'Container' inheriting from 'std::vector' with 'Size'
+      * greater than the maximum stack allocation size. In this case, we must resize to
+      * 'Size' after intiallizing with 'args'.
+      *
+      * \params[in] args Variadic arguments. 'Vector' checks if they are of type 'T'.
+    */
+    template <typename... Args, std::size_t M = Size, std::enable_if_t<( M >= help::maxSize ), int > = 0>
+    Container (Args&&... args) : Base{std::forward<Args>(args)...}
+    {
+        Base::resize(Size, T());
+
+        Map::init(dimSize);
+    }
+
+
+    /// Empty constructor for the case where 'Size' is 0 (no compile time size is given)
+    template <std::size_t M = Size, help::EnableIfZero< M > = 0>
+    Container () {}
+
+
+    /** Constructor for the case when 'Size' is 0 (inheriting from 'std::vector').
+      * This time the parameters are integral values that define the size of each
+      * dimension. So, '3, 4, 7' would gives us a 'Container' with thre dimensions
+      * with sizes 3, 4 and 7, respectivelly.
+      *
+      * \param[in] args Variadic integral types defining the size of each dimension.
+                        Only integral types are accepted.
+    */
+    template <typename... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIntegral< std::decay_t< Args >... > = 0 >
+    Container (Args... args) : Dims{ std::size_t(args)... }
+    {
+        static_assert(!sizeof...(Is) || sizeof...(Args) == sizeof...(Is), "There must be one size for each dimension");
+
+        /// Total size is equal to this multiplication. See the 'initWeights' function.
+        Base::resize(weights.front() * dimSize.front(), T());
+
+        Map::init(dimSize);
+    }
+
+
+
+    /** Another constructor defined when 'Size' is 0. Each element is an iterable type
+      * containing integral elements, that is, has both 'std::begin' and 'std::end' defined.
+      * The number of dimensions is the sum of the sizes of the iterables. For example, if you pass 
+      * 'vector<int>{2, 3}, list<long>{4, 5}', a 'Container' with 4 dimensions of sizes 2, 3, 4 and 
+      * 5 will be created. Only iterables of integral types are accepted.
+      *
+      * \param[in] args Variadic iterable types of integrals
+    */
+    template <class... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIterable< std::remove_reference_t< Args >... > = 0>
+    Container (const Args&... args) : Dims(help::concat(args...))
+    {
+        /// Total size is equal to this multiplication. See the 'initWeights' function.
+        Base::resize(weights.front() * dimSize.front(), T());
+
+        Map::init(dimSize);
+    }
+
+
+    /** One more constructor defined when 'Size' is 0. In this case, the argument is the starting
+      * and ending positions of a iterator. You can also use pointers. If you have for example
+      * int v[3] = {4, 1, 7}, and pass it like: 'Container<double> c(v, v+3)', a 'Container' with
+      * dimensions of sizes 4, 1 and 7 will be created.
+      *
+      * \param[in] begin Initial position of the iterator/pointer of integral types
+      * \param[in] end Final position of the iterator/pointer of integral types
+    */
+    template <typename U, typename V, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
+    Container (const U& begin, const V& end) : Dims(begin, end)
+    {
+        /// Total size is equal to this multiplication. See the 'initWeights' function.
+        Base::resize(weights.front() * dimSize.front(), T());
+
+        Map::init(dimSize);
+    }
+
+
+    /** A constructor taking a 'std::initializer_list', so you can also construct a
+      * container with a single dimension, like that: 'Container<int> c{1, 2, 3}'. The
+      * 'Container' in this case will have a single dimension with three elements.
+      *
+      * \param[in] il Initializer list of type 'T' (same as 'Container')
+    */
+    template<typename U, std::size_t M = Size, help::EnableIfZero< M > = 0,
+      		 help::EnableIfIntegral<std::decay_t<U>> = 0>
+    Container (std::initializer_list<U> il) : Container(il.begin(), il.end()) {}
+
+
+    /** The same constructors as above for a 'Size' of 0, after the tag 'uninitialized', like in
+      * 'Container<float> c(cnt::uninitialized, 4, 5, 6)'. The elements are default initialized,
+      * so trivial types are not written (see 'Uninitialized'). For a static shape, the tag is
+      * given alone, as in 'Container<float, 4, 5> c(cnt::uninitialized)'.
+    */
+    template <typename... Args, std::size_t M = Size, help::EnableIfZero< M > = 0>
+    Container (Uninitialized, const Args&... args) : Dims(sizesOf(args...))
+    {
+        /// 'InitAllocator' default initializes the elements inserted without a value
+        if(sizeof...(Args))
+            Base::resize(weights.front() * dimSize.front());
+
+        Map::init(dimSize);
+    }
+
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+
+    /** This access operator lets you pass variadic arguments being either integral
+      * types or iterables of integral types. The order of the arguments determines
+      * the position in each dimension. For example: 'Container<int> c(4, 1, 3);
+      * c(vector<long>{1, 0}, 2);' will give you the positions 1, 0 and 2 in the
+      * first, second and third dimension, respectivelly.
+      *
+      * \note The 'Dummie' template stuff is a trick to only allow the call if
+      * the arguments are either integral or iterable of integrals types.
+      *
+      * \param[in] args Either integral types or a iterables of integrals
+    */
+    //@{
+    template <typename... Args>
+    const_reference operator () (IntegralType, const Args&... args) const
+    {
+        return this->operator[](offset(std::integral_constant<bool, isRowMajor<L>>(), args...));
+    }
+
+
+
+    /** Access operator for an iterator defined by the starting position 'begin'.
+      * The dimensions to access are defined by the order of the integral elements
+      * of the iterator.
+      *
+      * \param[in] begin Initial position of the iterator/pointer of integral types
+    */
+    //@{
+    template <typename U>
+    const_reference operator () (IteratorType, const U& begin) const
+    {
+        return this->operator[](offsetRange(begin));
+    }
+    //@}
+
+
+    /** Access for a 'std::initializer_list' of integral type. You can then access a
+      * 'Container' as easily as: 'Container<int, 2, 3, 4> c;  c({1, 2, 3}) = 10'.
+      *
+      * \param[in] il Initializer list defining the position to access
+    */
+    //@{
+    template <typename U>
+    const_reference operator () (std::initializer_list<U> il) const
+    {
+        return this->operator[](offsetRange(il.begin()));
+    }
+    //@}
+
+
+
+
+    /// Size of each dimension
+    constexpr std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size
+    constexpr std::size_t size ()      const { return Base::size(); }
+
+    constexpr auto sizes ()      	   const { return dimSize; }
+
+    /** Distance, in elements, between consecutive positions of each dimension. Only defined if
+      * the layout is strided (row or column major).
+    */
+    constexpr auto strides ()          const
+    {
+        static_assert(Map::strided, "The layout of the container has no strides");
+
+        return strides(std::integral_constant<bool, isRowMajor<L>>());
+    }
+
+    constexpr std::size_t numDimensions () const { return numDimensions_; }
+
+
+
+
+
+
+//---------------------------------- Reshape ---------------------------------------------- //
+
+
+
+    /** Changes the sizes of the dimensions without moving the elements, which keep their order
+      * in memory. Only defined if the sizes are given at runtime. If the number of dimensions is
+      * fixed, there must be a size for each of them, otherwise the number of dimensions can also
+      * change. The total size must be the same, or 'std::invalid_argument' is thrown.
+      *
+      *     Container<float> c(120);
+      *     c.reshape(4, 5, 6);
+    */
+    //@{
+    template <typename U, typename V, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
+    void reshape (const U& begin, const V& end)
+    {
+        static_assert(Map::strided, "The layout of the container has no strides");
+
+        const std::size_t n = std::distance(begin, end);
+
+        if(sizeof...(Is) && n != sizeof...(Is))
+            throw std::invalid_argument("There must be a size for each dimension");
+
+        if(std::accumulate(begin, end, std::size_t(1), std::multiplies<std::size_t>()) != size())
+            throw std::invalid_argument("The total size must be the same");
+
+        Dims::assign(begin, end);
+
+        Map::init(dimSize);
+    }
+
+    template <typename... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIntegral< std::decay_t< Args >... > = 0>
+    void reshape (Args... args)
+    {
+        const std::size_t sizes[] = { std::size_t(args)... };
+
+        reshape(std::begin(sizes), std::end(sizes));
+    }
+
+    template <typename U, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIntegral< std::decay_t< U > > = 0>
+    void reshape (std::initializer_list<U> il)
+    {
+        reshape(il.begin(), il.end());
+    }
+    //@}
+
+
+
+    /** Changes the size of the outermost dimension to 'n', keeping the elements. In row major
+      * order the elements of the new positions of the first dimension go after the existing
+      * ones, so nothing is moved, except when the memory is reallocated. The capacity is at least
+      * doubled at each reallocation, so adding one position at a time costs amortized O(1) per
+      * element. The new elements are value initialized.
+    */
+    template <std::size_t M = Size, help::EnableIfZero< M > = 0>
+    void resizeOuter (std::size_t n)
+    {
+        static_assert(isRowMajor<L>, "Only the outermost dimension of a row major container can be resized");
+
+        if(!numDimensions_)
+            throw std::invalid_argument("The container has no dimensions");
+
+        const std::size_t newSize = n * weights.front();
+
+        checkIndex<Index>(&newSize, &newSize + 1);
+
+        if(newSize > Base::capacity())
+            Base::reserve(std::max(newSize, 2 * Base::capacity()));
+
+        Base::resize(newSize, T());
+
+        dimSize.front() = n;
+    }
+
+
+
+
+//---------------------------------- Slice ---------------------------------------------- //
+    
+
+
+    /** As the name says, it takes a 'Slice' of the container. If you use for example:
+      * 'Container<int, 2, 3, 4> c;   auto slc = c.slice(1);', the variable 'slc' will
+      * a proxy to access the container 'c', having two dimensions and starting from
+      * position 1 from the first dimension. For more, see the examples.
+      *
+      * \param[in] args Variadic integral arguments defining the dimensions to 'take a slice'.
+    */
+    //@{
+    template <typename... Args>
+    auto slice (const Args&... args) const
+    {
+        return Accessor<Slice<const Container>>(*this, args...);
+    }
+
+    template <typename... Args>
+    auto slice (const Args&... args)
+    {
+        return Accessor<Slice<Container>>(*this, args...);
+    }
+    //@}
+
+
+
+    /** Slice of a static shape whose indices are given at compile time. 'c.slice<1, 2>()' is
+      * the same slice as 'c.slice(1, 2)', but the result is a 'View' with the static shape of
+      * the remaining dimensions, placed at a constant offset from 'data()'. It holds only a
+      * pointer, its accesses are loads at constant offsets, and it can be used wherever a
+      * static shape is required, like the shape checks of the expressions.
+    */
+    //@{
+    template <std::size_t J, std::size_t... Js>
+    auto slice () const
+    {
+        return staticSlice<const T, J, Js...>(this->data());
+    }
+
+    template <std::size_t J, std::size_t... Js>
+    auto slice ()
+    {
+        return staticSlice<T, J, Js...>(this->data());
+    }
+    //@}
+
+
+
+private:
+
+
+    /** The sizes given by the same arguments as the constructors for a 'Size' of 0, used by
+      * the constructor taking 'Uninitialized'
+    */
+    //@{
+    static std::vector<std::size_t> sizesOf () { return std::vector<std::size_t>(sizeof...(Is), 0); }
+
+    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args >... > = 0>
+    static std::vector<std::size_t> sizesOf (const Args&... args)
+    {
+        static_assert(!sizeof...(Is) || sizeof...(Args) == sizeof...(Is), "There must be one size for each dimension");
+
+        return { std::size_t(args)... };
+    }
+
+    template <class... Args, help::EnableIfIterable< std::remove_reference_t< Args >... > = 0>
+    static std::vector<std::size_t> sizesOf (const Args&... args) { return help::concat(args...); }
+
+    template <typename U, typename V, help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
+    static std::vector<std::size_t> sizesOf (const U& begin, const V& end) { return std::vector<std::size_t>(begin, end); }
+    //@}
+
+
+
+    /// The view of the static slice 'Js' (see 'slice<J, Js...>()'). 'View' is defined in 'View.h'
+    template <typename U, std::size_t... Js>
+    static auto staticSlice (U* data)
+    {
+        using S = StaticSlice<Shape<Is...>, Js...>;
+
+        static_assert(isRowMajor<L>, "Static slices are only defined for row major containers");
+
+        static_assert(S::inBounds(), "The indices of the static slice are out of bounds");
+
+        return Accessor<View<U, typename S::type>>(data + S::offset());
+    }
+
+
+
+    /// The number of dimensions, their sizes and weights are defined in 'Dimensions'
+    //@{
+    using Dims::numDimensions_;
+
+    using Dims::dimSize;
+
+    using Dims::weights;
+    //@}
+
+
+
+    /** Position of the element given by 'args'. For row major order it is given by the weights
+      * of 'Dimensions', otherwise by the map of each dimension of the layout.
+    */
+    //@{
+    template <typename... Args>
+    std::size_t offset (std::true_type, const Args&... args) const
+    {
+        return Dims::offset(args...);
+    }
+
+    template <typename... Args>
+    std::size_t offset (std::false_type, const Args&... args) const
+    {
+        return offset(std::integral_constant<bool, And_v<std::is_integral_v<Args>...>>(),
+                      std::index_sequence_for<Args...>(), args...);
+    }
+
+    template <std::size_t... Js, typename... Args>
+    std::size_t offset (std::true_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        std::size_t pos = 0;
+
+        const auto& dummy = { (pos += Map::template map<Js>(std::size_t(args)), int{})..., int{} };
+
+        return pos;
+    }
+
+    template <std::size_t... Js, typename... Args>
+    std::size_t offset (std::false_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        std::size_t pos = 0, k = 0;
+
+        const auto& dummy = { (pos += mapIncrement(static_cast<const Map&>(*this), args, k), int{})..., int{} };
+
+        return pos;
+    }
+    //@}
+
+
+    /// Position of the element whose indices start at 'begin'
+    template <typename U>
+    std::size_t offsetRange (U begin) const
+    {
+        std::size_t pos = 0;
+
+        for(std::size_t k = 0; k < numDimensions_; ++k, ++begin)
+            pos += mapIndex(k, *begin);
+
+        return pos;
+    }
+
+
+    /// Part of the position given by the index 'x' of the dimension 'k' (used by 'Slice')
+    //@{
+    std::size_t mapIndex (std::size_t k, std::size_t x) const
+    {
+        return mapIndex(std::integral_constant<bool, isRowMajor<L>>(), k, x);
+    }
+
+    std::size_t mapIndex (std::true_type, std::size_t k, std::size_t x) const { return Dims::mapIndex(k, x); }
+
+    std::size_t mapIndex (std::false_type, std::size_t k, std::size_t x) const { return Map::map(k, x); }
+    //@}
+
+
+    /// The strides of row major order are the weights, and the column major ones are in the map
+    //@{
+    constexpr auto strides (std::true_type) const { return weights; }
+
+    constexpr auto strides (std::false_type) const { return Map::weights; }
+    //@}
+
+};
+
+
+
+
+// ----------------------------------- Accessors -------------------------- //
+
+
+/** The only purpose of this class is to delegate calls to the accessors of 'Container' 
+  * or 'Slice', so we dont have duplication of code and the classes can be written more clearly.
+  *
+*/
+template <class BaseType>
+struct Accessor : public BaseType	/// We inherit from either 'Container' or 'Slice'
+{
+	/** Some type definitions */
+    //@{
+	using Base = BaseType;
+
+	using Base::Base;
+
+
+    using value_type = typename Base::value_type;
+
+    using reference = typename Base::reference;
+
+    using const_reference = typename Base::const_reference;
+    //@}
+
+
+    /** These functions simply delegate the access to either 'Container' or 'Slice', which
+      * have the same interface for access. They are also responsible to handle the SFINAE
+      * to treat all different types of access.
+    */
+    //@{
+
+    /// Integral or Iterable types
+    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
+    const_reference operator () (const Args&... args) const
+    {
+    	return Base::operator()(IntegralType{}, args...);
+    }
+
+    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
+    reference operator () (const Args&... args)
+    {
+    	return const_cast<reference>(static_cast<const Accessor&>(*this)(args...));
+    }
+
+
+
+    /// Iterators
+    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
+    const_reference operator () (const U& begin) const
+    {
+        return Base::operator()(IteratorType{}, begin);
+    }
+
+    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
+    reference operator () (const U& begin)
+    {
+        return const_cast<reference>(static_cast<const Accessor&>(*this)(begin));
+    }
+
+
+
+    /// Specific for 'std::initializer_list'
+    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
+    const_reference operator () (std::initializer_list<U> il) const
+    {
+        return Base::operator()(il);
+    }
+
+    template <typename U, help::EnableIfIntegral< std::decay_t< U > > = 0 >
+    reference operator () (std::initializer_list<U> il)
+    {
+        return const_cast<reference>(static_cast<const Accessor&>(*this)(il));
+    }
+
+
+
+    /// For tuples containing integrals or iterables
+    template <typename... Args, help::EnableIfIntegral<std::decay_t<Args>...> = 0>
+    constexpr const_reference operator () (const std::tuple<Args...>& tup) const
+    {
+        return this->operator()(tup, std::make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args>...> = 0 >
+    constexpr reference operator () (const std::tuple<Args...>& tup)
+    {
+        return const_cast<reference>(static_cast<const Accessor&>(*this)(tup));
+    }
+
+    template <typename... Args, std::size_t... Js>
+    constexpr const_reference operator () (const std::tuple<Args...>& tup, std::index_sequence<Js...>) const
+    {
+        return this->operator()(std::get<Js>(tup)...);
+    }
+    //@}
+
+
+
+    /** Elementwise arithmetic (see 'Expression.h'). The expression, container or scalar on the
+      * right side is evaluated into this one in a single loop, without temporaries.
+    */
+    //@{
+    template <class E>
+    Accessor& operator = (const Expression<E>& e)
+    {
+        help::evaluate(*this, e, [](auto& x, const auto& y){ x = y; });
+
+        return *this;
+    }
+
+    template <class U>
+    Accessor& operator += (const U& u)
+    {
+        help::evaluate(*this, u, [](auto& x, const auto& y){ x += y; });
+
+        return *this;
+    }
+
+    template <class U>
+    Accessor& operator -= (const U& u)
+    {
+        help::evaluate(*this, u, [](auto& x, const auto& y){ x -= y; });
+
+        return *this;
+    }
+
+    template <class U>
+    Accessor& operator *= (const U& u)
+    {
+        help::evaluate(*this, u, [](auto& x, const auto& y){ x *= y; });
+
+        return *this;
+    }
+
+    template <class U>
+    Accessor& operator /= (const U& u)
+    {
+        help::evaluate(*this, u, [](auto& x, const auto& y){ x /= y; });
+
+        return *this;
+    }
+    //@}
+};
+
+
+
+} // namespace help
+
+
+
+/** These are the classes you will use: the 'Accessor' class over a 'Container' or a 'Slice' */
+//@{
+template <typename T, std::size_t... Is>
+using Container = help::Accessor<help::Container<T, Shape<Is...>>>;
+
+template <typename T, std::size_t... Is>
+using Slice = help::Accessor<help::Container<T, Shape<Is...>>>;
+//@}
+
+
+/** The same as 'Container', but the shape is given as a 'Shape' type, followed by the other
+  * policies. For example, 'BasicContainer<float, Shape<0, 0>, AlignedAllocator<float>>' has
+  * two dimensions and its elements aligned to 64 bytes, and
+  * 'BasicContainer<float, Shape<0, 0>, std::allocator<float>, ColumnMajor>' is column major.
+  * 'BasicContainer<float, Shape<0, 0>, std::allocator<float>, RowMajor, std::uint32_t>' computes
+  * the positions of its elements and of its slices with 32 bits integers.
+*/
+template <typename T, class S, class Alloc = std::allocator<T>, class L = RowMajor, typename Index = std::size_t>
+using BasicContainer = help::Accessor<help::Container<T, S, Alloc, L, Index>>;
+
+
+
+
+} // namespace cnt
+
+
+/// The static slices of 'Container' are views
+#include "View.h"
+
+
+#endif  // CNT_CONTAINER_H
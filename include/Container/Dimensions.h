@@ -0,0 +1,515 @@
+/** \file Dimensions.h
+  *
+  * Storage for the size and weight of each dimension of a 'Container'. When the
+  * shape is known at compile time, everything here is 'static constexpr', so a
+  * 'Container' carries no metadata besides its elements.
+*/
+
+#ifndef CNT_DIMENSIONS_H
+#define CNT_DIMENSIONS_H
+
+#include <numeric>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "Vector.h"
+
+
+namespace cnt
+{
+
+/** The compile time shape of a 'Container', given as a type so other policies (like the
+  * allocator) can follow it. See 'Dimensions' for the meaning of the sizes 'Is'.
+*/
+template <std::size_t... Is>
+struct Shape {};
+
+
+
+namespace help
+{
+
+
+/** Weight of the dimension 'J' of a static shape 'Is', that is, the multiplication
+  * of the sizes of all dimensions after 'J' (row major order).
+*/
+//@{
+template <std::size_t J, std::size_t... Is>
+constexpr std::size_t weight ()
+{
+    const std::size_t dims[] = { Is... };
+
+    std::size_t res = 1;
+
+    for(std::size_t i = J + 1; i < sizeof...(Is); ++i)
+        res *= dims[i];
+
+    return res;
+}
+
+template <std::size_t J, std::size_t... Is>
+constexpr std::size_t weight_v = weight<J, Is...>();
+
+
+template <typename Index, std::size_t... Is, std::size_t... Js>
+constexpr std::array<Index, sizeof...(Is)> staticWeights (std::index_sequence<Js...>)
+{
+    return {{ Index(weight_v<Js, Is...>)... }};
+}
+//@}
+
+
+
+/// The size of the dimension 'J' of the static shape 'Is'
+template <std::size_t J, std::size_t... Is>
+constexpr std::size_t dimension ()
+{
+    const std::size_t dims[] = { Is... };
+
+    return dims[J];
+}
+
+
+/** The slice of the static shape 'Is' that fixes its first dimensions at the indices 'Js'.
+  * 'type' is the static shape of the remaining dimensions and 'offset()' the position of the
+  * first element of the slice, both known at compile time.
+*/
+//@{
+template <class S, std::size_t... Js>
+struct StaticSlice;
+
+template <std::size_t... Is, std::size_t... Js>
+struct StaticSlice<Shape<Is...>, Js...>
+{
+    static_assert(sizeof...(Js) < sizeof...(Is), "A static slice must keep at least one dimension");
+
+    static_assert(And_v<(Is != 0)...>, "Static slices are only defined for static shapes");
+
+
+    /// Tells if every index is less than the size of its dimension
+    static constexpr bool inBounds ()
+    {
+        const std::size_t dims[] = { Is... }, idx[] = { Js..., 0 };
+
+        for(std::size_t k = 0; k < sizeof...(Js); ++k)
+            if(idx[k] >= dims[k])
+                return false;
+
+        return true;
+    }
+
+
+    /// Position of the first element of the slice
+    static constexpr std::size_t offset ()
+    {
+        const std::size_t dims[] = { Is... }, idx[] = { Js..., 0 };
+
+        std::size_t res = 0;
+
+        for(std::size_t k = 0; k < sizeof...(Is); ++k)
+            res = res * dims[k] + (k < sizeof...(Js) ? idx[k] : 0);
+
+        return res;
+    }
+
+
+    template <std::size_t... Ks>
+    static Shape<dimension<sizeof...(Js) + Ks, Is...>()...> shape (std::index_sequence<Ks...>);
+
+    using type = decltype(shape(std::make_index_sequence<sizeof...(Is) - sizeof...(Js)>()));
+};
+//@}
+
+
+
+
+/** These functions get either a integral type or a iterable of integrals
+  * and multiply each element with the iterator 'iter', given by a position
+  * in the variable 'weights'. The iterator is incremented, and the value
+  * of the multiplication is returned.
+  *
+  * \param[in] u Either a integral type or a iterable of integrals
+  * \param[in] iter A reference to a iterator.
+  * \return Result after multiplication(s).
+*/
+//@{
+template <typename U, typename Iter, EnableIfIntegral<std::decay_t<U>> = 0>
+inline std::size_t increment (U u, Iter& iter)
+{
+    return *iter++ * u;
+}
+
+
+template <typename U, typename Iter, EnableIfIterable<std::decay_t<U>> = 0>
+inline std::size_t increment (const U& u, Iter& iter)
+{
+    std::size_t res = 0;
+
+    for(auto x : u)
+        res += *iter++ * x;
+
+    return res;
+}
+//@}
+
+
+/** Position of the element given by 'args', either integrals or iterables of integrals,
+  * where 'iter' points to the weight of the first dimension.
+*/
+template <typename Iter, typename... Args>
+inline std::size_t position (Iter iter, const Args&... args)
+{
+    std::size_t pos = 0;
+
+    const auto& dummy = { (pos += increment(args, iter), int{})..., int{} };
+
+    return pos;
+}
+
+
+
+
+/** Throws 'std::invalid_argument' if a size in the range [begin, end), or their product, can
+  * not be represented by 'Index'. Nothing is checked for 'std::size_t'.
+*/
+template <typename Index, typename U, typename V>
+void checkIndex (U begin, const V& end)
+{
+    const std::size_t max = std::size_t(std::numeric_limits<Index>::max());
+
+    if(max == std::numeric_limits<std::size_t>::max())
+        return;
+
+    for(std::size_t n = 1; begin != end; ++begin)
+        if(std::size_t(*begin) > max || (n *= std::size_t(*begin)) > max)
+            throw std::invalid_argument("The sizes do not fit in the index type of the container");
+}
+
+
+
+
+/** Concatenates the integrals of the iterables 'args' into a single 'std::vector'. Used
+  * to create the dimensions from a list of iterables of integrals.
+*/
+template <typename... Args>
+inline std::vector<std::size_t> concat (const Args&... args)
+{
+    std::vector<std::size_t> res;
+
+    const auto& dummy = { (res.insert(res.end(), std::begin(args), std::end(args)), int{})..., int{} };
+
+    return res;
+}
+
+
+
+
+/** The sizes and weights of the dimensions, with the positions of the elements computed with
+  * the integral type 'Index'. A 32 bits index makes the runtime sizes and the views smaller,
+  * and the computation of positions can use twice as many vector lanes, but the total size
+  * must fit in it. 'Dimensions' uses 'std::size_t'.
+  *
+  * This one is for a static shape. There is no per instance data: the sizes and weights
+  * are compile time tables, and the position of an element given only integral
+  * indices is a multiply-add chain over constants.
+*/
+template <typename Index, std::size_t... Is>
+class BasicDimensions
+{
+    static_assert(And_v<(Is != 0)...>, "Either all sizes are given at compile time or none of them");
+
+    static_assert(std::is_integral_v<Index> && help::multiply_v<Is...> <= std::size_t(std::numeric_limits<Index>::max()),
+                  "The size does not fit in the index type");
+
+public:
+
+    using index_type = Index;
+
+protected:
+
+    using Sizes = std::array<Index, sizeof...(Is)>;
+
+
+    static constexpr std::size_t numDimensions_ = sizeof...(Is);   /// Number of dimensions
+
+    static constexpr Sizes dimSize = {{ Is... }};   /// The size of each dimension
+
+    static constexpr Sizes weights = staticWeights<Index, Is...>(std::make_index_sequence<sizeof...(Is)>());   /// The weights
+
+
+
+    /** Position of the element given by 'args'. If all of them are integrals, the computation
+      * is unrolled over the constant weights.
+    */
+    //@{
+    template <typename... Args>
+    static Index offset (const Args&... args)
+    {
+        return offset(std::integral_constant<bool, And_v<std::is_integral_v<Args>...>>(),
+                      std::index_sequence_for<Args...>(), args...);
+    }
+
+    template <std::size_t... Js, typename... Args>
+    static Index offset (std::true_type, std::index_sequence<Js...>, const Args&... args)
+    {
+        Index pos = 0;
+
+        const auto& dummy = { (pos += Index(weight_v<Js, Is...>) * Index(args), int{})..., int{} };
+
+        return pos;
+    }
+
+    template <std::size_t... Js, typename... Args>
+    static Index offset (std::false_type, std::index_sequence<Js...>, const Args&... args)
+    {
+        return Index(position(weights.begin(), args...));
+    }
+    //@}
+
+
+    /// Part of the position given by the index 'x' of the dimension 'k'
+    static Index mapIndex (std::size_t k, std::size_t x) { return weights[k] * Index(x); }
+};
+
+
+/// Definitions of the static tables, as they can be odr-used (by 'Slice', for example)
+//@{
+template <typename Index, std::size_t... Is>
+constexpr std::size_t BasicDimensions<Index, Is...>::numDimensions_;
+
+template <typename Index, std::size_t... Is>
+constexpr typename BasicDimensions<Index, Is...>::Sizes BasicDimensions<Index, Is...>::dimSize;
+
+template <typename Index, std::size_t... Is>
+constexpr typename BasicDimensions<Index, Is...>::Sizes BasicDimensions<Index, Is...>::weights;
+//@}
+
+
+
+
+/** Dimensions of a shape with the number of dimensions given at compile time, but with
+  * sizes given only at runtime. This is selected by passing '0' for every size, so a
+  * 'Container<T, 0, 0, 0>' has three dimensions. The sizes and weights are kept inline
+  * in 'std::array's, and the position of an element is unrolled at compile time.
+*/
+template <typename Index, std::size_t... Is>
+class BasicDimensions<Index, 0, Is...>
+{
+    static_assert(And_v<(Is == 0)...>, "Either all sizes are given at compile time or none of them");
+
+public:
+
+    using index_type = Index;
+
+protected:
+
+    static constexpr std::size_t numDimensions_ = 1 + sizeof...(Is);   /// Number of dimensions
+
+    using Sizes = std::array<Index, numDimensions_>;
+
+
+
+    BasicDimensions () : dimSize{}, weights{} {}
+
+
+    /// Sizes given by the range [begin, end). There must be exactly 'numDimensions_' of them
+    template <typename U, typename V>
+    BasicDimensions (const U& begin, const V& end) : dimSize{}, weights{}
+    {
+        checkRank(begin, end);
+
+        checkIndex<Index>(begin, end);
+
+        std::copy(begin, end, dimSize.begin());
+
+        initWeights();
+    }
+
+
+    /// Sizes given by a list of integrals
+    BasicDimensions (std::initializer_list<std::size_t> il) : BasicDimensions(il.begin(), il.end()) {}
+
+    /// Sizes given by a 'std::vector' (see 'concat')
+    explicit BasicDimensions (const std::vector<std::size_t>& v) : BasicDimensions(v.begin(), v.end()) {}
+
+
+
+    /// Replaces the sizes by the range [begin, end), of 'numDimensions_' elements
+    template <typename U, typename V>
+    void assign (const U& begin, const V& end)
+    {
+        checkRank(begin, end);
+
+        checkIndex<Index>(begin, end);
+
+        std::copy(begin, end, dimSize.begin());
+
+        initWeights();
+    }
+
+
+    /// Throws 'std::invalid_argument' if the range [begin, end) does not have a size for each dimension
+    template <typename U, typename V>
+    static void checkRank (const U& begin, const V& end)
+    {
+        if(std::size_t(std::distance(begin, end)) != numDimensions_)
+            throw std::invalid_argument("There must be a size for each dimension");
+    }
+
+
+    /// Same as for the runtime shape, but over 'std::array's
+    void initWeights ()
+    {
+        weights.back() = 1;
+
+        std::partial_sum(dimSize.rbegin() , dimSize.rend() - 1,
+                         weights.rbegin() + 1, std::multiplies<std::size_t>());
+    }
+
+
+
+    /** Position of the element given by 'args'. If all of them are integrals, the computation
+      * is unrolled over the weights.
+    */
+    //@{
+    template <typename... Args>
+    Index offset (const Args&... args) const
+    {
+        return offset(std::integral_constant<bool, And_v<std::is_integral_v<Args>...>>(),
+                      std::index_sequence_for<Args...>(), args...);
+    }
+
+    template <std::size_t... Js, typename... Args>
+    Index offset (std::true_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        Index pos = 0;
+
+        const auto& dummy = { (pos += std::get<Js>(weights) * Index(args), int{})..., int{} };
+
+        return pos;
+    }
+
+    template <std::size_t... Js, typename... Args>
+    Index offset (std::false_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        return Index(position(weights.begin(), args...));
+    }
+    //@}
+
+
+    /// Part of the position given by the index 'x' of the dimension 'k'
+    Index mapIndex (std::size_t k, std::size_t x) const { return weights[k] * Index(x); }
+
+
+
+    Sizes dimSize;      /// The size of each dimension
+
+    Sizes weights;      /// The weights to access given the position and sizes of the dimensions
+};
+
+
+template <typename Index, std::size_t... Is>
+constexpr std::size_t BasicDimensions<Index, 0, Is...>::numDimensions_;
+
+
+
+
+/** Dimensions of a shape given only at runtime. The sizes and weights are kept in
+  * 'std::vector's, and the weights are computed at construction.
+*/
+template <typename Index>
+class BasicDimensions<Index>
+{
+public:
+
+    using index_type = Index;
+
+protected:
+
+    BasicDimensions () : numDimensions_(0) {}
+
+
+    /// Sizes given by the range [begin, end)
+    template <typename U, typename V>
+    BasicDimensions (const U& begin, const V& end) : numDimensions_(std::distance(begin, end)),
+                                                     dimSize((checkIndex<Index>(begin, end), begin), end),
+                                                     weights(std::distance(begin, end))
+    {
+        initWeights();
+    }
+
+
+    /// Sizes given by a list of integrals
+    BasicDimensions (std::initializer_list<std::size_t> il) : BasicDimensions(il.begin(), il.end()) {}
+
+    /// Sizes given by a 'std::vector' (see 'concat')
+    explicit BasicDimensions (const std::vector<std::size_t>& v) : BasicDimensions(v.begin(), v.end()) {}
+
+
+
+    /// Replaces the sizes, and the number of dimensions, by the range [begin, end)
+    template <typename U, typename V>
+    void assign (const U& begin, const V& end)
+    {
+        checkIndex<Index>(begin, end);
+
+        numDimensions_ = std::distance(begin, end);
+
+        dimSize.assign(begin, end);
+        weights.resize(numDimensions_);
+
+        initWeights();
+    }
+
+
+
+    /** This function is called from all constructors. It will initialize the 'weights' to
+      * access a given position in the continuous array by performing an inner product,
+      * given the size of each dimension.
+    */
+    void initWeights ()
+    {
+        weights.back() = 1;
+
+        std::partial_sum(dimSize.rbegin() , dimSize.rend() - 1,
+                         weights.rbegin() + 1, std::multiplies<std::size_t>());
+    }
+
+
+    /// Position of the element given by 'args'
+    template <typename... Args>
+    Index offset (const Args&... args) const
+    {
+        return Index(position(weights.begin(), args...));
+    }
+
+    /// Part of the position given by the index 'x' of the dimension 'k'
+    Index mapIndex (std::size_t k, std::size_t x) const { return weights[k] * Index(x); }
+
+
+
+    std::size_t numDimensions_;     /// Number of dimensions
+
+    Vector<Index> dimSize;          /// The size of each dimension
+
+    Vector<Index> weights;          /// The weights to access given the position and sizes of the dimensions
+};
+
+
+
+/// The dimensions with positions computed with 'std::size_t'
+template <std::size_t... Is>
+using Dimensions = BasicDimensions<std::size_t, Is...>;
+
+
+
+} // namespace help
+
+} // namespace cnt
+
+
+#endif // CNT_DIMENSIONS_H
@@ -0,0 +1,591 @@
+/** \file Expression.h
+  *
+  * Lazy elementwise arithmetic over 'Container', 'Slice' and 'ContainerView'. The operators
+  * only build small expression objects, and the whole expression is evaluated in a single
+  * loop when it is assigned to a container:
+  *
+  *     cnt::Container<float> a(100, 100), b(100, 100), c(100, 100);
+  *
+  *     a = b * c + 2.0f * cnt::exp(b) - c / 3.0f;     // One pass, no temporary containers
+  *
+  * When the shapes of the containers are static, different shapes do not compile.
+*/
+
+#ifndef CNT_EXPRESSION_H
+#define CNT_EXPRESSION_H
+
+#include <cmath>
+#include <stdexcept>
+
+#include "View.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+template <typename T, class S>
+class Mapped;
+
+
+
+/** Base class of every node of an expression. The nodes have the same interface: the element
+  * 'i' in row major order is given by 'operator[]', the total number of elements by 'size()',
+  * and the shape known at compile time by the type 'StaticShape' ('Shape<>' if not static).
+*/
+template <class E>
+struct Expression
+{
+    const E& self () const { return static_cast<const E&>(*this); }
+};
+
+
+
+/// The static shape of 'S', or 'Shape<>' if any size is given only at runtime
+//@{
+template <class S>
+struct StaticShapeOf { using type = Shape<>; };
+
+template <std::size_t... Is>
+struct StaticShapeOf<Shape<Is...>>
+{
+    using type = std::conditional_t<(multiply_v<Is...> > 0), Shape<Is...>, Shape<>>;
+};
+//@}
+
+
+
+/** The shape of two operands of an expression: if both are static, they must be the same.
+  * Otherwise the static one is kept.
+*/
+//@{
+template <class S1, class S2>
+struct CommonShape
+{
+    static_assert(std::is_same_v<S1, S2>, "The shapes of the containers are different");
+
+    using type = S1;
+};
+
+template <class S>
+struct CommonShape<Shape<>, S> { using type = S; };
+
+template <class S>
+struct CommonShape<S, Shape<>> { using type = S; };
+
+template <>
+struct CommonShape<Shape<>, Shape<>> { using type = Shape<>; };
+
+template <class S1, class S2>
+using CommonShape_t = typename CommonShape<S1, S2>::type;
+//@}
+
+
+
+/** The layout of two operands of an expression. The elements are paired by their position in
+  * memory, so the layouts must be the same. Scalars have no layout ('void'). A 'Slice' is
+  * always in row major order, so 'c.slice()' can be used with containers of other layouts.
+*/
+//@{
+template <class L1, class L2>
+struct CommonLayout
+{
+    static_assert(std::is_same_v<L1, L2>, "The layouts of the containers are different");
+
+    using type = L1;
+};
+
+template <class L>
+struct CommonLayout<void, L> { using type = L; };
+
+template <class L>
+struct CommonLayout<L, void> { using type = L; };
+
+template <>
+struct CommonLayout<void, void> { using type = void; };
+
+template <class L1, class L2>
+using CommonLayout_t = typename CommonLayout<L1, L2>::type;
+//@}
+
+
+
+/** The types that can be leaves of an expression. Views and slices are cheap to copy, so they
+  * are kept by value. Containers are kept by reference.
+*/
+//@{
+template <class>
+struct LeafTraits { static constexpr bool isLeaf = false; };
+
+template <typename T, class S, class Alloc, class L, typename Index>
+struct LeafTraits<Accessor<Container<T, S, Alloc, L, Index>>>
+{
+    static constexpr bool isLeaf = true, byValue = false;
+
+    using StaticShape = typename StaticShapeOf<S>::type;
+
+    using Layout = L;
+};
+
+template <class C>
+struct LeafTraits<Accessor<Slice<C>>>
+{
+    static constexpr bool isLeaf = true, byValue = true;
+
+    using StaticShape = Shape<>;
+
+    using Layout = RowMajor;
+};
+
+template <typename T, class S>
+struct LeafTraits<Accessor<View<T, S>>>
+{
+    static constexpr bool isLeaf = true, byValue = true;
+
+    using StaticShape = typename StaticShapeOf<S>::type;
+
+    using Layout = RowMajor;
+};
+
+template <typename T, class S>
+struct LeafTraits<Accessor<Mapped<T, S>>>
+{
+    static constexpr bool isLeaf = true, byValue = false;
+
+    using StaticShape = typename StaticShapeOf<S>::type;
+
+    using Layout = RowMajor;
+};
+
+
+template <class T>
+constexpr bool isLeaf = LeafTraits<std::decay_t<T>>::isLeaf;
+
+template <class T>
+constexpr bool isExpression = std::is_base_of<Expression<std::decay_t<T>>, std::decay_t<T>>::value;
+
+template <class T>
+constexpr bool isScalar = std::is_arithmetic<std::decay_t<T>>::value;
+//@}
+
+
+/// Enable if 'L' and 'R' can be operands, and at least one of them is not a scalar
+template <class L, class R>
+using EnableIfOperands = std::enable_if_t<(isLeaf<L> || isExpression<L> || isScalar<L>) &&
+                                          (isLeaf<R> || isExpression<R> || isScalar<R>) &&
+                                          !(isScalar<L> && isScalar<R>), int>;
+
+/// Enable if 'E' is a container or an expression
+template <class E>
+using EnableIfNode = std::enable_if_t<isLeaf<E> || isExpression<E>, int>;
+
+
+
+
+// ----------------------------------- Nodes ---------------------------------------- //
+
+
+/** Tells if the operands 'a' and 'b' have the same sizes in each dimension. If one of them has a
+  * single dimension, only the total sizes are compared, so a flat container can be combined with
+  * any container with the same number of elements.
+*/
+template <class A, class B>
+bool sameShape (const A& a, const B& b)
+{
+    if(a.numDimensions() < 2 || b.numDimensions() < 2)
+        return a.size() == b.size();
+
+    if(a.numDimensions() != b.numDimensions())
+        return false;
+
+    for(std::size_t k = 0; k < a.numDimensions(); ++k)
+        if(a.size(k) != b.size(k))
+            return false;
+
+    return true;
+}
+
+
+
+/// A container at the leaf of an expression
+template <class C>
+struct Terminal : public Expression<Terminal<C>>
+{
+    using StaticShape = typename LeafTraits<C>::StaticShape;
+
+    using Layout = typename LeafTraits<C>::Layout;
+
+    using value_type = typename C::value_type;
+
+
+    Terminal (const C& c) : c(c) {}
+
+
+    decltype(auto) operator [] (std::size_t i) const { return c[i]; }
+
+    std::size_t size () const { return c.size(); }
+
+    std::size_t size (std::size_t k) const { return c.size(k); }
+
+    std::size_t numDimensions () const { return c.numDimensions(); }
+
+
+    std::conditional_t<LeafTraits<C>::byValue, C, const C&> c;
+};
+
+
+/// A scalar, with the same value for every element
+template <typename T>
+struct Scalar : public Expression<Scalar<T>>
+{
+    using StaticShape = Shape<>;
+
+    using Layout = void;
+
+    using value_type = T;
+
+
+    Scalar (T value) : value(value) {}
+
+
+    T operator [] (std::size_t) const { return value; }
+
+    std::size_t size () const { return 0; }      /// A scalar has no size
+
+    std::size_t size (std::size_t) const { return 0; }
+
+    std::size_t numDimensions () const { return 0; }
+
+
+    T value;
+};
+
+
+/// Applies 'Op' to each element of 'E'
+template <class Op, class E>
+struct Unary : public Expression<Unary<Op, E>>
+{
+    using StaticShape = typename E::StaticShape;
+
+    using Layout = typename E::Layout;
+
+    using value_type = std::decay_t<decltype(Op()(std::declval<const E&>()[0]))>;
+
+
+    Unary (const E& e) : e(e) {}
+
+
+    value_type operator [] (std::size_t i) const { return Op()(e[i]); }
+
+    std::size_t size () const { return e.size(); }
+
+    std::size_t size (std::size_t k) const { return e.size(k); }
+
+    std::size_t numDimensions () const { return e.numDimensions(); }
+
+
+    E e;
+};
+
+
+/** Applies 'Op' to each pair of elements of 'L' and 'R'. If neither of them is a scalar, their
+  * shapes must be the same (see 'sameShape'), otherwise 'std::invalid_argument' is thrown. The
+  * shape of the node is the one of the operand that is not a scalar and, if only one of them
+  * has a single dimension, of the other one, so a flat operand does not hide the shape of the
+  * expression from the next comparison.
+*/
+template <class Op, class L, class R>
+struct Binary : public Expression<Binary<Op, L, R>>
+{
+    using StaticShape = CommonShape_t<typename L::StaticShape, typename R::StaticShape>;
+
+    using Layout = CommonLayout_t<typename L::Layout, typename R::Layout>;
+
+    using value_type = std::decay_t<decltype(Op()(std::declval<const L&>()[0], std::declval<const R&>()[0]))>;
+
+
+    Binary (const L& l, const R& r) : l(l), r(r)
+    {
+        checkSizes(std::integral_constant<bool, !isScalarNode<L> && !isScalarNode<R>>());
+    }
+
+
+    value_type operator [] (std::size_t i) const { return Op()(l[i], r[i]); }
+
+    std::size_t size () const { return size(std::integral_constant<bool, isScalarNode<L>>()); }
+
+    std::size_t size (std::size_t k) const { return shapeOfRight() ? r.size(k) : l.size(k); }
+
+    std::size_t numDimensions () const { return shapeOfRight() ? r.numDimensions() : l.numDimensions(); }
+
+
+    L l;
+
+    R r;
+
+
+private:
+
+    template <class E>
+    static constexpr bool isScalarNode = std::is_same_v<E, Scalar<typename E::value_type>>;
+
+
+    /// If the shape is the one of 'r': 'l' is a scalar, or it is flat and 'r' is not a scalar
+    bool shapeOfRight () const
+    {
+        return isScalarNode<L> || (!isScalarNode<R> && l.numDimensions() < 2);
+    }
+
+
+    std::size_t size (std::true_type) const { return r.size(); }
+
+    std::size_t size (std::false_type) const { return l.size(); }
+
+
+    void checkSizes (std::true_type) const
+    {
+        if(!sameShape(l, r))
+            throw std::invalid_argument("The sizes of the containers are different");
+    }
+
+    void checkSizes (std::false_type) const {}
+};
+
+
+
+
+/** Wraps an operand as a node: containers as 'Terminal', scalars as 'Scalar', and nodes
+  * are simply copied.
+*/
+//@{
+template <class C, std::enable_if_t<isLeaf<C>, int> = 0>
+Terminal<C> wrap (const C& c) { return Terminal<C>(c); }
+
+template <class E>
+E wrap (const Expression<E>& e) { return e.self(); }
+
+template <typename T, std::enable_if_t<isScalar<T>, int> = 0>
+Scalar<T> wrap (const T& t) { return Scalar<T>(t); }
+//@}
+
+
+template <class Op, class L, class R>
+auto makeBinary (const L& l, const R& r)
+{
+    return Binary<Op, decltype(wrap(l)), decltype(wrap(r))>(wrap(l), wrap(r));
+}
+
+template <class Op, class E>
+auto makeUnary (const E& e)
+{
+    return Unary<Op, decltype(wrap(e))>(wrap(e));
+}
+
+
+
+
+/** Evaluates 'u' (an expression, a container or a scalar) into the container 'c', calling
+  * 'op(c[i], u[i])' for each element in a single loop over a pointer. Slices that are not
+  * contiguous are written through their 'operator[]'. Unless 'u' is a scalar, 'c' and 'u' must
+  * have the same shape (see 'sameShape'), otherwise 'std::invalid_argument' is thrown.
+*/
+template <class C, class U, class Op>
+void evaluate (C& c, const U& u, Op op)
+{
+    const auto e = wrap(u);
+
+    static_assert(sizeof(CommonShape_t<typename LeafTraits<C>::StaticShape,
+                                       typename decltype(e)::StaticShape>), "Checks the static shapes");
+
+    static_assert(sizeof(CommonLayout_t<typename LeafTraits<C>::Layout,
+                                        typename decltype(e)::Layout>), "Checks the layouts");
+
+    const std::size_t n = c.size();
+
+    if(!isScalar<U> && !sameShape(c, e))
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    if(!n)
+        return;
+
+
+    if(!contiguous(c, 0))
+    {
+        for(std::size_t i = 0; i < n; ++i)
+            op(c[i], e[i]);
+
+        return;
+    }
+
+
+    auto* p = &*c.begin();
+
+    for(std::size_t i = 0; i < n; ++i)
+        op(p[i], e[i]);
+}
+
+
+
+/** The operations. Each is a function object, so the compiler sees the whole expression */
+//@{
+struct Plus
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return a + b; }
+};
+
+struct Minus
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return a - b; }
+};
+
+struct Multiplies
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return a * b; }
+};
+
+struct Divides
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return a / b; }
+};
+
+struct Negate
+{
+    template <typename A>
+    auto operator () (const A& a) const { return -a; }
+};
+
+struct Abs
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::abs; return abs(a); }
+};
+
+struct Sqrt
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::sqrt; return sqrt(a); }
+};
+
+struct Exp
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::exp; return exp(a); }
+};
+
+struct Log
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::log; return log(a); }
+};
+
+struct Sin
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::sin; return sin(a); }
+};
+
+struct Cos
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::cos; return cos(a); }
+};
+
+struct Tanh
+{
+    template <typename A>
+    auto operator () (const A& a) const { using std::tanh; return tanh(a); }
+};
+
+struct Pow
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { using std::pow; return pow(a, b); }
+};
+
+struct Min
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return b < a ? b : a; }
+};
+
+struct Max
+{
+    template <typename A, typename B>
+    auto operator () (const A& a, const B& b) const { return a < b ? b : a; }
+};
+//@}
+
+
+
+
+/** The arithmetic operators. They are found by argument dependent lookup, as the containers
+  * and the nodes are in this namespace.
+*/
+//@{
+template <class L, class R, EnableIfOperands<L, R> = 0>
+auto operator + (const L& l, const R& r) { return makeBinary<Plus>(l, r); }
+
+template <class L, class R, EnableIfOperands<L, R> = 0>
+auto operator - (const L& l, const R& r) { return makeBinary<Minus>(l, r); }
+
+template <class L, class R, EnableIfOperands<L, R> = 0>
+auto operator * (const L& l, const R& r) { return makeBinary<Multiplies>(l, r); }
+
+template <class L, class R, EnableIfOperands<L, R> = 0>
+auto operator / (const L& l, const R& r) { return makeBinary<Divides>(l, r); }
+
+template <class E, EnableIfNode<E> = 0>
+auto operator - (const E& e) { return makeUnary<Negate>(e); }
+//@}
+
+
+} // namespace help
+
+
+
+/** Elementwise functions over containers and expressions */
+//@{
+template <class E, help::EnableIfNode<E> = 0>
+auto abs (const E& e) { return help::makeUnary<help::Abs>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto sqrt (const E& e) { return help::makeUnary<help::Sqrt>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto exp (const E& e) { return help::makeUnary<help::Exp>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto log (const E& e) { return help::makeUnary<help::Log>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto sin (const E& e) { return help::makeUnary<help::Sin>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto cos (const E& e) { return help::makeUnary<help::Cos>(e); }
+
+template <class E, help::EnableIfNode<E> = 0>
+auto tanh (const E& e) { return help::makeUnary<help::Tanh>(e); }
+
+template <class L, class R, help::EnableIfOperands<L, R> = 0>
+auto pow (const L& l, const R& r) { return help::makeBinary<help::Pow>(l, r); }
+
+template <class L, class R, help::EnableIfOperands<L, R> = 0>
+auto min (const L& l, const R& r) { return help::makeBinary<help::Min>(l, r); }
+
+template <class L, class R, help::EnableIfOperands<L, R> = 0>
+auto max (const L& l, const R& r) { return help::makeBinary<help::Max>(l, r); }
+//@}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_EXPRESSION_H
@@ -0,0 +1,301 @@
+/** \file Gemm.h
+  *
+  * Matrix products of containers of 2 dimensions, and of stacks of matrices of 3 dimensions:
+  *
+  *     cnt::Container<float, 0, 0> a(512, 256), b(256, 1024);
+  *
+  *     auto c = cnt::matmul(a, b);                             // 512 x 1024
+  *     cnt::gemm(2.0f, a, b, 1.0f, c);                         // c = 2 * a * b + c
+  *     auto d = cnt::matmul(cnt::permuted(b, {1, 0}), c);      // The transpose of 'b', without copying it
+  *
+  *     cnt::Container<float, 0, 0, 0> x(32, 64, 64), y(32, 64, 128);
+  *
+  *     auto z = cnt::matmul(x, y);                             // 32 x 64 x 128, a product per matrix
+  *
+  * The product is blocked like in BLIS and GotoBLAS. The columns of 'b' are taken by blocks of
+  * 'NC' and its rows by blocks of 'KC', which are packed so the block stays in the L3 cache and
+  * is read contiguously. For each block of 'MC' rows of 'a', packed to stay in the L2 cache,
+  * tiles of 'gemmRows x 2 * W' elements of the result are computed in registers by the vector
+  * kernels of 'Kernels.h', for the best instruction set of the processor. The blocks of rows of
+  * 'a' are split among the threads.
+  *
+  * Since the operands are always packed, they can have any strides: a 'Container' in row or
+  * column major order, a 'ContainerView', a 'Slice' or a 'StridedView', like a transpose made
+  * with 'permuted', are read directly.
+*/
+
+#ifndef CNT_GEMM_H
+#define CNT_GEMM_H
+
+#include "Strided.h"
+#include "Parallel.h"
+#include "Kernels.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+/// A matrix given by a pointer, its sizes and the strides of its rows and columns
+template <typename T>
+struct MatrixRef
+{
+    T* data;
+
+    std::size_t rows;
+
+    std::size_t cols;
+
+    std::size_t rowStride;
+
+    std::size_t colStride;
+
+
+    T& operator () (std::size_t i, std::size_t j) const { return data[i * rowStride + j * colStride]; }
+};
+
+
+
+/** The matrices of 'c', which has 2 dimensions or 3 for a stack of matrices. Throws
+  * 'std::invalid_argument' otherwise. The stride between matrices is returned in 'batchStride'.
+*/
+template <class C>
+auto matricesOf (C& c, std::size_t& batches, std::size_t& batchStride)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    const auto sizes = c.sizes();
+    const auto strides = c.strides();
+
+    const std::size_t n = sizes.size();
+
+    if(n != 2 && n != 3)
+        throw std::invalid_argument("The matrices must have 2 dimensions, or 3 for a stack of matrices");
+
+    batches = n == 3 ? sizes[0] : 1;
+    batchStride = n == 3 ? strides[0] : 0;
+
+    return MatrixRef<T>{ c.data(), sizes[n-2], sizes[n-1], strides[n-2], strides[n-1] };
+}
+
+
+
+/** Copies the rows '[i0, i0 + m)' and columns '[p0, p0 + k)' of 'a' to 'buffer' by panels of
+  * 'R' rows, each with the 'R' elements of a column together. The rows past 'm' are zeros.
+*/
+template <std::size_t R, typename T>
+void packPanels (const MatrixRef<const T>& a, std::size_t i0, std::size_t m, std::size_t p0, std::size_t k, T* buffer)
+{
+    for(std::size_t ir = 0; ir < m; ir += R, buffer += R * k)
+    {
+        const std::size_t rows = std::min(R, m - ir);
+
+        if(a.colStride <= a.rowStride)
+            for(std::size_t i = 0; i < R; ++i)
+                for(std::size_t p = 0; p < k; ++p)
+                    buffer[p * R + i] = i < rows ? a(i0 + ir + i, p0 + p) : T(0);
+
+        else
+            for(std::size_t p = 0; p < k; ++p)
+                for(std::size_t i = 0; i < R; ++i)
+                    buffer[p * R + i] = i < rows ? a(i0 + ir + i, p0 + p) : T(0);
+    }
+}
+
+
+/// The transpose of a matrix, swapping the strides
+template <typename T>
+MatrixRef<T> transposed (const MatrixRef<T>& a)
+{
+    return MatrixRef<T>{ a.data, a.cols, a.rows, a.colStride, a.rowStride };
+}
+
+
+
+/** 'c = alpha * a * b + beta * c' with the kernels of the instruction set 'Isa'. If 'beta' is
+  * 0, 'c' is not read, so it can have any value.
+*/
+template <class Isa, typename T>
+void gemmBlocked (T alpha, const MatrixRef<const T>& a, const MatrixRef<const T>& b, T beta, const MatrixRef<T>& c)
+{
+    constexpr std::size_t MR = simd::gemmRows, NR = 2 * Isa::template width<T>();
+
+    constexpr std::size_t KC = 256, MC = 20 * MR, NC = 2048;
+
+    const std::size_t m = c.rows, n = c.cols, k = a.cols;
+
+    if(!m || !n)
+        return;
+
+    if(!k)
+    {
+        for(std::size_t i = 0; i < m; ++i)
+            for(std::size_t j = 0; j < n; ++j)
+                c(i, j) = beta == T(0) ? T(0) : beta * c(i, j);
+
+        return;
+    }
+
+
+    auto& pool = ThreadPool::global();
+
+    const std::size_t kc = std::min(KC, k), nc = std::min(NC, (n + NR - 1) / NR * NR);
+
+    std::vector<T> packedB(kc * nc);
+
+    const auto bt = transposed(b);
+
+
+    for(std::size_t jc = 0; jc < n; jc += NC)
+    {
+        const std::size_t nb = std::min(NC, n - jc);
+
+        for(std::size_t pc = 0; pc < k; pc += KC)
+        {
+            const std::size_t kb = std::min(KC, k - pc);
+
+            /// Each tile starts from 'beta * c' in the first block of rows of 'b', and from 'c' in the others
+            const T scale = pc ? T(1) : beta;
+
+            packPanels<NR>(bt, jc, nb, pc, kb, packedB.data());
+
+
+            const std::size_t blocks = (m + MC - 1) / MC;
+
+            pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last){
+                std::vector<T> packedA(MC * kb);
+
+                alignas(64) T tile[MR * NR];
+
+                for(std::size_t ib = first; ib < last; ++ib)
+                {
+                    const std::size_t ic = ib * MC, mb = std::min(MC, m - ic);
+
+                    packPanels<MR>(a, ic, mb, pc, kb, packedA.data());
+
+                    for(std::size_t jr = 0; jr < nb; jr += NR)
+                        for(std::size_t ir = 0; ir < mb; ir += MR)
+                        {
+                            Isa::gemm(kb, packedA.data() + ir * kb, packedB.data() + jr * kb, tile);
+
+                            const std::size_t rows = std::min(MR, mb - ir), cols = std::min(NR, nb - jr);
+
+                            T* q = &c(ic + ir, jc + jr);
+
+                            for(std::size_t i = 0; i < rows; ++i)
+                                for(std::size_t j = 0; j < cols; ++j)
+                                {
+                                    T& x = q[i * c.rowStride + j * c.colStride];
+
+                                    x = alpha * tile[i * NR + j] + (scale == T(0) ? T(0) : scale * x);
+                                }
+                        }
+                }
+            });
+        }
+    }
+}
+
+
+} // namespace help
+
+
+
+/** 'c = alpha * a * b + beta * c'. The operands have 2 dimensions, or 3 for stacks of matrices
+  * with the same number of matrices, each one multiplied separately. 'c' must not share
+  * elements with 'a' or 'b', and if 'beta' is 0 its elements are not read. Throws
+  * 'std::invalid_argument' if the number of dimensions or the sizes do not match.
+*/
+template <class A, class B, class C>
+void gemm (const typename std::decay_t<C>::value_type& alpha, const A& a, const B& b,
+           const typename std::decay_t<C>::value_type& beta, C&& c)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    static_assert(std::is_same<std::remove_const_t<std::remove_pointer_t<decltype(a.data())>>, T>::value &&
+                  std::is_same<std::remove_const_t<std::remove_pointer_t<decltype(b.data())>>, T>::value,
+                  "The types of the elements must be the same");
+
+
+    std::size_t batchesA, batchesB, batchesC, strideA, strideB, strideC;
+
+    const auto x = help::matricesOf(a, batchesA, strideA);
+    const auto y = help::matricesOf(b, batchesB, strideB);
+    const auto z = help::matricesOf(c, batchesC, strideC);
+
+    if(a.sizes().size() != c.sizes().size() || b.sizes().size() != c.sizes().size() ||
+       batchesA != batchesC || batchesB != batchesC || x.cols != y.rows || x.rows != z.rows || y.cols != z.cols)
+        throw std::invalid_argument("The sizes of the matrices do not match");
+
+
+    help::simd::dispatch([&](auto isa){
+        using Isa = decltype(isa);
+
+        /// The matrices run in parallel, and each one splits its blocks of rows among the threads
+        ThreadPool::global().parallelFor(0, batchesC, 1, [&](std::size_t first, std::size_t last){
+            for(std::size_t t = first; t < last; ++t)
+            {
+                const help::MatrixRef<const T> u{ x.data + t * strideA, x.rows, x.cols, x.rowStride, x.colStride };
+                const help::MatrixRef<const T> v{ y.data + t * strideB, y.rows, y.cols, y.rowStride, y.colStride };
+                const help::MatrixRef<T> w{ z.data + t * strideC, z.rows, z.cols, z.rowStride, z.colStride };
+
+                help::gemmBlocked<Isa>(T(alpha), u, v, T(beta), w);
+            }
+        });
+    });
+}
+
+
+
+/** The product of 'a' and 'b', as 'gemm(1, a, b, 0, c)'. The result is a new row major
+  * container with 2 dimensions, or 3 for stacks of matrices. Its number of dimensions is fixed
+  * if the one of 'a' is.
+*/
+//@{
+template <class A, class B, class C>
+void matmul (const A& a, const B& b, C&& c)
+{
+    using T = typename std::decay_t<C>::value_type;
+
+    gemm(T(1), a, b, T(0), std::forward<C>(c));
+}
+
+
+template <class A, class B>
+auto matmul (const A& a, const B& b)
+{
+    using T = std::remove_const_t<std::remove_pointer_t<decltype(a.data())>>;
+
+    constexpr std::size_t N = help::staticRank<std::decay_t<A>>;
+
+    using Result = std::conditional_t<N == 0, Container<T>, BasicContainer<T, help::ZeroShape<N ? N : 2>>>;
+
+
+    const auto sa = a.sizes();
+    const auto sb = b.sizes();
+
+    if(sa.size() != sb.size() || sa.size() < 2)
+        throw std::invalid_argument("The sizes of the matrices do not match");
+
+    std::vector<std::size_t> sizes(sa.begin(), sa.end());
+
+    sizes.back() = sb[sb.size() - 1];
+
+
+    Result c(uninitialized, sizes.begin(), sizes.end());
+
+    matmul(a, b, c);
+
+    return c;
+}
+//@}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_GEMM_H
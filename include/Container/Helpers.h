@@ -10,6 +10,8 @@
 #include <vector>
 #include <array>
 #include <initializer_list>
+#include <memory>
+#include <stdexcept>
 
 
 
@@ -126,9 +128,11 @@ constexpr bool isVector = !isArray< N >;
 //@}
 
 
-/// Selects either a 'std::array<T, N>' or a 'std::vector<T>' depending on the size 'N'
-template <typename T, std::size_t N>
-using SelectType = std::conditional_t<help::isArray<N>, std::array<T, N>, std::vector<T>>;
+/** Selects either a 'std::array<T, N>' or a 'std::vector<T, Alloc>' depending on the size 'N'.
+  * The allocator is only used by the 'std::vector'.
+*/
+template <typename T, std::size_t N, class Alloc = std::allocator<T>>
+using SelectType = std::conditional_t<help::isArray<N>, std::array<T, N>, std::vector<T, Alloc>>;
 
 
 
@@ -216,6 +220,42 @@ struct IteratorType {};
 //@}
 
 
+
+
+/** Tells if the elements of 'c' are contiguous in memory. Only strided views may not be. */
+//@{
+template <class C>
+auto contiguous (const C& c, int) -> decltype(c.contiguous()) { return c.contiguous(); }
+
+template <class C>
+bool contiguous (const C&, long) { return true; }
+//@}
+
+
+/** Pointer to the first element of 'c', or 'nullptr' if it is empty. The elements must be
+  * contiguous, like in a 'Container', a 'Slice' or a 'ContainerView'.
+*/
+//@{
+template <class C>
+auto constData (const C& c)
+{
+	if(!contiguous(c, 0))
+		throw std::invalid_argument("The elements must be contiguous");
+
+	return c.size() ? &*c.cbegin() : nullptr;
+}
+
+template <class C>
+auto mutableData (C& c)
+{
+	if(!contiguous(c, 0))
+		throw std::invalid_argument("The elements must be contiguous");
+
+	return c.size() ? &*c.begin() : nullptr;
+}
+//@}
+
+
 }   // namespace help
 
 }
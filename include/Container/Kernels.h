@@ -0,0 +1,900 @@
+/** \file Kernels.h
+  *
+  * Vectorized reductions and elementwise kernels over the contiguous elements of a 'Container',
+  * a 'Slice' or a 'ContainerView':
+  *
+  *     cnt::Container<float> a(100, 100), b(100, 100);
+  *
+  *     float s = cnt::sum(a.slice(3));     // Only the elements of the slice
+  *     float d = cnt::dot(a, b);
+  *     cnt::axpy(2.0f, a, b);              // b = 2 * a + b
+  *
+  * For 'float', 'double' and 'int' there are explicit SSE 4.1, AVX2 and AVX-512 versions, and
+  * the best one supported by the processor is chosen at runtime. Other types, compilers other
+  * than GCC or other architectures use the scalar version. The reductions use several
+  * independent accumulators, so the floating point results may differ from a sequential
+  * 'std::accumulate' in the last bits.
+*/
+
+#ifndef CNT_KERNELS_H
+#define CNT_KERNELS_H
+
+#include <cmath>
+#include <stdexcept>
+
+#include "Container.h"
+
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+    #define CNT_KERNELS_X86
+    #include <immintrin.h>
+#endif
+
+
+
+namespace cnt
+{
+
+
+/** Instruction sets of the kernels, from the slowest to the fastest */
+enum class Isa { Scalar, SSE, AVX2, AVX512 };
+
+
+/// The best instruction set supported by the processor
+inline Isa bestIsa ()
+{
+#ifdef CNT_KERNELS_X86
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx512f"))
+        return Isa::AVX512;
+
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return Isa::AVX2;
+
+    if(__builtin_cpu_supports("sse4.1"))
+        return Isa::SSE;
+#endif
+
+    return Isa::Scalar;
+}
+
+
+/** The instruction set used by the kernels. It starts as 'bestIsa()', and can be set to a
+  * slower one, like in 'cnt::activeIsa() = cnt::Isa::Scalar'. Setting an instruction set not
+  * supported by the processor is undefined behavior.
+*/
+inline Isa& activeIsa ()
+{
+    static Isa isa = bestIsa();
+
+    return isa;
+}
+
+
+
+
+namespace help
+{
+
+namespace simd
+{
+
+
+/** The scalar operations, with the same interface as the vector ones below. It is also the
+  * fallback for the types without a vector version.
+*/
+template <typename T>
+struct Scalar
+{
+    using Type = T;
+
+    using Reg = T;
+
+    static constexpr std::size_t Width = 1;
+
+
+    static Reg set (T x) { return x; }
+
+    static Reg load (const T* p) { return *p; }
+
+    static void store (T* p, Reg a) { *p = a; }
+
+    static Reg add (Reg a, Reg b) { return a + b; }
+
+    static Reg mul (Reg a, Reg b) { return a * b; }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return a * b + c; }
+
+    static Reg min (Reg a, Reg b) { return b < a ? b : a; }
+
+    static Reg max (Reg a, Reg b) { return a < b ? b : a; }
+};
+
+
+
+
+
+
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+
+/** The reductions, both between registers of 'V' (given as a pointer to the function of 'V', so
+  * no function outside the targets of the instruction sets takes a register) and between scalars
+*/
+//@{
+struct Add
+{
+    template <class V>
+    static constexpr auto vector () { return &V::add; }
+
+    template <typename T>
+    static T apply (T a, T b) { return a + b; }
+};
+
+struct Smaller
+{
+    template <class V>
+    static constexpr auto vector () { return &V::min; }
+
+    template <typename T>
+    static T apply (T a, T b) { return b < a ? b : a; }
+};
+
+struct Greater
+{
+    template <class V>
+    static constexpr auto vector () { return &V::max; }
+
+    template <typename T>
+    static T apply (T a, T b) { return a < b ? b : a; }
+};
+//@}
+
+
+
+/// Number of rows of the tiles of the matrix product. See 'gemm'.
+constexpr std::size_t gemmRows = 6;
+
+
+
+/** The kernels, written once for any set of operations 'V'. They are always inlined into the
+  * entry points of each instruction set below, so they are compiled for that target. The
+  * loops use four registers as independent accumulators to hide the latency of the operations.
+*/
+//@{
+template <class V, class Op>
+__attribute__((always_inline)) inline typename V::Type
+reduce (const typename V::Type* p, std::size_t n, typename V::Type init)
+{
+    using T = typename V::Type;
+    constexpr std::size_t W = V::Width;
+
+    constexpr auto op = Op::template vector<V>();
+
+    auto a0 = V::set(init), a1 = a0, a2 = a0, a3 = a0;
+
+    std::size_t i = 0;
+
+    for(; i + 4 * W <= n; i += 4 * W)
+    {
+        a0 = op(a0, V::load(p + i));
+        a1 = op(a1, V::load(p + i + W));
+        a2 = op(a2, V::load(p + i + 2 * W));
+        a3 = op(a3, V::load(p + i + 3 * W));
+    }
+
+    for(const std::size_t body = n - n % W; i < body; i += W)
+        a0 = op(a0, V::load(p + i));
+
+
+    T buffer[W];
+
+    V::store(buffer, op(op(a0, a1), op(a2, a3)));
+
+    T r = buffer[0];
+
+    for(std::size_t j = 1; j < W; ++j)
+        r = Op::apply(r, buffer[j]);
+
+    for(; i < n; ++i)
+        r = Op::apply(r, p[i]);
+
+    return r;
+}
+
+
+template <class V>
+__attribute__((always_inline)) inline typename V::Type
+dot (const typename V::Type* p, const typename V::Type* q, std::size_t n)
+{
+    using T = typename V::Type;
+    constexpr std::size_t W = V::Width;
+
+    auto a0 = V::set(T(0)), a1 = a0, a2 = a0, a3 = a0;
+
+    std::size_t i = 0;
+
+    for(; i + 4 * W <= n; i += 4 * W)
+    {
+        a0 = V::fma(V::load(p + i), V::load(q + i), a0);
+        a1 = V::fma(V::load(p + i + W), V::load(q + i + W), a1);
+        a2 = V::fma(V::load(p + i + 2 * W), V::load(q + i + 2 * W), a2);
+        a3 = V::fma(V::load(p + i + 3 * W), V::load(q + i + 3 * W), a3);
+    }
+
+    for(const std::size_t body = n - n % W; i < body; i += W)
+        a0 = V::fma(V::load(p + i), V::load(q + i), a0);
+
+
+    T buffer[W];
+
+    V::store(buffer, V::add(V::add(a0, a1), V::add(a2, a3)));
+
+    T r = buffer[0];
+
+    for(std::size_t j = 1; j < W; ++j)
+        r += buffer[j];
+
+    for(; i < n; ++i)
+        r += p[i] * q[i];
+
+    return r;
+}
+
+
+template <class V>
+__attribute__((always_inline)) inline void
+axpy (typename V::Type alpha, const typename V::Type* x, typename V::Type* y, std::size_t n)
+{
+    constexpr std::size_t W = V::Width;
+
+    const auto a = V::set(alpha);
+
+    std::size_t i = 0;
+
+    for(const std::size_t body = n - n % W; i < body; i += W)
+        V::store(y + i, V::fma(a, V::load(x + i), V::load(y + i)));
+
+    for(; i < n; ++i)
+        y[i] = alpha * x[i] + y[i];
+}
+
+
+template <class V>
+__attribute__((always_inline)) inline void
+fill (typename V::Type* p, std::size_t n, typename V::Type x)
+{
+    constexpr std::size_t W = V::Width;
+
+    const auto a = V::set(x);
+
+    std::size_t i = 0;
+
+    for(const std::size_t body = n - n % W; i < body; i += W)
+        V::store(p + i, a);
+
+    for(; i < n; ++i)
+        p[i] = x;
+}
+
+
+/** The tile of 'gemmRows x 2 * V::Width' elements of the product of the packed panels 'a' and
+  * 'b' of 'k' columns, stored in row major order to 'c'. In each column of 'a' there are
+  * 'gemmRows' elements, and in each row of 'b' two registers of elements. The tile is kept in
+  * 'gemmRows * 2' registers, and each step loads the two registers of 'b' and broadcasts each
+  * element of 'a', so there are two loads from memory for each 'gemmRows' updates.
+*/
+template <class V>
+__attribute__((always_inline)) inline void
+gemm (std::size_t k, const typename V::Type* a, const typename V::Type* b, typename V::Type* c)
+{
+    using T = typename V::Type;
+    constexpr std::size_t W = V::Width, R = gemmRows;
+
+    typename V::Reg c0[R], c1[R];
+
+    for(std::size_t i = 0; i < R; ++i)
+        c0[i] = c1[i] = V::set(T(0));
+
+    for(std::size_t p = 0; p < k; ++p, a += R, b += 2 * W)
+    {
+        const auto b0 = V::load(b), b1 = V::load(b + W);
+
+        for(std::size_t i = 0; i < R; ++i)
+        {
+            const auto x = V::set(a[i]);
+
+            c0[i] = V::fma(x, b0, c0[i]);
+            c1[i] = V::fma(x, b1, c1[i]);
+        }
+    }
+
+    for(std::size_t i = 0; i < R; ++i)
+    {
+        V::store(c + 2 * W * i, c0[i]);
+        V::store(c + 2 * W * i + W, c1[i]);
+    }
+}
+//@}
+
+
+#pragma GCC diagnostic pop
+
+
+
+
+/** The entry points of the scalar version. Each instruction set has a struct like this one,
+  * with its operations for the type 'T' given by 'Pack<T>'.
+*/
+struct ScalarIsa
+{
+    template <typename T>
+    static T sum (const T* p, std::size_t n) { return reduce<Scalar<T>, Add>(p, n, T(0)); }
+
+    template <typename T>
+    static T min (const T* p, std::size_t n) { return reduce<Scalar<T>, Smaller>(p, n, p[0]); }
+
+    template <typename T>
+    static T max (const T* p, std::size_t n) { return reduce<Scalar<T>, Greater>(p, n, p[0]); }
+
+    template <typename T>
+    static T dot (const T* p, const T* q, std::size_t n) { return simd::dot<Scalar<T>>(p, q, n); }
+
+    template <typename T>
+    static void axpy (T alpha, const T* x, T* y, std::size_t n) { simd::axpy<Scalar<T>>(alpha, x, y, n); }
+
+    template <typename T>
+    static void fill (T* p, std::size_t n, T x) { simd::fill<Scalar<T>>(p, n, x); }
+
+    template <typename T>
+    static void gemm (std::size_t k, const T* a, const T* b, T* c) { simd::gemm<Scalar<T>>(k, a, b, c); }
+
+    /// Number of elements in a register
+    template <typename T>
+    static constexpr std::size_t width () { return Scalar<T>::Width; }
+};
+
+
+
+#ifdef CNT_KERNELS_X86
+
+
+// ------------------------------------- SSE 4.1 ---------------------------------------------- //
+
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+
+namespace sse
+{
+
+template <typename T>
+struct Pack : Scalar<T> {};
+
+
+template <>
+struct Pack<float>
+{
+    using Type = float;
+
+    using Reg = __m128;
+
+    static constexpr std::size_t Width = 4;
+
+
+    static Reg set (float x) { return _mm_set1_ps(x); }
+
+    static Reg load (const float* p) { return _mm_loadu_ps(p); }
+
+    static void store (float* p, Reg a) { _mm_storeu_ps(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm_add_ps(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm_mul_ps(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    static Reg min (Reg a, Reg b) { return _mm_min_ps(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm_max_ps(a, b); }
+};
+
+
+template <>
+struct Pack<double>
+{
+    using Type = double;
+
+    using Reg = __m128d;
+
+    static constexpr std::size_t Width = 2;
+
+
+    static Reg set (double x) { return _mm_set1_pd(x); }
+
+    static Reg load (const double* p) { return _mm_loadu_pd(p); }
+
+    static void store (double* p, Reg a) { _mm_storeu_pd(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm_add_pd(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm_mul_pd(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+    static Reg min (Reg a, Reg b) { return _mm_min_pd(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm_max_pd(a, b); }
+};
+
+
+template <>
+struct Pack<int>
+{
+    using Type = int;
+
+    using Reg = __m128i;
+
+    static constexpr std::size_t Width = 4;
+
+
+    static Reg set (int x) { return _mm_set1_epi32(x); }
+
+    static Reg load (const int* p) { return _mm_loadu_si128(reinterpret_cast<const Reg*>(p)); }
+
+    static void store (int* p, Reg a) { _mm_storeu_si128(reinterpret_cast<Reg*>(p), a); }
+
+    static Reg add (Reg a, Reg b) { return _mm_add_epi32(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm_mullo_epi32(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm_add_epi32(_mm_mullo_epi32(a, b), c); }
+
+    static Reg min (Reg a, Reg b) { return _mm_min_epi32(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm_max_epi32(a, b); }
+};
+
+} // namespace sse
+
+
+struct Sse
+{
+    template <typename T>
+    static T sum (const T* p, std::size_t n) { return reduce<sse::Pack<T>, Add>(p, n, T(0)); }
+
+    template <typename T>
+    static T min (const T* p, std::size_t n) { return reduce<sse::Pack<T>, Smaller>(p, n, p[0]); }
+
+    template <typename T>
+    static T max (const T* p, std::size_t n) { return reduce<sse::Pack<T>, Greater>(p, n, p[0]); }
+
+    template <typename T>
+    static T dot (const T* p, const T* q, std::size_t n) { return simd::dot<sse::Pack<T>>(p, q, n); }
+
+    template <typename T>
+    static void axpy (T alpha, const T* x, T* y, std::size_t n) { simd::axpy<sse::Pack<T>>(alpha, x, y, n); }
+
+    template <typename T>
+    static void fill (T* p, std::size_t n, T x) { simd::fill<sse::Pack<T>>(p, n, x); }
+
+    template <typename T>
+    static void gemm (std::size_t k, const T* a, const T* b, T* c) { simd::gemm<sse::Pack<T>>(k, a, b, c); }
+
+    /// Number of elements in a register
+    template <typename T>
+    static constexpr std::size_t width () { return sse::Pack<T>::Width; }
+};
+
+#pragma GCC pop_options
+
+
+
+// --------------------------------------- AVX2 ----------------------------------------------- //
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+namespace avx2
+{
+
+template <typename T>
+struct Pack : Scalar<T> {};
+
+
+template <>
+struct Pack<float>
+{
+    using Type = float;
+
+    using Reg = __m256;
+
+    static constexpr std::size_t Width = 8;
+
+
+    static Reg set (float x) { return _mm256_set1_ps(x); }
+
+    static Reg load (const float* p) { return _mm256_loadu_ps(p); }
+
+    static void store (float* p, Reg a) { _mm256_storeu_ps(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm256_add_ps(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+
+    static Reg min (Reg a, Reg b) { return _mm256_min_ps(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm256_max_ps(a, b); }
+};
+
+
+template <>
+struct Pack<double>
+{
+    using Type = double;
+
+    using Reg = __m256d;
+
+    static constexpr std::size_t Width = 4;
+
+
+    static Reg set (double x) { return _mm256_set1_pd(x); }
+
+    static Reg load (const double* p) { return _mm256_loadu_pd(p); }
+
+    static void store (double* p, Reg a) { _mm256_storeu_pd(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm256_add_pd(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm256_fmadd_pd(a, b, c); }
+
+    static Reg min (Reg a, Reg b) { return _mm256_min_pd(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm256_max_pd(a, b); }
+};
+
+
+template <>
+struct Pack<int>
+{
+    using Type = int;
+
+    using Reg = __m256i;
+
+    static constexpr std::size_t Width = 8;
+
+
+    static Reg set (int x) { return _mm256_set1_epi32(x); }
+
+    static Reg load (const int* p) { return _mm256_loadu_si256(reinterpret_cast<const Reg*>(p)); }
+
+    static void store (int* p, Reg a) { _mm256_storeu_si256(reinterpret_cast<Reg*>(p), a); }
+
+    static Reg add (Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm256_mullo_epi32(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+
+    static Reg min (Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+};
+
+} // namespace avx2
+
+
+struct Avx2
+{
+    template <typename T>
+    static T sum (const T* p, std::size_t n) { return reduce<avx2::Pack<T>, Add>(p, n, T(0)); }
+
+    template <typename T>
+    static T min (const T* p, std::size_t n) { return reduce<avx2::Pack<T>, Smaller>(p, n, p[0]); }
+
+    template <typename T>
+    static T max (const T* p, std::size_t n) { return reduce<avx2::Pack<T>, Greater>(p, n, p[0]); }
+
+    template <typename T>
+    static T dot (const T* p, const T* q, std::size_t n) { return simd::dot<avx2::Pack<T>>(p, q, n); }
+
+    template <typename T>
+    static void axpy (T alpha, const T* x, T* y, std::size_t n) { simd::axpy<avx2::Pack<T>>(alpha, x, y, n); }
+
+    template <typename T>
+    static void fill (T* p, std::size_t n, T x) { simd::fill<avx2::Pack<T>>(p, n, x); }
+
+    template <typename T>
+    static void gemm (std::size_t k, const T* a, const T* b, T* c) { simd::gemm<avx2::Pack<T>>(k, a, b, c); }
+
+    /// Number of elements in a register
+    template <typename T>
+    static constexpr std::size_t width () { return avx2::Pack<T>::Width; }
+};
+
+#pragma GCC pop_options
+
+
+
+// -------------------------------------- AVX-512 --------------------------------------------- //
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+/** The unmasked 'min' and 'max' of AVX-512 trigger a false '-Wuninitialized' in GCC, so they
+  * are written as the masked versions with every lane enabled.
+*/
+namespace avx512
+{
+
+template <typename T>
+struct Pack : Scalar<T> {};
+
+
+template <>
+struct Pack<float>
+{
+    using Type = float;
+
+    using Reg = __m512;
+
+    static constexpr std::size_t Width = 16;
+
+
+    static Reg set (float x) { return _mm512_set1_ps(x); }
+
+    static Reg load (const float* p) { return _mm512_loadu_ps(p); }
+
+    static void store (float* p, Reg a) { _mm512_storeu_ps(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm512_add_ps(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm512_fmadd_ps(a, b, c); }
+
+    static Reg min (Reg a, Reg b) { return _mm512_maskz_min_ps(__mmask16(-1), a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm512_maskz_max_ps(__mmask16(-1), a, b); }
+};
+
+
+template <>
+struct Pack<double>
+{
+    using Type = double;
+
+    using Reg = __m512d;
+
+    static constexpr std::size_t Width = 8;
+
+
+    static Reg set (double x) { return _mm512_set1_pd(x); }
+
+    static Reg load (const double* p) { return _mm512_loadu_pd(p); }
+
+    static void store (double* p, Reg a) { _mm512_storeu_pd(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm512_add_pd(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm512_mul_pd(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm512_fmadd_pd(a, b, c); }
+
+    static Reg min (Reg a, Reg b) { return _mm512_maskz_min_pd(__mmask8(-1), a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm512_maskz_max_pd(__mmask8(-1), a, b); }
+};
+
+
+template <>
+struct Pack<int>
+{
+    using Type = int;
+
+    using Reg = __m512i;
+
+    static constexpr std::size_t Width = 16;
+
+
+    static Reg set (int x) { return _mm512_set1_epi32(x); }
+
+    static Reg load (const int* p) { return _mm512_loadu_si512(p); }
+
+    static void store (int* p, Reg a) { _mm512_storeu_si512(p, a); }
+
+    static Reg add (Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+
+    static Reg mul (Reg a, Reg b) { return _mm512_mullo_epi32(a, b); }
+
+    static Reg fma (Reg a, Reg b, Reg c) { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+
+    static Reg min (Reg a, Reg b) { return _mm512_maskz_min_epi32(__mmask16(-1), a, b); }
+
+    static Reg max (Reg a, Reg b) { return _mm512_maskz_max_epi32(__mmask16(-1), a, b); }
+};
+
+} // namespace avx512
+
+
+struct Avx512
+{
+    template <typename T>
+    static T sum (const T* p, std::size_t n) { return reduce<avx512::Pack<T>, Add>(p, n, T(0)); }
+
+    template <typename T>
+    static T min (const T* p, std::size_t n) { return reduce<avx512::Pack<T>, Smaller>(p, n, p[0]); }
+
+    template <typename T>
+    static T max (const T* p, std::size_t n) { return reduce<avx512::Pack<T>, Greater>(p, n, p[0]); }
+
+    template <typename T>
+    static T dot (const T* p, const T* q, std::size_t n) { return simd::dot<avx512::Pack<T>>(p, q, n); }
+
+    template <typename T>
+    static void axpy (T alpha, const T* x, T* y, std::size_t n) { simd::axpy<avx512::Pack<T>>(alpha, x, y, n); }
+
+    template <typename T>
+    static void fill (T* p, std::size_t n, T x) { simd::fill<avx512::Pack<T>>(p, n, x); }
+
+    template <typename T>
+    static void gemm (std::size_t k, const T* a, const T* b, T* c) { simd::gemm<avx512::Pack<T>>(k, a, b, c); }
+
+    /// Number of elements in a register
+    template <typename T>
+    static constexpr std::size_t width () { return avx512::Pack<T>::Width; }
+};
+
+#pragma GCC pop_options
+
+
+#endif // CNT_KERNELS_X86
+
+
+
+
+/** Calls 'f' with the entry points of the active instruction set */
+template <class F>
+decltype(auto) dispatch (F f)
+{
+    switch(activeIsa())
+    {
+#ifdef CNT_KERNELS_X86
+        case Isa::AVX512: return f(Avx512{});
+
+        case Isa::AVX2:   return f(Avx2{});
+
+        case Isa::SSE:    return f(Sse{});
+#endif
+
+        default:          return f(ScalarIsa{});
+    }
+}
+
+
+} // namespace simd
+
+} // namespace help
+
+
+
+
+/** Reductions over the elements of a 'Container', a 'Slice', a 'ContainerView' or a contiguous
+  * 'StridedView'. The minimum and maximum of an empty range throw 'std::invalid_argument'.
+*/
+//@{
+template <class C>
+auto sum (const C& c)
+{
+    const auto* p = help::constData(c);
+    const std::size_t n = c.size();
+
+    return help::simd::dispatch([&](auto isa){ return decltype(isa)::sum(p, n); });
+}
+
+
+template <class C>
+auto min (const C& c)
+{
+    const auto* p = help::constData(c);
+    const std::size_t n = c.size();
+
+    if(!n)
+        throw std::invalid_argument("The minimum of an empty range is not defined");
+
+    return help::simd::dispatch([&](auto isa){ return decltype(isa)::min(p, n); });
+}
+
+
+template <class C>
+auto max (const C& c)
+{
+    const auto* p = help::constData(c);
+    const std::size_t n = c.size();
+
+    if(!n)
+        throw std::invalid_argument("The maximum of an empty range is not defined");
+
+    return help::simd::dispatch([&](auto isa){ return decltype(isa)::max(p, n); });
+}
+
+
+/// Sum of the products of the elements of 'a' and 'b', which must have the same size
+template <class A, class B>
+auto dot (const A& a, const B& b)
+{
+    const auto* p = help::constData(a);
+    const auto* q = help::constData(b);
+    const std::size_t n = a.size();
+
+    static_assert(std::is_same<decltype(p), decltype(q)>::value, "The types of the elements must be the same");
+
+    static_assert(std::is_same<help::LayoutOf<A>, help::LayoutOf<B>>::value, "The layouts of the containers are different");
+
+    if(b.size() != n)
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    return help::simd::dispatch([&](auto isa){ return decltype(isa)::dot(p, q, n); });
+}
+
+
+/// Euclidean norm. It is a 'double' for integral elements
+template <class C>
+auto norm (const C& c)
+{
+    using std::sqrt;
+
+    return sqrt(dot(c, c));
+}
+//@}
+
+
+
+/** Elementwise kernels. The destination can be a temporary, like 'cnt::fill(c.slice(2), 0)'. */
+//@{
+
+/// 'y = alpha * x + y', for 'x' and 'y' of the same size
+template <class X, class Y>
+void axpy (const typename std::decay_t<X>::value_type& alpha, const X& x, Y&& y)
+{
+    const auto* p = help::constData(x);
+    auto* q = help::mutableData(y);
+    const std::size_t n = x.size();
+
+    static_assert(std::is_same<std::remove_const_t<std::remove_pointer_t<decltype(p)>>,
+                               std::remove_pointer_t<decltype(q)>>::value, "The types of the elements must be the same");
+
+    static_assert(std::is_same<help::LayoutOf<X>, help::LayoutOf<Y>>::value, "The layouts of the containers are different");
+
+    if(y.size() != n)
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    const std::remove_pointer_t<decltype(q)> a = alpha;
+
+    help::simd::dispatch([&](auto isa){ decltype(isa)::axpy(a, p, q, n); });
+}
+
+
+/// Sets every element of 'c' to 'x'
+template <class C>
+void fill (C&& c, const typename std::decay_t<C>::value_type& x)
+{
+    auto* p = help::mutableData(c);
+    const std::size_t n = c.size();
+
+    help::simd::dispatch([&](auto isa){ decltype(isa)::fill(p, n, x); });
+}
+//@}
+
+
+} // namespace cnt
+
+
+#endif // CNT_KERNELS_H
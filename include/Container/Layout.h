@@ -0,0 +1,321 @@
+/** \file Layout.h
+  *
+  * Policies for the order of the elements of a 'Container' in memory. The default is row major
+  * order, where the last dimension is contiguous. The others are given as the last template
+  * parameter of 'BasicContainer':
+  *
+  *     cnt::BasicContainer<float, cnt::Shape<0, 0>, std::allocator<float>, cnt::Tiled<8, 8>> c(512, 512);
+  *
+  * Every layout maps the index of each dimension independently, and the position of an element
+  * is the sum of these maps. So 'operator()' and 'slice()' work the same for every layout, and
+  * 'begin()' and 'end()' traverse the elements in the order they are in memory.
+*/
+
+#ifndef CNT_LAYOUT_H
+#define CNT_LAYOUT_H
+
+#include <array>
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <functional>
+
+#include "Helpers.h"
+
+
+namespace cnt
+{
+
+
+/// Row major order: the last dimension is contiguous
+struct RowMajor {};
+
+
+/// Column major order: the first dimension is contiguous
+struct ColumnMajor {};
+
+
+/** Blocked order: the elements are grouped in tiles of sizes 'Ts', one for each dimension, like
+  * 'Tiled<8, 8>' or 'Tiled<4, 4, 4>'. The tiles are in row major order, and so are the elements
+  * inside each tile. The size of each dimension must be a multiple of the size of its tiles.
+*/
+template <std::size_t... Ts>
+struct Tiled {};
+
+
+/** Z order: the bits of the indices of each dimension are interleaved, so elements close in any
+  * dimension are close in memory at every scale. The size of each dimension must be a power of 2.
+*/
+struct Morton {};
+
+
+
+
+namespace help
+{
+
+
+/// The layout of 'C', given by its 'Layout' type, or 'RowMajor' if it has none
+//@{
+template <class C>
+typename C::Layout layoutOf (int);
+
+template <class C>
+RowMajor layoutOf (long);
+
+template <class C>
+using LayoutOf = decltype(layoutOf<std::decay_t<C>>(0));
+//@}
+
+
+template <class L>
+constexpr bool isRowMajor = std::is_same_v<L, RowMajor>;
+
+
+
+/// A table with one entry per dimension, fixed if the number of dimensions 'Rank' is known
+//@{
+template <std::size_t Rank>
+using DimTable = std::conditional_t<(Rank > 0), std::array<std::size_t, Rank>, std::vector<std::size_t>>;
+
+template <std::size_t Rank>
+void resizeTable (std::array<std::size_t, Rank>&, std::size_t) {}
+
+inline void resizeTable (std::vector<std::size_t>& table, std::size_t n) { table.resize(n); }
+//@}
+
+
+
+
+/** The map of the index of each dimension to its part of the position of an element. 'Rank'
+  * is the number of dimensions, or '0' if it is known only at runtime. Each map has:
+  *
+  *   - 'init(sizes)', called by the container after its sizes are known.
+  *   - 'map<K>(x)' and 'map(k, x)', the part of the position for the index 'x' of the dimension 'k'.
+  *   - 'strided', telling if the map is 'x * strides()[k]'.
+  *
+  * The row major map is empty, as it uses the weights of 'Dimensions'.
+*/
+template <class L, std::size_t Rank>
+struct LayoutMap;
+
+
+template <std::size_t Rank>
+struct LayoutMap<RowMajor, Rank>
+{
+    static constexpr bool strided = true;
+
+    template <class Sizes>
+    void init (const Sizes&) {}
+};
+
+
+
+template <std::size_t Rank>
+struct LayoutMap<ColumnMajor, Rank>
+{
+    static constexpr bool strided = true;
+
+
+    template <class Sizes>
+    void init (const Sizes& sizes)
+    {
+        resizeTable(weights, sizes.size());
+
+        if(!sizes.size())
+            return;
+
+        weights.front() = 1;
+
+        std::partial_sum(sizes.begin(), sizes.end() - 1, weights.begin() + 1, std::multiplies<std::size_t>());
+    }
+
+
+    template <std::size_t K>
+    std::size_t map (std::size_t x) const { return weights[K] * x; }
+
+    std::size_t map (std::size_t k, std::size_t x) const { return weights[k] * x; }
+
+
+    DimTable<Rank> weights;     /// The strides, increasing from the first dimension
+};
+
+
+
+template <std::size_t... Ts, std::size_t Rank>
+struct LayoutMap<Tiled<Ts...>, Rank>
+{
+    static_assert(!Rank || Rank == sizeof...(Ts), "There must be a tile size for each dimension");
+
+    static_assert(And_v<(Ts > 0)...>, "The tile sizes must be positive");
+
+
+    static constexpr bool strided = false;
+
+    static constexpr std::size_t N = sizeof...(Ts);
+
+
+    /// The tile size of the dimension 'k'
+    static constexpr std::size_t tile (std::size_t k)
+    {
+        const std::size_t ts[] = { Ts... };
+
+        return ts[k];
+    }
+
+
+    /** The tiles are in row major order over the grid of tiles, and the elements of a tile are
+      * in row major order inside it. So the index 'x' contributes '(x / t) * outer + (x % t) * inner'.
+    */
+    template <class Sizes>
+    void init (const Sizes& sizes)
+    {
+        if(sizes.size() != N)
+            throw std::invalid_argument("There must be a tile size for each dimension");
+
+        for(std::size_t k = 0; k < N; ++k)
+            if(sizes[k] % tile(k))
+                throw std::invalid_argument("The sizes must be multiples of the tile sizes");
+
+
+        const std::size_t volume = multiply_v<Ts...>;
+
+        std::size_t grid = 1, inside = 1;
+
+        for(std::size_t k = N; k-- > 0;)
+        {
+            outer[k] = grid * volume;
+            inner[k] = inside;
+
+            grid *= sizes[k] / tile(k);
+            inside *= tile(k);
+        }
+    }
+
+
+    template <std::size_t K>
+    std::size_t map (std::size_t x) const
+    {
+        constexpr std::size_t t = tile(K);
+
+        return (x / t) * outer[K] + (x % t) * inner[K];
+    }
+
+    std::size_t map (std::size_t k, std::size_t x) const
+    {
+        return (x / tile(k)) * outer[k] + (x % tile(k)) * inner[k];
+    }
+
+
+    std::array<std::size_t, N> outer;   /// Distance between consecutive tiles of each dimension
+
+    std::array<std::size_t, N> inner;   /// Distance between consecutive elements inside a tile
+};
+
+
+
+template <std::size_t Rank>
+struct LayoutMap<Morton, Rank>
+{
+    static constexpr bool strided = false;
+
+
+    /** The bits of the position are given to the dimensions in turns, from the last to the
+      * first, while they have bits left. The map of each dimension is kept in a table, so it
+      * is a single load instead of a bit deposit.
+    */
+    template <class Sizes>
+    void init (const Sizes& sizes)
+    {
+        const std::size_t n = sizes.size();
+
+        std::vector<std::size_t> bits(n), masks(n);
+
+        for(std::size_t k = 0; k < n; ++k)
+        {
+            if(!sizes[k] || (sizes[k] & (sizes[k] - 1)))
+                throw std::invalid_argument("The sizes must be powers of 2");
+
+            while((std::size_t(1) << bits[k]) < sizes[k])
+                ++bits[k];
+        }
+
+
+        const std::size_t totalBits = std::accumulate(bits.begin(), bits.end(), std::size_t(0));
+
+        for(std::size_t level = 0, bit = 0; bit < totalBits; ++level)
+            for(std::size_t k = n; k-- > 0;)
+                if(level < bits[k])
+                    masks[k] |= std::size_t(1) << bit++;
+
+
+        resizeTable(start, n);
+
+        table.resize(std::accumulate(sizes.begin(), sizes.end(), std::size_t(0)));
+
+        for(std::size_t k = 0, s = 0; k < n; s += sizes[k++])
+        {
+            start[k] = s;
+
+            for(std::size_t x = 0; x < sizes[k]; ++x)
+                table[s + x] = deposit(x, masks[k]);
+        }
+    }
+
+
+    template <std::size_t K>
+    std::size_t map (std::size_t x) const { return table[start[K] + x]; }
+
+    std::size_t map (std::size_t k, std::size_t x) const { return table[start[k] + x]; }
+
+
+    /// Places the bits of 'x', from the lowest, at the positions of the bits set in 'mask'
+    static std::size_t deposit (std::size_t x, std::size_t mask)
+    {
+        std::size_t res = 0;
+
+        for(; x && mask; x >>= 1, mask &= mask - 1)
+            if(x & 1)
+                res |= mask & (~mask + 1);
+
+        return res;
+    }
+
+
+    DimTable<Rank> start;               /// Where the map of each dimension starts in 'table'
+
+    std::vector<std::size_t> table;     /// The map of every index of every dimension
+};
+
+
+
+
+/** Part of the position given by 'u', either an integral or an iterable of integrals, for the
+  * map 'm' starting at the dimension 'k'. 'k' is incremented for each index.
+*/
+//@{
+template <class Map, typename U, EnableIfIntegral<std::decay_t<U>> = 0>
+inline std::size_t mapIncrement (const Map& m, U u, std::size_t& k)
+{
+    return m.map(k++, std::size_t(u));
+}
+
+template <class Map, typename U, EnableIfIterable<std::decay_t<U>> = 0>
+inline std::size_t mapIncrement (const Map& m, const U& u, std::size_t& k)
+{
+    std::size_t res = 0;
+
+    for(auto x : u)
+        res += m.map(k++, std::size_t(x));
+
+    return res;
+}
+//@}
+
+
+} // namespace help
+
+} // namespace cnt
+
+
+#endif // CNT_LAYOUT_H
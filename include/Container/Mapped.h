@@ -0,0 +1,442 @@
+/** \file Mapped.h
+  *
+  * A 'Container' whose elements live in a memory mapped file. The file starts with a small
+  * self describing header, followed by the elements in row major order. Opening a file maps
+  * it without reading it, so the time is constant and the pages are loaded on demand.
+*/
+
+#ifndef CNT_MAPPED_H
+#define CNT_MAPPED_H
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#else
+    #error "Mapped.h needs the POSIX 'mmap'"
+#endif
+
+#include "View.h"
+
+
+namespace cnt
+{
+
+/** The tag identifying the type of the elements in the header of a mapped file. Types that
+  * are not arithmetic are stored as 'Opaque', and only their size is checked.
+*/
+enum class TypeTag : std::uint32_t
+{
+    Opaque, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64
+};
+
+
+/** The header at the start of a mapped file. It is followed by 'rank' sizes and then 'rank'
+  * strides, both as 'std::uint64_t' and in elements. The elements start at 'dataOffset',
+  * which is a multiple of the page size.
+*/
+struct MappedHeader
+{
+    char magic[8];                  /// "CNTMAP" followed by two null characters
+
+    std::uint32_t byteOrder;        /// 'help::byteOrderMark' written in the byte order of the writer
+
+    std::uint32_t version;          /// Version of the format
+
+    TypeTag typeTag;                /// Type of the elements
+
+    std::uint32_t typeSize;         /// 'sizeof' of the elements
+
+    std::uint64_t rank;             /// Number of dimensions
+
+    std::uint64_t dataOffset;       /// Offset of the first element from the start of the file
+};
+
+
+
+namespace help
+{
+
+constexpr char mappedMagic[8] = { 'C', 'N', 'T', 'M', 'A', 'P', '\0', '\0' };
+
+constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+constexpr std::uint32_t mappedVersion = 1;
+
+
+
+/// The 'TypeTag' of 'T'
+template <typename T>
+constexpr TypeTag typeTag ()
+{
+    return std::is_floating_point<T>::value ? (sizeof(T) == 4 ? TypeTag::Float32 :
+                                               sizeof(T) == 8 ? TypeTag::Float64 : TypeTag::Opaque) :
+           !std::is_integral<T>::value ? TypeTag::Opaque :
+           sizeof(T) == 1 ? (std::is_signed<T>::value ? TypeTag::Int8  : TypeTag::UInt8)  :
+           sizeof(T) == 2 ? (std::is_signed<T>::value ? TypeTag::Int16 : TypeTag::UInt16) :
+           sizeof(T) == 4 ? (std::is_signed<T>::value ? TypeTag::Int32 : TypeTag::UInt32) :
+           sizeof(T) == 8 ? (std::is_signed<T>::value ? TypeTag::Int64 : TypeTag::UInt64) : TypeTag::Opaque;
+}
+
+
+
+/** Owns a file descriptor and a shared mapping of the whole file. Closes both at destruction.
+  * It can only be moved.
+*/
+class FileMapping
+{
+public:
+
+    FileMapping () : fd(-1), addr(nullptr), length(0) {}
+
+
+    /** Opens the file at 'path'. If 'length' is not 0, the file is created (or truncated) with
+      * this length. Otherwise, the existing file is mapped with its own length.
+    */
+    FileMapping (const std::string& path, bool writable, std::size_t length = 0) : FileMapping()
+    {
+        fd = ::open(path.c_str(), length ? (O_RDWR | O_CREAT | O_TRUNC) : (writable ? O_RDWR : O_RDONLY), 0644);
+
+        if(fd < 0)
+            throw std::system_error(errno, std::generic_category(), "Can not open '" + path + "'");
+
+
+        if(length)
+        {
+            if(::ftruncate(fd, off_t(length)))
+                fail("Can not resize '" + path + "'");
+        }
+
+        else
+        {
+            struct stat st;
+
+            if(::fstat(fd, &st))
+                fail("Can not read the size of '" + path + "'");
+
+            length = std::size_t(st.st_size);
+        }
+
+
+        void* p = ::mmap(nullptr, length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+
+        if(p == MAP_FAILED)
+            fail("Can not map '" + path + "'");
+
+        addr = static_cast<char*>(p);
+
+        this->length = length;
+    }
+
+
+    FileMapping (FileMapping&& m) : fd(m.fd), addr(m.addr), length(m.length)
+    {
+        m.fd = -1;
+        m.addr = nullptr;
+        m.length = 0;
+    }
+
+    FileMapping& operator = (FileMapping&& m)
+    {
+        std::swap(fd, m.fd);
+        std::swap(addr, m.addr);
+        std::swap(length, m.length);
+
+        return *this;
+    }
+
+
+    ~FileMapping ()
+    {
+        if(addr)
+            ::munmap(addr, length);
+
+        if(fd >= 0)
+            ::close(fd);
+    }
+
+
+    /// Writes the modified pages back to the file
+    void flush ()
+    {
+        if(addr && ::msync(addr, length, MS_SYNC))
+            throw std::system_error(errno, std::generic_category(), "Can not flush the mapping");
+    }
+
+
+
+    int fd;             /// The file descriptor
+
+    char* addr;         /// Start of the mapping
+
+    std::size_t length; /// Length of the mapping, which is the length of the file
+
+
+private:
+
+    /// Throws the current 'errno' after closing the file
+    void fail (const std::string& msg)
+    {
+        int err = errno;
+
+        ::close(fd);
+
+        fd = -1;
+
+        throw std::system_error(err, std::generic_category(), msg);
+    }
+};
+
+
+
+
+template <typename T, class S>
+class Mapped;
+
+
+/** A 'View' over a memory mapped file, which owns the mapping. The shape is read from the header
+  * of the file and checked against 'Is', which can also be '0' for runtime sizes, as in 'View'.
+  * Use a const 'T' to open a file as read only.
+*/
+template <typename T, std::size_t... Is>
+class Mapped<T, Shape<Is...>> : public View<T, Shape<Is...>>
+{
+public:
+
+    static_assert(std::is_trivially_copyable<std::remove_const_t<T>>::value,
+                  "Only trivially copyable types can be stored in a file");
+
+
+    /** Some type definitions */
+    //@{
+    using Base = View<T, Shape<Is...>>;
+
+    using Base::Size;
+
+    using value_type = typename Base::value_type;
+
+    using reference = typename Base::reference;
+
+    using const_reference = typename Base::const_reference;
+    //@}
+
+
+
+    /// An empty mapping
+    Mapped () {}
+
+
+    /** Opens the existing file at 'path', checking that its header matches 'T' and 'Is'.
+      * Throws 'std::runtime_error' if it does not, or 'std::system_error' on IO errors.
+    */
+    explicit Mapped (const std::string& path) : Mapped(open(path)) {}
+
+
+    /** Creates the file at 'path' with the sizes of each dimension given by integrals. For a
+      * static shape they must be the same as 'Is'. The elements are zero initialized.
+    */
+    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args >... > = 0>
+    Mapped (const std::string& path, Args... args) : Mapped(create(path, { std::size_t(args)... })) {}
+
+
+    /// Same as above, with the sizes given by an iterable of integrals
+    template <class U, help::EnableIfIterable< std::remove_reference_t< U > > = 0>
+    Mapped (const std::string& path, const U& sizes) : Mapped(create(path, help::concat(sizes))) {}
+
+
+
+    /// The header of the file
+    const MappedHeader& header () const { return *reinterpret_cast<const MappedHeader*>(mapping.addr); }
+
+    /// Writes the modified elements back to the file
+    void flush () { mapping.flush(); }
+
+
+
+private:
+
+
+    /// A mapping and the sizes of each dimension read from its header
+    struct Opened
+    {
+        FileMapping mapping;
+
+        std::vector<std::size_t> sizes;
+    };
+
+
+
+    Mapped (Opened&& o) : Base(view(o, std::integral_constant<bool, bool(Size)>())), mapping(std::move(o.mapping)) {}
+
+
+    static Base view (const Opened& o, std::true_type)
+    {
+        return Base(reinterpret_cast<T*>(o.mapping.addr + reinterpret_cast<const MappedHeader*>(o.mapping.addr)->dataOffset));
+    }
+
+    static Base view (const Opened& o, std::false_type)
+    {
+        return Base(reinterpret_cast<T*>(o.mapping.addr + reinterpret_cast<const MappedHeader*>(o.mapping.addr)->dataOffset),
+                    o.sizes.begin(), o.sizes.end());
+    }
+
+
+
+    /// Creates the file, writing the header
+    static Opened create (const std::string& path, const std::vector<std::size_t>& sizes)
+    {
+        static_assert(!std::is_const<T>::value, "Can not create a file for a read only mapping");
+
+
+        if(sizes.size() != sizeof...(Is) || (Size && sizes != std::vector<std::size_t>{ Is... }))
+            throw std::invalid_argument("The sizes do not match the shape of the container");
+
+
+        std::vector<std::uint64_t> strides(sizes.size(), 1);
+
+        for(std::size_t i = sizes.size() - 1; i > 0; --i)
+            strides[i-1] = strides[i] * sizes[i];
+
+
+        const std::size_t page = std::size_t(::sysconf(_SC_PAGESIZE));
+
+        const std::size_t headerSize = sizeof(MappedHeader) + 2 * sizes.size() * sizeof(std::uint64_t);
+
+        const std::size_t dataOffset = (headerSize + page - 1) / page * page;
+
+
+        Opened o{ FileMapping(path, true, dataOffset + sizeof(T) * strides[0] * sizes[0]), sizes };
+
+
+        MappedHeader h;
+
+        std::memcpy(h.magic, mappedMagic, sizeof(h.magic));
+
+        h.byteOrder = byteOrderMark;
+        h.version = mappedVersion;
+        h.typeTag = typeTag<T>();
+        h.typeSize = sizeof(T);
+        h.rank = sizes.size();
+        h.dataOffset = dataOffset;
+
+        std::memcpy(o.mapping.addr, &h, sizeof(h));
+
+
+        std::uint64_t* p = reinterpret_cast<std::uint64_t*>(o.mapping.addr + sizeof(MappedHeader));
+
+        std::copy(sizes.begin(), sizes.end(), p);
+
+        std::copy(strides.begin(), strides.end(), p + sizes.size());
+
+
+        return o;
+    }
+
+
+
+    /// Maps an existing file and validates its header
+    static Opened open (const std::string& path)
+    {
+        Opened o{ FileMapping(path, !std::is_const<T>::value), {} };
+
+        auto fail = [&](const std::string& msg){ throw std::runtime_error("'" + path + "': " + msg); };
+
+
+        if(o.mapping.length < sizeof(MappedHeader))
+            fail("too small to be a mapped container");
+
+        MappedHeader h;
+
+        std::memcpy(&h, o.mapping.addr, sizeof(h));
+
+
+        if(std::memcmp(h.magic, mappedMagic, sizeof(h.magic)))
+            fail("not a mapped container");
+
+        if(h.byteOrder != byteOrderMark)
+            fail("written with a different byte order");
+
+        if(h.version != mappedVersion)
+            fail("unknown version");
+
+        if(h.typeTag != typeTag<T>() || h.typeSize != sizeof(T))
+            fail("the type of the elements does not match");
+
+        if(h.rank != sizeof...(Is))
+            fail("the number of dimensions does not match");
+
+        if(o.mapping.length < sizeof(MappedHeader) + 2 * h.rank * sizeof(std::uint64_t))
+            fail("truncated header");
+
+        if(h.dataOffset < sizeof(MappedHeader) + 2 * h.rank * sizeof(std::uint64_t))
+            fail("the data overlaps the header");
+
+
+        const std::uint64_t* p = reinterpret_cast<const std::uint64_t*>(o.mapping.addr + sizeof(MappedHeader));
+
+        o.sizes.assign(p, p + h.rank);
+
+        if(Size && o.sizes != std::vector<std::size_t>{ Is... })
+            fail("the sizes of the dimensions do not match");
+
+
+        constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+
+        std::uint64_t stride = 1;
+
+        for(std::size_t i = h.rank; i > 0; --i)
+        {
+            if(p[h.rank + i - 1] != stride)
+                fail("only row major files can be mapped");
+
+            if(p[i-1] && stride > max / p[i-1])
+                fail("the sizes are too large");
+
+            stride *= p[i-1];
+        }
+
+        if(stride > (max - h.dataOffset) / sizeof(T))
+            fail("the sizes are too large");
+
+        if(h.dataOffset % alignof(T) || o.mapping.length < h.dataOffset + stride * sizeof(T))
+            fail("truncated data");
+
+
+        return o;
+    }
+
+
+
+    FileMapping mapping;    /// The mapped file
+};
+
+
+} // namespace help
+
+
+
+/** A 'Container' stored in a memory mapped file. For example:
+  *
+  *     cnt::MappedContainer<float, 0, 0, 0> a("volume.cnt", 512, 512, 512);   // Creates the file
+  *     cnt::MappedContainer<const float, 0, 0, 0> b("volume.cnt");           // Maps it read only
+  *
+  * The access and 'slice()' are the same as for 'ContainerView'.
+*/
+template <typename T, std::size_t... Is>
+using MappedContainer = help::Accessor<help::Mapped<T, Shape<Is...>>>;
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_MAPPED_H
@@ -0,0 +1,278 @@
+/** \file NdIndex.h
+  *
+  * Traversal of the elements of a container together with their indices:
+  *
+  *     cnt::Container<float, 0, 0, 0> c(100, 200, 300);
+  *
+  *     for(auto e : cnt::ndindex(c))
+  *         e.value = e.index[0] + 2 * e.index[1] + 3 * e.index[2];
+  *
+  * The elements are visited in row major order over the indices. The iterator keeps the index
+  * and the position of the current element, and a step only adds the stride of the last
+  * dimension, carrying to the previous ones when it wraps around. So the cost per element is
+  * an add and a compare, instead of the product of each index by its weight in 'operator()'.
+*/
+
+#ifndef CNT_NDINDEX_H
+#define CNT_NDINDEX_H
+
+#include <memory>
+
+#include "Strided.h"
+#include "Slice.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+/** An element and its index, given by the iterators of 'ndindex'. The index belongs to the
+  * iterator, so it is valid until the iterator moves.
+*/
+template <typename T, std::size_t N>
+struct NdElement
+{
+    const DimTable<N>& index;
+
+    T& value;
+};
+
+
+
+/// The sizes and strides of a 'NdRange'
+template <std::size_t N>
+struct NdTables
+{
+    DimTable<N> sizes;
+
+    DimTable<N> strides;
+};
+
+
+/** How the iterators of a 'NdRange' keep its tables, so they do not depend on the range they
+  * were taken from. With a number of dimensions known at compile time the tables are arrays,
+  * copied by value. Otherwise they are 'std::vector's, allocated once by the range and shared
+  * by its iterators, so taking and copying an iterator does not copy them.
+*/
+//@{
+template <std::size_t N>
+using NdTablesRef = std::conditional_t<(N > 0), NdTables<N>, std::shared_ptr<const NdTables<0>>>;
+
+template <std::size_t N>
+NdTables<N> shareTables (NdTables<N> tables) { return tables; }
+
+inline std::shared_ptr<const NdTables<0>> shareTables (NdTables<0> tables)
+{
+    return std::make_shared<const NdTables<0>>(std::move(tables));
+}
+
+template <std::size_t N>
+const NdTables<N>& tablesOf (const NdTables<N>& tables) { return tables; }
+
+inline const NdTables<0>& tablesOf (const std::shared_ptr<const NdTables<0>>& tables) { return *tables; }
+//@}
+
+
+
+/** Iterates over the elements given by a pointer, sizes and strides in row major order over the
+  * indices, updating the pointer incrementally. 'N' is the number of dimensions, or '0' if it is
+  * known only at runtime. The sizes and strides are kept as in 'NdTablesRef'.
+*/
+template <typename T, std::size_t N>
+class NdIterator
+{
+public:
+
+    using iterator_category = std::forward_iterator_tag;
+
+    using value_type = NdElement<T, N>;
+
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = void;
+
+    using reference = NdElement<T, N>;
+
+
+
+    NdIterator () : ptr(nullptr), pos(0), tables{}, index{}, lastIndex(0), lastSize(0), lastStride(0) {}
+
+    /// An iterator at the first element 'ptr'
+    NdIterator (T* ptr, const NdTablesRef<N>& tables) : ptr(ptr), pos(0), tables(tables), index{}, lastIndex(0)
+    {
+        const auto& sizes = tablesOf(tables).sizes;
+
+        resizeTable(index, sizes.size());
+
+        lastSize = sizes.size() ? sizes[sizes.size() - 1] : 1;
+        lastStride = sizes.size() ? tablesOf(tables).strides[sizes.size() - 1] : 0;
+    }
+
+    /// An iterator at the position 'pos' that can only be compared, like 'end()'
+    explicit NdIterator (std::size_t pos) : ptr(nullptr), pos(pos), tables{}, index{}, lastIndex(0), lastSize(0), lastStride(0) {}
+
+
+
+    /// The index of the last dimension is written to the table only here
+    reference operator * () const
+    {
+        if(numDimensions())
+            index[numDimensions() - 1] = lastIndex;
+
+        return reference{ index, *ptr };
+    }
+
+
+    NdIterator& operator ++ ()
+    {
+        ++pos;
+
+        ptr += lastStride;
+
+        if(++lastIndex < lastSize)
+            return *this;
+
+        ptr -= lastIndex * lastStride;
+
+        lastIndex = 0;
+
+        if(numDimensions() < 2)
+            return *this;
+
+        const auto& sizes = tablesOf(tables).sizes;
+        const auto& strides = tablesOf(tables).strides;
+
+        for(std::size_t i = numDimensions() - 1; i-- > 0;)
+        {
+            ptr += strides[i];
+
+            if(++index[i] < sizes[i])
+                break;
+
+            ptr -= index[i] * strides[i];
+
+            index[i] = 0;
+        }
+
+        return *this;
+    }
+
+    NdIterator operator ++ (int)
+    {
+        NdIterator it = *this;
+
+        ++*this;
+
+        return it;
+    }
+
+
+    bool operator == (const NdIterator& it) const { return pos == it.pos; }
+
+    bool operator != (const NdIterator& it) const { return pos != it.pos; }
+
+
+
+private:
+
+    /// Known at compile time if 'N' is not 0
+    std::size_t numDimensions () const { return N ? N : index.size(); }
+
+
+    T* ptr;                         /// Current element
+
+    std::size_t pos;                /// Position in row major order
+
+    NdTablesRef<N> tables;          /// Sizes and strides of the range
+
+    mutable DimTable<N> index;      /// Current index in each dimension
+
+
+    /** The last dimension, kept apart so the common step does not touch the tables */
+    //@{
+    std::size_t lastIndex;
+
+    std::size_t lastSize;
+
+    std::size_t lastStride;
+    //@}
+};
+
+
+
+/// The elements of a strided source with their indices. See 'ndindex'.
+template <typename T, std::size_t N>
+class NdRange
+{
+public:
+
+    using iterator = NdIterator<T, N>;
+
+    using const_iterator = iterator;
+
+
+    template <class Sizes, class Strides>
+    NdRange (T* data, const Sizes& sizes, const Strides& strides) : data(data)
+    {
+        NdTables<N> t;
+
+        resizeTable(t.sizes, sizes.size());
+        resizeTable(t.strides, strides.size());
+
+        std::copy(sizes.begin(), sizes.end(), t.sizes.begin());
+        std::copy(strides.begin(), strides.end(), t.strides.begin());
+
+        numElements = std::accumulate(t.sizes.begin(), t.sizes.end(), std::size_t(1), std::multiplies<std::size_t>());
+
+        tables = shareTables(std::move(t));
+    }
+
+
+    /// Number of elements
+    std::size_t size () const { return numElements; }
+
+
+    /// Begin and end
+    //@{
+    iterator begin () const { return iterator(data, tables); }
+
+    iterator end () const { return iterator(numElements); }
+    //@}
+
+
+private:
+
+    T* data;
+
+    NdTablesRef<N> tables;
+
+    std::size_t numElements;
+};
+
+
+} // namespace help
+
+
+
+/** The elements of 'c' with their indices, in row major order over the indices. The source can
+  * be anything with strides: a 'Container' in row or column major order, a 'ContainerView', a
+  * 'Slice' or a 'StridedView'. The index is a 'std::array' if the number of dimensions of 'c'
+  * is known at compile time, and a 'std::vector' otherwise.
+*/
+template <class C>
+auto ndindex (C&& c)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    return help::NdRange<T, help::staticRank<std::decay_t<C>>>(c.data(), c.sizes(), c.strides());
+}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_NDINDEX_H
@@ -0,0 +1,906 @@
+/** \file Paged.h
+  *
+  * A container larger than the memory, stored in a scratch file and paged in and out by slabs,
+  * which are the elements with the same index in the first dimension:
+  *
+  *     cnt::PagedContainer<float, 0, 0, 0> a("scratch.bin", 1 << 30, 4096, 2048, 2048);  // 64 GB, 1 GB in memory
+  *
+  *     a(10, 20, 30) = 1.5f;
+  *     float x = a(10, 20, 30);
+  *
+  *     auto s = a.slice(10);       // A 'ContainerView<float, 0, 0>' of the slab 10, which stays in memory
+  *     s(20, 30) += 1.0f;          // while 's' exists
+  *
+  * At most 'budget / slab size' slabs are kept in memory, and the slab replaced when a new one is
+  * needed is chosen by the clock algorithm: each slab has a bit set when it is used, and a hand
+  * going around the slabs clears the bit of the slabs it passes, stopping at the first one whose
+  * bit was clear. A modified slab is written to the file by a background thread, so the slab that
+  * replaces it can be read at once. When the slabs are used in increasing order, the next ones are
+  * read ahead by the same thread.
+  *
+  * Each access by 'operator()' locks a mutex and can read a slab, so the loops over the elements
+  * should go through 'slice', whose views access the memory directly.
+*/
+
+#ifndef CNT_PAGED_H
+#define CNT_PAGED_H
+
+#include <cstring>
+#include <cerrno>
+#include <deque>
+#include <string>
+#include <system_error>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#else
+    #error "Paged.h needs the POSIX 'pread' and 'pwrite'"
+#endif
+
+#include "Parallel.h"
+#include "View.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+/// Marks a slab that is not in memory, or a frame without a slab
+constexpr std::size_t noSlab = std::size_t(-1);
+
+
+
+/** Keeps the slabs of 'slabBytes' bytes of a scratch file in memory under a budget, evicting them
+  * with the clock algorithm. The modified slabs are written back and the next slabs of an
+  * increasing sequence are read ahead by a background thread. All member functions are thread
+  * safe. It can not be moved, since the thread refers to it.
+*/
+class Pager
+{
+public:
+
+    /** Creates the scratch file at 'path' for 'slabs' slabs of 'slabBytes' bytes, all zero. The
+      * file is removed at once, so it goes away with the pager. At most 'budget / slabBytes'
+      * slabs are kept in memory, but at least one, and 'readahead' slabs are read ahead of an
+      * increasing sequence. The evicted slabs waiting to be written are not counted, but there
+      * are at most as many of them as slabs in memory. Throws 'std::system_error' if the file
+      * can not be created.
+    */
+    Pager (const std::string& path, std::size_t slabs, std::size_t slabBytes, std::size_t budget, std::size_t readahead = 2) :
+           slabBytes(slabBytes), maxFrames(std::max<std::size_t>(budget / std::max<std::size_t>(slabBytes, 1), 1)),
+           readahead(std::min(readahead, maxFrames / 2)), where(slabs, noSlab), loading(slabs, false)
+    {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+        if(fd < 0)
+            throw std::system_error(errno, std::generic_category(), "Can not open '" + path + "'");
+
+        ::unlink(path.c_str());
+
+        if(::ftruncate(fd, off_t(slabs * slabBytes)))
+        {
+            const int err = errno;
+
+            ::close(fd);
+
+            throw std::system_error(err, std::generic_category(), "Can not resize '" + path + "'");
+        }
+
+        worker = std::thread([this]{ run(); });
+    }
+
+
+    Pager (const Pager&) = delete;
+
+    Pager& operator = (const Pager&) = delete;
+
+
+    /// Stops the background thread, dropping the slabs not written yet, and closes the file
+    ~Pager ()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            stop = true;
+        }
+
+        cv.notify_all();
+
+        worker.join();
+
+        ::close(fd);
+    }
+
+
+
+    /// Copies the element of type 'T' at the position 'i' of the slab 's' to 'x', or back if 'write'
+    template <typename T>
+    void access (std::size_t s, std::size_t i, T& x, bool write)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        char* p = frameOf(s, lock, write).data.get() + i * sizeof(T);
+
+        if(write)
+            std::memcpy(p, &x, sizeof(T));
+
+        else
+            std::memcpy(&x, p, sizeof(T));
+    }
+
+
+    /** The memory of the slab 's', which stays in memory until 'unpin' is called as many times as
+      * 'pin'. The slab is considered modified if 'write' is true.
+    */
+    char* pin (std::size_t s, bool write)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        Frame& f = frameOf(s, lock, write);
+
+        ++f.pins;
+
+        return f.data.get();
+    }
+
+    void unpin (std::size_t s)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        const std::size_t f = where[s];
+
+        /// A slab kept over the budget leaves as soon as it is not pinned
+        if(!--frames[f].pins && residents > maxFrames)
+            evict(f);
+    }
+
+
+    /** Writes the modified slabs to the file and waits for the background writes. Throws
+      * 'std::system_error' if a read or write failed since the last call.
+    */
+    void flush ()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        for(auto& f : frames)
+            if(f.slab != noSlab && f.dirty)
+            {
+                transfer(f.slab, f.data.get(), true);
+
+                f.dirty = f.pins > 0;
+            }
+
+        cv.wait(lock, [&]{ return !writes; });
+
+        rethrow();
+    }
+
+
+    /// Number of slabs in memory, which is more than 'maxResident' only if the others are pinned
+    std::size_t resident () const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        return residents;
+    }
+
+    /// Maximum number of slabs in memory, given by the budget
+    std::size_t maxResident () const { return maxFrames; }
+
+
+
+private:
+
+    using Buffer = std::unique_ptr<char[]>;
+
+
+    /// A slab in memory
+    struct Frame
+    {
+        Buffer data;
+
+        std::size_t slab;       /// The slab in 'data', or 'noSlab'
+
+        std::size_t pins;       /// Number of 'pin' calls not undone
+
+        bool referenced;        /// Used since the clock hand last passed
+
+        bool dirty;             /// Modified since it was read
+    };
+
+
+    /// A read ahead or a write back for the background thread
+    struct Task
+    {
+        bool write;
+
+        std::size_t slab;
+
+        Buffer data;
+    };
+
+
+
+    /** The frame of the slab 's', reading it if it is not in memory. The mutex is locked by 'lock',
+      * and is released while waiting for a slab being read ahead or for the background writes.
+    */
+    Frame& frameOf (std::size_t s, std::unique_lock<std::mutex>& lock, bool write)
+    {
+        rethrow();
+
+        cv.wait(lock, [&]{ return !loading[s] && (where[s] != noSlab || writes <= maxFrames); });
+
+        if(where[s] == noSlab)
+        {
+            const std::size_t f = victim();
+
+            auto it = pending.find(s);
+
+            if(it != pending.end())
+                std::memcpy(frames[f].data.get(), it->second, slabBytes);
+
+            else
+                transfer(s, frames[f].data.get(), false);
+
+            place(f, s, true);
+        }
+
+
+        if(s == last + 1)
+            for(std::size_t k = s + 1; k <= s + readahead && k < where.size(); ++k)
+                if(where[k] == noSlab && !loading[k] && !pending.count(k))
+                {
+                    loading[k] = true;
+
+                    tasks.push_back(Task{ false, k, nullptr });
+
+                    cv.notify_all();
+                }
+
+        last = s;
+
+
+        Frame& f = frames[where[s]];
+
+        f.referenced = true;
+        f.dirty = f.dirty || write;
+
+        return f;
+    }
+
+
+    /** A frame for a new slab. If the budget is used, the slab to replace is chosen with the clock
+      * algorithm. If all slabs are pinned, a frame is added over the budget.
+    */
+    std::size_t victim ()
+    {
+        std::size_t f = noSlab;
+
+        if(residents < maxFrames)
+            f = std::find_if(frames.begin(), frames.end(), [](const Frame& g){ return g.slab == noSlab; }) - frames.begin();
+
+        for(std::size_t n = 0; f == noSlab && n < 2 * frames.size(); ++n)
+        {
+            Frame& frame = frames[hand];
+
+            if(frame.slab != noSlab && !frame.pins && !frame.referenced)
+            {
+                evict(hand);
+
+                f = hand;
+            }
+
+            frame.referenced = frame.referenced && frame.pins;
+
+            hand = (hand + 1) % frames.size();
+        }
+
+        if(f == noSlab || f == frames.size())
+        {
+            frames.push_back(Frame{ nullptr, noSlab, 0, false, false });
+
+            f = frames.size() - 1;
+        }
+
+        if(!frames[f].data)
+            frames[f].data = buffer();
+
+        return f;
+    }
+
+
+    /** Removes the slab of the frame 'f' from memory, giving it to the background thread if it was
+      * modified. The frame is left without a buffer.
+    */
+    void evict (std::size_t f)
+    {
+        Frame& frame = frames[f];
+
+        where[frame.slab] = noSlab;
+
+        if(frame.dirty)
+        {
+            pending[frame.slab] = frame.data.get();
+
+            tasks.push_back(Task{ true, frame.slab, std::move(frame.data) });
+
+            ++writes;
+
+            cv.notify_all();
+        }
+
+        else
+            recycle(std::move(frame.data));
+
+        frame.slab = noSlab;
+
+        --residents;
+    }
+
+
+    /// Puts the slab 's' in the frame 'f'
+    void place (std::size_t f, std::size_t s, bool referenced)
+    {
+        frames[f].slab = s;
+        frames[f].pins = 0;
+        frames[f].referenced = referenced;
+        frames[f].dirty = false;
+
+        where[s] = f;
+
+        ++residents;
+    }
+
+
+    /// A buffer for a slab, reusing the ones of the evicted slabs and finished tasks
+    Buffer buffer ()
+    {
+        if(spare.empty())
+            return Buffer(new char[slabBytes]);
+
+        Buffer b = std::move(spare.back());
+
+        spare.pop_back();
+
+        return b;
+    }
+
+    /// Keeps a buffer for 'buffer', or frees it if there are enough of them
+    void recycle (Buffer b)
+    {
+        if(b && spare.size() < 2)
+            spare.push_back(std::move(b));
+    }
+
+
+
+    /// Reads or writes the slab 's' from or to 'p'
+    void transfer (std::size_t s, char* p, bool write) const
+    {
+        for(std::size_t done = 0; done < slabBytes;)
+        {
+            const off_t pos = off_t(s * slabBytes + done);
+
+            const ssize_t n = write ? ::pwrite(fd, p + done, slabBytes - done, pos)
+                                    : ::pread(fd, p + done, slabBytes - done, pos);
+
+            if(n < 0 && errno == EINTR)
+                continue;
+
+            if(n <= 0)
+                throw std::system_error(n < 0 ? errno : EIO, std::generic_category(),
+                                        write ? "Can not write a slab" : "Can not read a slab");
+
+            done += std::size_t(n);
+        }
+    }
+
+
+    /// Throws the error of the background thread, if there was one
+    void rethrow ()
+    {
+        if(error)
+            std::rethrow_exception(std::exchange(error, nullptr));
+    }
+
+
+
+    /// The background thread, running the tasks in order
+    void run ()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while(true)
+        {
+            cv.wait(lock, [&]{ return stop || !tasks.empty(); });
+
+            if(stop)
+                return;
+
+            Task task = std::move(tasks.front());
+
+            tasks.pop_front();
+
+
+            /// A slab to read ahead may have been read or evicted with changes since it was asked
+            if(!task.write)
+            {
+                if(where[task.slab] != noSlab || pending.count(task.slab))
+                {
+                    loading[task.slab] = false;
+                    cv.notify_all();
+                    continue;
+                }
+
+                task.data = buffer();
+            }
+
+
+            lock.unlock();
+
+            std::exception_ptr failure;
+
+            try
+            {
+                transfer(task.slab, task.data.get(), task.write);
+            }
+
+            catch(...)
+            {
+                failure = std::current_exception();
+            }
+
+            lock.lock();
+
+
+            if(failure)
+                error = failure;
+
+            if(task.write)
+            {
+                auto it = pending.find(task.slab);
+
+                if(it != pending.end() && it->second == task.data.get())
+                    pending.erase(it);
+
+                --writes;
+            }
+
+            else
+            {
+                loading[task.slab] = false;
+
+                if(!failure)
+                {
+                    const std::size_t f = victim();
+
+                    std::swap(frames[f].data, task.data);
+
+                    place(f, task.slab, false);
+                }
+            }
+
+            recycle(std::move(task.data));
+
+            cv.notify_all();
+        }
+    }
+
+
+
+    int fd;                                             /// The scratch file
+
+    std::size_t slabBytes;                              /// Bytes of each slab
+
+    std::size_t maxFrames;                              /// Maximum number of slabs in memory
+
+    std::size_t readahead;                              /// Number of slabs read ahead
+
+
+    std::vector<Frame> frames;                          /// The slabs in memory
+
+    std::vector<std::size_t> where;                     /// Frame of each slab, or 'noSlab'
+
+    std::vector<bool> loading;                          /// Slabs being read ahead
+
+    std::unordered_map<std::size_t, char*> pending;     /// Last version of the slabs being written back
+
+    std::deque<Task> tasks;                             /// Tasks for the background thread
+
+    std::vector<Buffer> spare;                          /// Buffers to reuse
+
+    std::size_t hand = 0;                               /// Position of the clock hand
+
+    std::size_t last = noSlab;                          /// Last slab accessed
+
+    std::size_t writes = 0;                             /// Number of write backs not finished
+
+    std::size_t residents = 0;                          /// Number of slabs in memory
+
+
+    mutable std::mutex mutex;
+
+    std::condition_variable cv;
+
+    std::thread worker;
+
+    bool stop = false;
+
+    std::exception_ptr error;                           /// Error of the background thread
+};
+
+
+
+
+/** Keeps a slab of a 'Pager' pinned, unpinning it at destruction. A copy pins the slab again. */
+class SlabPin
+{
+public:
+
+    SlabPin () : pager(nullptr), slab(0) {}
+
+    /// Takes over a pin already made by 'Pager::pin'
+    SlabPin (Pager* pager, std::size_t slab) : pager(pager), slab(slab) {}
+
+
+    SlabPin (const SlabPin& p) : pager(p.pager), slab(p.slab)
+    {
+        if(pager)
+            pager->pin(slab, false);
+    }
+
+    SlabPin (SlabPin&& p) : pager(std::exchange(p.pager, nullptr)), slab(p.slab) {}
+
+    SlabPin& operator = (SlabPin p)
+    {
+        std::swap(pager, p.pager);
+        std::swap(slab, p.slab);
+
+        return *this;
+    }
+
+
+    ~SlabPin ()
+    {
+        if(pager)
+            pager->unpin(slab);
+    }
+
+
+private:
+
+    Pager* pager;
+
+    std::size_t slab;
+};
+
+
+
+
+template <typename T, class S>
+class Pinned;
+
+
+/** A 'View' of a slab that keeps it pinned in memory while the view, or a copy of it, exists.
+  * The slices taken from it refer to it, so they must not outlive it.
+*/
+template <typename T, std::size_t... Is>
+class Pinned<T, Shape<Is...>> : public View<T, Shape<Is...>>
+{
+public:
+
+    using Base = View<T, Shape<Is...>>;
+
+
+    Pinned (const Base& view, SlabPin pin) : Base(view), pin(std::move(pin)) {}
+
+
+private:
+
+    SlabPin pin;
+};
+
+
+
+/// The shape of a slab, without the first dimension
+//@{
+template <class>
+struct SlabShape;
+
+template <std::size_t I, std::size_t... Is>
+struct SlabShape<Shape<I, Is...>> { using type = Shape<Is...>; };
+//@}
+
+
+
+/** An element of a 'Paged' container, read or written through the 'Pager' on each access */
+template <typename T>
+class PagedReference
+{
+public:
+
+    PagedReference (Pager& pager, std::size_t slab, std::size_t pos) : pager(pager), slab(slab), pos(pos) {}
+
+
+    operator T () const
+    {
+        T x;
+
+        pager.access(slab, pos, x, false);
+
+        return x;
+    }
+
+    PagedReference& operator = (T x)
+    {
+        pager.access(slab, pos, x, true);
+
+        return *this;
+    }
+
+    PagedReference& operator = (const PagedReference& r)
+    {
+        return *this = T(r);
+    }
+
+
+private:
+
+    Pager& pager;
+
+    std::size_t slab;
+
+    std::size_t pos;
+};
+
+
+
+
+template <typename T, class S>
+class Paged;
+
+
+/** A container stored in a scratch file and paged by slabs, the elements with the same index in
+  * the first dimension. See 'Pager' for how the slabs are kept in memory. The access is the same
+  * as for 'Container', but the non const 'operator()' returns a 'PagedReference', since the slab
+  * of an element can be evicted after the access. 'slice(i)' gives a 'ContainerView' of the slab
+  * 'i' instead, which keeps it in memory while it exists.
+  *
+  * \tparam T The type of the elements, which must be trivially copyable
+  * \tparam Is The sizes of the dimensions, or '0' for each one given at runtime
+*/
+template <typename T, std::size_t... Is>
+class Paged<T, Shape<Is...>> : public Dimensions<Is...>
+{
+public:
+
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored in a file");
+
+    static_assert(sizeof...(Is) > 1, "A paged container needs at least two dimensions");
+
+
+    /** Some type definitions */
+    //@{
+    using Dims = Dimensions<Is...>;
+
+    using value_type = T;
+
+    using reference = PagedReference<T>;
+
+    using const_reference = T;
+
+
+    using SlabView = Accessor<Pinned<T, typename SlabShape<Shape<Is...>>::type>>;
+
+    using ConstSlabView = Accessor<Pinned<const T, typename SlabShape<Shape<Is...>>::type>>;
+
+
+    static constexpr std::size_t Size = help::multiply_v<Is...>;
+    //@}
+
+
+
+    /** Creates the scratch file at 'path' with the sizes of each dimension given by integrals,
+      * keeping at most 'budget' bytes of slabs in memory. For a static shape the sizes can be
+      * omitted. The elements are zero initialized. Throws 'std::invalid_argument' if the sizes
+      * do not match the shape, or 'std::system_error' if the file can not be created.
+    */
+    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args >... > = 0>
+    Paged (const std::string& path, std::size_t budget, Args... args) :
+           Paged(std::integral_constant<bool, bool(Size)>(), path, budget, { std::size_t(args)... }) {}
+
+
+    /// Same as above, with the sizes given by an iterable of integrals
+    template <class U, help::EnableIfIterable< std::remove_reference_t< U > > = 0>
+    Paged (const std::string& path, std::size_t budget, const U& sizes) :
+           Paged(std::integral_constant<bool, bool(Size)>(), path, budget, help::concat(sizes)) {}
+
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+    /** Access to an element, as in 'Container'. Each access locks the pager, and may read the slab
+      * of the element and evict another one.
+    */
+    //@{
+    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
+    const_reference operator () (const Args&... args) const
+    {
+        return T(element(Dims::offset(args...)));
+    }
+
+    template <typename... Args, EnableIfIntegralOrIterable<Args...> = 0>
+    reference operator () (const Args&... args)
+    {
+        return element(Dims::offset(args...));
+    }
+
+
+    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
+    const_reference operator () (const U& begin) const
+    {
+        return T(element(std::inner_product(weights.begin(), weights.end(), begin, std::size_t(0))));
+    }
+
+    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
+    reference operator () (const U& begin)
+    {
+        return element(std::inner_product(weights.begin(), weights.end(), begin, std::size_t(0)));
+    }
+
+
+    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
+    const_reference operator () (std::initializer_list<U> il) const
+    {
+        return (*this)(il.begin());
+    }
+
+    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
+    reference operator () (std::initializer_list<U> il)
+    {
+        return (*this)(il.begin());
+    }
+    //@}
+
+
+
+    /** A view of the slab 'i', which is pinned in memory until the view and its copies are
+      * destroyed. The view of a non const container marks the slab as modified. The views must
+      * not outlive the container.
+    */
+    //@{
+    ConstSlabView slice (std::size_t i) const
+    {
+        return ConstSlabView(slabView<const T>(pager->pin(i, false)), SlabPin(pager.get(), i));
+    }
+
+    SlabView slice (std::size_t i)
+    {
+        return SlabView(slabView<T>(pager->pin(i, true)), SlabPin(pager.get(), i));
+    }
+    //@}
+
+
+
+    /// Writes the modified slabs to the file (see 'Pager::flush')
+    void flush () { pager->flush(); }
+
+    /// Number of slabs in memory
+    std::size_t residentSlabs () const { return pager->resident(); }
+
+    /// Maximum number of slabs in memory not pinned, given by the budget
+    std::size_t maxResidentSlabs () const { return pager->maxResident(); }
+
+
+
+    /// Size of each dimension
+    std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size
+    std::size_t size () const { return dimSize[0] * weights[0]; }
+
+    auto sizes () const { return dimSize; }
+
+    std::size_t numDimensions () const { return numDimensions_; }
+
+
+
+private:
+
+
+    using Dims::numDimensions_;
+
+    using Dims::dimSize;
+
+    using Dims::weights;
+
+
+
+    /// The sizes are the ones of the static shape
+    Paged (std::true_type, const std::string& path, std::size_t budget, const std::vector<std::size_t>& sizes) :
+           pager(makePager(path, budget))
+    {
+        if(!sizes.empty() && sizes != std::vector<std::size_t>{ Is... })
+            throw std::invalid_argument("The sizes do not match the shape of the container");
+    }
+
+    Paged (std::false_type, const std::string& path, std::size_t budget, const std::vector<std::size_t>& sizes) :
+           Dims(checked(sizes)), pager(makePager(path, budget)) {}
+
+
+    static const std::vector<std::size_t>& checked (const std::vector<std::size_t>& sizes)
+    {
+        if(sizes.size() != sizeof...(Is))
+            throw std::invalid_argument("The sizes do not match the shape of the container");
+
+        return sizes;
+    }
+
+
+    std::unique_ptr<Pager> makePager (const std::string& path, std::size_t budget) const
+    {
+        return std::make_unique<Pager>(path, dimSize[0], weights[0] * sizeof(T), budget);
+    }
+
+
+
+    /// The element at the position 'pos' of the whole container
+    reference element (std::size_t pos) const
+    {
+        return reference(*pager, pos / weights[0], pos % weights[0]);
+    }
+
+
+    /// A view of the slab in 'p'
+    //@{
+    template <typename U>
+    View<U, typename SlabShape<Shape<Is...>>::type> slabView (char* p) const
+    {
+        return slabView<U>(p, std::integral_constant<bool, bool(Size)>());
+    }
+
+    template <typename U>
+    View<U, typename SlabShape<Shape<Is...>>::type> slabView (char* p, std::true_type) const
+    {
+        return View<U, typename SlabShape<Shape<Is...>>::type>(reinterpret_cast<U*>(p));
+    }
+
+    template <typename U>
+    View<U, typename SlabShape<Shape<Is...>>::type> slabView (char* p, std::false_type) const
+    {
+        return View<U, typename SlabShape<Shape<Is...>>::type>(reinterpret_cast<U*>(p), std::next(dimSize.begin()), dimSize.end());
+    }
+    //@}
+
+
+
+    std::unique_ptr<Pager> pager;      /// The slabs of the scratch file
+};
+
+
+} // namespace help
+
+
+
+/** A container paged to a scratch file under a memory budget, given in bytes. For example,
+  * 'PagedContainer<double, 0, 0, 0> a("scratch.bin", 1 << 28, 1000, 1000, 1000)' keeps at most
+  * 32 of its 1000 slabs of 8 MB in memory.
+*/
+template <typename T, std::size_t... Is>
+using PagedContainer = help::Paged<T, Shape<Is...>>;
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_PAGED_H
@@ -0,0 +1,649 @@
+/** \file Parallel.h
+  *
+  * Parallel algorithms over 'Container', 'Slice' and 'ContainerView':
+  *
+  *     cnt::Container<float> a(cnt::uninitialized, 512, 512, 512), b(512, 512, 512);
+  *
+  *     cnt::parallel_fill(a, 1.0f);                // The first touch of the pages is in parallel
+  *     cnt::parallel_transform(a, b, [](float x){ return 2.0f * x; });
+  *     cnt::parallel_for_each(b.slice(3), [](float& x){ x = 0.0f; });
+  *     float s = cnt::parallel_reduce(b, 0.0f);
+  *
+  * The elements are split along the outermost dimension into blocks of consecutive rows, so
+  * each task works on a contiguous range of memory. The blocks are run by a 'ThreadPool' with
+  * work stealing, so blocks whose elements are more expensive than others are balanced. With
+  * 'Schedule::fixed' each thread always gets the same blocks instead, the ones it wrote in
+  * 'parallel_fill':
+  *
+  *     cnt::parallel_for_each(a, [](float& x){ x += 1.0f; }, cnt::Schedule::fixed);
+*/
+
+#ifndef CNT_PARALLEL_H
+#define CNT_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Container.h"
+
+
+namespace cnt
+{
+
+
+/** How the parallel algorithms give the blocks of rows to the threads. With 'dynamic' they are
+  * balanced by work stealing, so which thread runs a block changes from call to call. With
+  * 'fixed' the blocks are split in one contiguous part per thread, and each part always goes to
+  * the same thread (see 'ThreadPool::parallelForFixed').
+*/
+enum class Schedule { dynamic, fixed };
+
+
+
+/** A pool of threads, each with its own double ended queue of tasks. A thread takes the newest
+  * task of its own queue and, when it is empty, steals the oldest task of another queue. The
+  * thread that calls 'parallelFor' also runs tasks until its range is done, so calls can be
+  * nested without deadlocks.
+*/
+class ThreadPool
+{
+public:
+
+
+    /** Runs the tasks in 'numThreads' threads, counting the one calling 'parallelFor'. With a
+      * single thread everything runs in the calling thread.
+    */
+    explicit ThreadPool (std::size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u)) :
+                         queues(std::max<std::size_t>(numThreads, 1))
+    {
+        for(auto& queue : queues)
+            queue = std::make_unique<Queue>();
+
+        for(std::size_t i = 0; i + 1 < queues.size(); ++i)
+            threads.emplace_back([this, i]{ work(i); });
+    }
+
+
+    ~ThreadPool ()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            stop = true;
+
+            for(auto& queue : queues)
+                queue->wake.notify_all();
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+
+    ThreadPool (const ThreadPool&) = delete;
+
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+
+
+    /// The pool used by the parallel algorithms, with one thread per core
+    static ThreadPool& global ()
+    {
+        static ThreadPool pool;
+
+        return pool;
+    }
+
+
+    /// Number of threads running tasks, counting the calling one
+    std::size_t size () const { return queues.size(); }
+
+
+
+    /** Calls 'f(first, last)' for disjoint ranges that cover '[begin, end)', with at most 'grain'
+      * positions each, and returns when all of them are done. The range is split in halves
+      * recursively, so a thread stealing a task takes the largest range left. The first
+      * exception thrown by 'f' is rethrown here.
+    */
+    template <class F>
+    void parallelFor (std::size_t begin, std::size_t end, std::size_t grain, F f)
+    {
+        if(begin >= end)
+            return;
+
+        Group group;
+
+        group.run([&]{ split(group, begin, end, std::max<std::size_t>(grain, 1), f); });
+
+        const std::size_t self = index();
+
+        while(group.pending)
+            if(!runOne(self))
+                std::this_thread::yield();
+
+        if(group.error)
+            std::rethrow_exception(group.error);
+    }
+
+
+    /** Calls 'f(first, last)' for the 'size()' contiguous parts of equal length of '[begin, end)'.
+      * The part 't' is run by the thread 't' of the pool and the last one by the calling thread,
+      * and they are never stolen, so two calls over the same range give each position to the
+      * same thread. If the calling thread is itself in the pool, it also runs the last part.
+      * The first exception thrown by 'f' is rethrown here.
+    */
+    template <class F>
+    void parallelForFixed (std::size_t begin, std::size_t end, F f)
+    {
+        if(begin >= end)
+            return;
+
+        Group group;
+
+        const std::size_t n = queues.size(), self = index();
+
+        auto part = [&](std::size_t t){ return begin + (end - begin) * t / n; };
+
+        auto run = [&](std::size_t t){
+            if(part(t) < part(t + 1))
+                group.run([&]{ f(part(t), part(t + 1)); });
+        };
+
+        for(std::size_t t = 0; t + 1 < n; ++t)
+            if(t != self)
+            {
+                ++group.pending;
+
+                pushTo(t, [&group, &run, t]{
+                    run(t);
+                    --group.pending;
+                });
+            }
+
+        if(self + 1 < n)
+            run(self);
+
+        run(n - 1);
+
+        while(group.pending)
+            if(!runOne(self))
+                std::this_thread::yield();
+
+        if(group.error)
+            std::rethrow_exception(group.error);
+    }
+
+
+
+private:
+
+
+    /** The queue of tasks of a thread, and the tasks that only this thread can run. The thread
+      * sleeps on 'wake', with 'sleeping' set, both protected by the mutex of the pool.
+    */
+    struct Queue
+    {
+        std::mutex mutex;
+
+        std::deque<std::function<void()>> tasks;
+
+        std::deque<std::function<void()>> pinned;
+
+        std::atomic<std::size_t> numPinned{0};      /// Tasks waiting in 'pinned'
+
+        std::condition_variable wake;
+
+        bool sleeping = false;
+    };
+
+
+    /// The tasks of a call to 'parallelFor'
+    struct Group
+    {
+        /// Runs 'task', keeping the first exception thrown. After an error the tasks are skipped.
+        template <class Task>
+        void run (Task task)
+        {
+            if(failed)
+                return;
+
+            try
+            {
+                task();
+            }
+
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if(!failed.exchange(true))
+                    error = std::current_exception();
+            }
+        }
+
+
+        std::atomic<std::size_t> pending{0};    /// Tasks pushed and not yet finished
+
+        std::atomic<bool> failed{false};
+
+        std::mutex mutex;
+
+        std::exception_ptr error;
+    };
+
+
+
+    /// Pushes the second half of the range while it is larger than 'grain', and runs the first
+    template <class F>
+    void split (Group& group, std::size_t first, std::size_t last, std::size_t grain, const F& f)
+    {
+        while(last - first > grain)
+        {
+            const std::size_t middle = first + (last - first) / 2;
+
+            ++group.pending;
+
+            push([this, &group, &f, middle, last, grain]{
+                group.run([&]{ split(group, middle, last, grain, f); });
+                --group.pending;
+            });
+
+            last = middle;
+        }
+
+        f(first, last);
+    }
+
+
+    /// Pushes a task to the queue of the calling thread
+    void push (std::function<void()> task)
+    {
+        ++queued;
+
+        {
+            auto& queue = *queues[index()];
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            queue.tasks.push_back(std::move(task));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for(auto& queue : queues)
+            if(queue->sleeping)
+            {
+                queue->sleeping = false;
+                queue->wake.notify_one();
+
+                break;
+            }
+    }
+
+
+    /// Pushes a task that only the thread 't' can run
+    void pushTo (std::size_t t, std::function<void()> task)
+    {
+        auto& queue = *queues[t];
+
+        ++queue.numPinned;
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            queue.pinned.push_back(std::move(task));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        queue.sleeping = false;
+        queue.wake.notify_one();
+    }
+
+
+    /** Runs the oldest pinned task of the queue 'self', the newest task of the queue 'self' or
+      * steals the oldest task of another one
+    */
+    bool runOne (std::size_t self)
+    {
+        std::function<void()> task;
+
+        {
+            auto& queue = *queues[self];
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if(!queue.pinned.empty())
+            {
+                task = std::move(queue.pinned.front());
+                queue.pinned.pop_front();
+
+                --queue.numPinned;
+            }
+        }
+
+        if(task)
+        {
+            task();
+
+            return true;
+        }
+
+
+        for(std::size_t i = 0; i < queues.size() && !task; ++i)
+        {
+            auto& queue = *queues[(self + i) % queues.size()];
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if(queue.tasks.empty())
+                continue;
+
+            if(i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+
+        if(!task)
+            return false;
+
+        --queued;
+
+        task();
+
+        return true;
+    }
+
+
+    /** The loop of each thread of the pool, sleeping while there are no tasks it can run: the
+      * tasks of any queue and the ones pinned to this thread. A thread is woken only by a task
+      * it can run, so the tasks pinned to a busy thread do not wake the others.
+    */
+    void work (std::size_t i)
+    {
+        current() = std::make_pair(this, i);
+
+        auto& queue = *queues[i];
+
+        while(true)
+        {
+            if(runOne(i))
+                continue;
+
+            std::unique_lock<std::mutex> lock(mutex);
+
+            queue.sleeping = true;
+
+            queue.wake.wait(lock, [&]{ return stop || queued || queue.numPinned; });
+
+            queue.sleeping = false;
+
+            if(stop && !queued && !queue.numPinned)
+                return;
+        }
+    }
+
+
+    /** The pool and the queue of the calling thread. The threads that are not from the pool
+      * share the last queue.
+    */
+    //@{
+    static std::pair<const ThreadPool*, std::size_t>& current ()
+    {
+        thread_local std::pair<const ThreadPool*, std::size_t> poolIndex(nullptr, 0);
+
+        return poolIndex;
+    }
+
+    std::size_t index () const
+    {
+        return current().first == this ? current().second : queues.size() - 1;
+    }
+    //@}
+
+
+
+    std::vector<std::unique_ptr<Queue>> queues;     /// One queue per thread
+
+    std::vector<std::thread> threads;               /// All threads but the calling one
+
+
+    std::atomic<std::size_t> queued{0};             /// Tasks waiting in the queues, not counting the pinned ones
+
+    std::mutex mutex;                               /// Protects 'stop' and the sleeping state of the threads
+
+    bool stop = false;
+
+};
+
+
+
+
+namespace help
+{
+
+
+/// Size in bytes of a cache line
+constexpr std::size_t cacheLineSize = 64;
+
+
+/// Greatest common divisor
+inline std::size_t gcd (std::size_t a, std::size_t b)
+{
+    while(b)
+        a = std::exchange(b, a % b);
+
+    return a;
+}
+
+
+
+/** The rows of the outermost dimension of a container, grouped in blocks. The rows are the
+  * consecutive ranges of 'rowSize' elements given by the weight of the first dimension. The
+  * number of rows per block makes the boundaries of the blocks fall on different cache lines,
+  * if the first element is aligned, so two threads never write to the same line.
+*/
+struct RowBlocks
+{
+    template <class C>
+    RowBlocks (const C& c, std::size_t elementSize)
+    {
+        const std::size_t n = c.size();
+
+        rows = n ? c.size(0) : 0;
+
+        rowSize = rows ? n / rows : 0;
+
+        rowsPerBlock = rowSize ? cacheLineSize / gcd(rowSize * elementSize, cacheLineSize) : 1;
+
+        numBlocks = (rows + rowsPerBlock - 1) / rowsPerBlock;
+    }
+
+
+    /// Position of the first element of the block 'b'
+    std::size_t first (std::size_t b) const { return std::min(b * rowsPerBlock, rows) * rowSize; }
+
+
+    /// A grain giving a few blocks per thread, for the threads that finish first to steal
+    std::size_t grain (const ThreadPool& pool) const
+    {
+        return std::max<std::size_t>(numBlocks / (8 * pool.size()), 1);
+    }
+
+
+    std::size_t rows;
+
+    std::size_t rowSize;
+
+    std::size_t rowsPerBlock;
+
+    std::size_t numBlocks;
+};
+
+
+
+/// Calls 'f(first, last)' in parallel for ranges of the indices of 'blocks', with the given schedule
+template <class F>
+void forBlocks (const RowBlocks& blocks, Schedule schedule, F f)
+{
+    auto& pool = ThreadPool::global();
+
+    if(schedule == Schedule::fixed)
+        pool.parallelForFixed(0, blocks.numBlocks, f);
+
+    else
+        pool.parallelFor(0, blocks.numBlocks, blocks.grain(pool), f);
+}
+
+
+/** Calls 'f(first, last)' in parallel for ranges of positions of 'c' made of whole blocks */
+template <class C, class F>
+void parallelBlocks (const C& c, std::size_t elementSize, F f, Schedule schedule = Schedule::dynamic)
+{
+    const RowBlocks blocks(c, elementSize);
+
+    forBlocks(blocks, schedule, [&](std::size_t first, std::size_t last){
+        f(blocks.first(first), blocks.first(last));
+    });
+}
+
+
+} // namespace help
+
+
+
+
+/** Parallel versions of the algorithms of the standard library. The containers must have
+  * contiguous elements and the same layout, and the destination can be a temporary like
+  * 'c.slice(2)'. The last argument is the 'Schedule' of the blocks.
+*/
+//@{
+
+/** Assigns 'value' to each element of 'c', always with 'Schedule::fixed'. On a container made
+  * with 'uninitialized', each page is first written by the thread filling its part, and the
+  * operating system places it on the memory node of that thread. The threads are not pinned to
+  * cores, so the locality of the later loops with 'Schedule::fixed' over a container of the same
+  * size is only best effort, as the operating system may move the threads.
+*/
+template <class C, typename T>
+void parallel_fill (C&& c, const T& value)
+{
+    auto* p = help::mutableData(c);
+
+    help::parallelBlocks(c, sizeof(*p), [&](std::size_t first, std::size_t last){
+        std::fill(p + first, p + last, value);
+    }, Schedule::fixed);
+}
+
+
+/// Calls 'f(x)' for each element 'x' of 'c', in no specific order
+template <class C, class F>
+void parallel_for_each (C&& c, F f, Schedule schedule = Schedule::dynamic)
+{
+    auto* p = help::mutableData(c);
+
+    help::parallelBlocks(c, sizeof(*p), [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i)
+            f(p[i]);
+    }, schedule);
+}
+
+
+/// 'out[i] = f(a[i])' for each position 'i'. The sizes must be the same.
+template <class A, class C, class F>
+void parallel_transform (const A& a, C&& out, F f, Schedule schedule = Schedule::dynamic)
+{
+    static_assert(std::is_same<help::LayoutOf<A>, help::LayoutOf<C>>::value, "The layouts of the containers are different");
+
+    if(a.size() != out.size())
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    const auto* p = help::constData(a);
+    auto* q = help::mutableData(out);
+
+    help::parallelBlocks(out, sizeof(*q), [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i)
+            q[i] = f(p[i]);
+    }, schedule);
+}
+
+
+/// 'out[i] = f(a[i], b[i])' for each position 'i'. The sizes must be the same.
+template <class A, class B, class C, class F>
+void parallel_transform (const A& a, const B& b, C&& out, F f, Schedule schedule = Schedule::dynamic)
+{
+    static_assert(std::is_same<help::LayoutOf<A>, help::LayoutOf<C>>::value &&
+                  std::is_same<help::LayoutOf<B>, help::LayoutOf<C>>::value, "The layouts of the containers are different");
+
+    if(a.size() != out.size() || b.size() != out.size())
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    const auto* p = help::constData(a);
+    const auto* q = help::constData(b);
+    auto* r = help::mutableData(out);
+
+    help::parallelBlocks(out, sizeof(*r), [&](std::size_t first, std::size_t last){
+        for(std::size_t i = first; i < last; ++i)
+            r[i] = f(p[i], q[i]);
+    }, schedule);
+}
+
+
+/** Reduces the elements of 'c' with 'op', starting from 'init'. Each block is reduced in
+  * order, and the results of the blocks are combined in the order of the blocks, so 'op' must
+  * be associative but does not need to be commutative. For a given size and number of threads
+  * the result is always the same.
+*/
+template <class C, typename T, class Op = std::plus<>>
+T parallel_reduce (const C& c, T init, Op op = Op(), Schedule schedule = Schedule::dynamic)
+{
+    const auto* p = help::constData(c);
+
+    const help::RowBlocks blocks(c, sizeof(*p));
+
+    std::vector<T> partial(blocks.numBlocks, init);
+    std::vector<char> done(blocks.numBlocks, 0);
+
+    help::forBlocks(blocks, schedule, [&](std::size_t first, std::size_t last){
+        const std::size_t begin = blocks.first(first), end = blocks.first(last);
+
+        if(begin == end)
+            return;
+
+        T r = p[begin];
+
+        for(std::size_t i = begin + 1; i < end; ++i)
+            r = op(r, p[i]);
+
+        partial[first] = r;
+        done[first] = 1;
+    });
+
+
+    for(std::size_t b = 0; b < blocks.numBlocks; ++b)
+        if(done[b])
+            init = op(init, partial[b]);
+
+    return init;
+}
+//@}
+
+
+} // namespace cnt
+
+
+#endif // CNT_PARALLEL_H
@@ -0,0 +1,286 @@
+/** \file Permute.h
+  *
+  * Reordering of the dimensions of a container, like a transpose or 'NCHW' to 'NHWC':
+  *
+  *     cnt::Container<float> c(8, 3, 224, 224);
+  *
+  *     auto v = cnt::permuted(c, {0, 2, 3, 1});     // A view of 8 x 224 x 224 x 3, without copying
+  *     auto d = cnt::permute(c, {0, 2, 3, 1});      // A new row major container of 8 x 224 x 224 x 3
+  *
+  * The dimension 'k' of the result is the dimension 'perm[k]' of the source.
+*/
+
+#ifndef CNT_PERMUTE_H
+#define CNT_PERMUTE_H
+
+#include "Strided.h"
+
+
+#if defined(__SSE2__)
+    #define CNT_PERMUTE_SSE
+    #include <xmmintrin.h>
+#endif
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+/// Throws 'std::invalid_argument' if 'perm' is not a permutation of '0, ..., N - 1'
+template <std::size_t N>
+void checkPermutation (const std::size_t (&perm)[N])
+{
+    std::array<bool, N> seen{};
+
+    for(std::size_t k = 0; k < N; ++k)
+    {
+        if(perm[k] >= N || seen[perm[k]])
+            throw std::invalid_argument("The dimensions must be a permutation");
+
+        seen[perm[k]] = true;
+    }
+}
+
+
+
+/// If the elements can be moved as the 4 lanes of a SSE register
+template <typename T, typename U>
+struct Transposable : std::integral_constant<bool,
+#ifdef CNT_PERMUTE_SSE
+    std::is_same<std::remove_const_t<T>, U>::value && sizeof(U) == sizeof(float) && std::is_trivially_copyable<U>::value
+#else
+    false
+#endif
+> {};
+
+
+
+/** Copies a block of at most 'blockSize x blockSize' elements of 'copyPlane'. If the block is a
+  * transpose, that is, the rows are contiguous in 'src' and the columns in 'dst', elements of 4
+  * bytes are moved by 4 x 4 blocks, transposed in SSE registers. The rest is copied one by one.
+*/
+//@{
+template <typename T, typename U>
+void copyBlock (const T* src, std::size_t srcRow, std::size_t srcCol,
+                U* dst, std::size_t dstRow, std::size_t dstCol, std::size_t rows, std::size_t cols, std::false_type)
+{
+    for(std::size_t i = 0; i < rows; ++i)
+        for(std::size_t j = 0; j < cols; ++j)
+            dst[i * dstRow + j * dstCol] = src[i * srcRow + j * srcCol];
+}
+
+#ifdef CNT_PERMUTE_SSE
+template <typename T, typename U>
+void copyBlock (const T* src, std::size_t srcRow, std::size_t srcCol,
+                U* dst, std::size_t dstRow, std::size_t dstCol, std::size_t rows, std::size_t cols, std::true_type)
+{
+    if(srcRow != 1 || dstCol != 1)
+        return copyBlock(src, srcRow, srcCol, dst, dstRow, dstCol, rows, cols, std::false_type());
+
+
+    const std::size_t rows4 = rows & ~std::size_t(3), cols4 = cols & ~std::size_t(3);
+
+    for(std::size_t i = 0; i < rows4; i += 4)
+        for(std::size_t j = 0; j < cols4; j += 4)
+        {
+            const float* s = reinterpret_cast<const float*>(src + i + j * srcCol);
+            float* d = reinterpret_cast<float*>(dst + i * dstRow + j);
+
+            __m128 r0 = _mm_loadu_ps(s);
+            __m128 r1 = _mm_loadu_ps(s + srcCol);
+            __m128 r2 = _mm_loadu_ps(s + 2 * srcCol);
+            __m128 r3 = _mm_loadu_ps(s + 3 * srcCol);
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(d, r0);
+            _mm_storeu_ps(d + dstRow, r1);
+            _mm_storeu_ps(d + 2 * dstRow, r2);
+            _mm_storeu_ps(d + 3 * dstRow, r3);
+        }
+
+
+    copyBlock(src + cols4 * srcCol, 1, srcCol, dst + cols4, dstRow, 1, rows, cols - cols4, std::false_type());
+    copyBlock(src + rows4, 1, srcCol, dst + rows4 * dstRow, dstRow, 1, rows - rows4, cols4, std::false_type());
+}
+#endif
+//@}
+
+
+
+/** Copies the 'rows x cols' plane with strides 'srcRow' and 'srcCol' in 'src' to the plane with
+  * strides 'dstRow' and 'dstCol' in 'dst', by blocks of 'blockSize x blockSize' that fit in the
+  * L1 cache on both sides. The blocks of a row of blocks are consecutive in the columns, so the
+  * side where the columns are contiguous is traversed in order, which the prefetchers follow.
+*/
+template <typename T, typename U>
+void copyPlane (const T* src, std::size_t srcRow, std::size_t srcCol,
+                U* dst, std::size_t dstRow, std::size_t dstCol, std::size_t rows, std::size_t cols)
+{
+    constexpr std::size_t blockSize = 16;
+
+    for(std::size_t i = 0; i < rows; i += blockSize)
+        for(std::size_t j = 0; j < cols; j += blockSize)
+            copyBlock(src + i * srcRow + j * srcCol, srcRow, srcCol, dst + i * dstRow + j * dstCol, dstRow, dstCol,
+                      std::min(blockSize, rows - i), std::min(blockSize, cols - j),
+                      std::integral_constant<bool, Transposable<T, U>::value>());
+}
+
+
+
+/** Copies the strided view 'v' to the row major elements starting at 'dst'. The copy is done by
+  * planes made of the last dimension, contiguous in 'dst', and the dimension with the smallest
+  * stride in 'v', so each plane is a transpose of two dimensions contiguous on each side. The
+  * other dimensions are traversed incrementally around the planes.
+*/
+template <typename T, typename U, std::size_t N>
+void copyStrided (const StridedView<T, N>& v, U* dst)
+{
+    const auto& sizes = v.sizes();
+    const auto& strides = v.strides();
+
+    if(!v.size())
+        return;
+
+
+    std::array<std::size_t, N> weights;
+
+    weights[N-1] = 1;
+
+    for(std::size_t k = N-1; k-- > 0;)
+        weights[k] = weights[k+1] * sizes[k+1];
+
+
+    const std::size_t b = N - 1;
+
+    std::size_t a = N;
+
+    for(std::size_t k = 0; k + 1 < N; ++k)
+        if(sizes[k] > 1 && (a == N || strides[k] < strides[a]))
+            a = k;
+
+    const std::size_t rows = a < N ? sizes[a] : 1;
+    const std::size_t srcRow = a < N ? strides[a] : 0, dstRow = a < N ? weights[a] : 0;
+
+
+    std::array<std::size_t, N> index{};
+
+    const T* p = v.data();
+
+    while(true)
+    {
+        copyPlane(p, srcRow, strides[b], dst, dstRow, weights[b], rows, sizes[b]);
+
+        std::size_t k = b;
+
+        while(k-- > 0)
+        {
+            if(k == a)
+                continue;
+
+            p += strides[k];
+            dst += weights[k];
+
+            if(++index[k] < sizes[k])
+                break;
+
+            p -= index[k] * strides[k];
+            dst -= index[k] * weights[k];
+
+            index[k] = 0;
+        }
+
+        if(k >= b)
+            return;
+    }
+}
+
+
+} // namespace help
+
+
+
+/** A view of 'c' with the dimension 'k' being the dimension 'perm[k]' of 'c', made by permuting
+  * the sizes and the strides. The source can be a 'Container' in row or column major order, a
+  * 'ContainerView' or a 'StridedView'. Throws 'std::invalid_argument' if 'perm' is not a
+  * permutation, or if it does not have a position for each dimension of 'c'.
+*/
+template <class C, std::size_t N>
+auto permuted (C& c, const std::size_t (&perm)[N])
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    constexpr std::size_t R = help::staticRank<std::decay_t<C>>;
+
+    static_assert(!R || R == N, "There must be a position for each dimension");
+
+
+    const auto sizes = c.sizes();
+    const auto strides = c.strides();
+
+    if(sizes.size() != N)
+        throw std::invalid_argument("There must be a position for each dimension");
+
+    help::checkPermutation(perm);
+
+
+    std::array<std::size_t, N> newSizes, newStrides;
+
+    for(std::size_t k = 0; k < N; ++k)
+    {
+        newSizes[k] = sizes[perm[k]];
+        newStrides[k] = strides[perm[k]];
+    }
+
+    return StridedView<T, N>(c.data(), newSizes, newStrides);
+}
+
+
+
+/** A new row major container with the elements of 'permuted(c, perm)'. The number of dimensions
+  * is fixed and their sizes are given at runtime, like in 'Container<T, 0, 0, 0>'. The copy is
+  * blocked (see 'help::copyStrided'), so it runs close to the memory bandwidth even when the
+  * contiguous dimension changes.
+*/
+template <class C, std::size_t N>
+auto permute (const C& c, const std::size_t (&perm)[N])
+{
+    using T = std::decay_t<decltype(*c.data())>;
+
+    const auto v = permuted(c, perm);
+
+    BasicContainer<T, help::ZeroShape<N>> res(uninitialized, v.sizes().begin(), v.sizes().end());
+
+    help::copyStrided(v, res.data());
+
+    return res;
+}
+
+
+/** The same, but writing to the row major container 'out', which must have the sizes of
+  * 'permuted(c, perm)', so its memory can be reused. Throws 'std::invalid_argument' otherwise.
+*/
+template <class C, std::size_t N, class D>
+void permute (const C& c, const std::size_t (&perm)[N], D&& out)
+{
+    static_assert(help::isRowMajor<help::LayoutOf<D>>, "The destination must be row major");
+
+    const auto v = permuted(c, perm);
+
+    const auto sizes = out.sizes();
+
+    if(out.size() != v.size() || !std::equal(sizes.begin(), sizes.end(), v.sizes().begin(), v.sizes().end()))
+        throw std::invalid_argument("The sizes of the containers are different");
+
+    help::copyStrided(v, help::mutableData(out));
+}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_PERMUTE_H
@@ -0,0 +1,502 @@
+/** \file Reduce.h
+  *
+  * Reductions along some dimensions of a container:
+  *
+  *     cnt::Container<float, 0, 0, 0> c(64, 128, 256);
+  *
+  *     auto s = cnt::reduce(c, 1, cnt::Sum());             // 64 x 256
+  *     auto m = cnt::reduce(c, {0, 2}, cnt::Max());        // 128
+  *     auto i = cnt::reduce(c, 2, cnt::ArgMax());          // 64 x 128, of 'std::size_t'
+  *
+  * The result is a new row major container with the dimensions that were not reduced, in the
+  * same order. The way the elements are read depends on their strides:
+  *
+  *   - If the reduced dimensions are the last ones and their elements are contiguous, each
+  *     result is the reduction of a contiguous range, done by the vectorized kernels of
+  *     'Kernels.h'.
+  *
+  *   - Otherwise the results are computed a row at a time, along the kept dimension with the
+  *     smallest stride. For each position of the reduced dimensions the row of elements is
+  *     combined with a row of accumulators, in a loop that the compiler vectorizes, so each
+  *     element is read once and in the order of the memory when that dimension is contiguous.
+  *
+  * The results or the rows are split among the threads of 'ThreadPool::global()'.
+*/
+
+#ifndef CNT_REDUCE_H
+#define CNT_REDUCE_H
+
+#include "Strided.h"
+#include "Parallel.h"
+#include "Kernels.h"
+
+
+namespace cnt
+{
+
+
+/** The reductions of 'reduce'. 'Mean' is a 'double' for integral elements, and 'ArgMin' and
+  * 'ArgMax' give the position of the first minimum or maximum, as a 'std::size_t'. If there are
+  * several reduced dimensions, the position is the row major index over them.
+*/
+//@{
+struct Sum {};
+
+struct Mean {};
+
+struct Min {};
+
+struct Max {};
+
+struct ArgMin {};
+
+struct ArgMax {};
+//@}
+
+
+
+
+namespace help
+{
+
+
+/** How each reduction accumulates the elements. 'Value' is the accumulated value, 'first' sets
+  * it from the first element, 'combine' adds the element 'x' at position 'r' and 'result' gives
+  * the result after 'count' elements. 'run' reduces 'n' contiguous elements at once.
+*/
+//@{
+template <class Op, typename T>
+struct Reducer;
+
+
+template <typename T>
+struct Reducer<Sum, T>
+{
+    using Value = T;
+
+    using Result = T;
+
+
+    static Value first (T x) { return x; }
+
+    static void combine (Value& v, std::size_t&, T x, std::size_t) { v += x; }
+
+    static Result result (Value v, std::size_t, std::size_t) { return v; }
+
+    static Result empty () { return T(0); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        return simd::dispatch([&](auto isa){ return decltype(isa)::sum(p, n); });
+    }
+};
+
+
+template <typename T>
+struct Reducer<Mean, T>
+{
+    using Value = std::conditional_t<std::is_integral<T>::value, double, T>;
+
+    using Result = Value;
+
+
+    static Value first (T x) { return Value(x); }
+
+    static void combine (Value& v, std::size_t&, T x, std::size_t) { v += Value(x); }
+
+    static Result result (Value v, std::size_t, std::size_t count) { return v / Value(count); }
+
+    static Result empty () { throw std::invalid_argument("The mean of an empty range is not defined"); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        return run(p, n, std::is_integral<T>());
+    }
+
+    static Result run (const T* p, std::size_t n, std::false_type)
+    {
+        return Reducer<Sum, T>::run(p, n) / Value(n);
+    }
+
+    static Result run (const T* p, std::size_t n, std::true_type)
+    {
+        Value v = 0;
+
+        for(std::size_t i = 0; i < n; ++i)
+            v += Value(p[i]);
+
+        return v / Value(n);
+    }
+};
+
+
+template <typename T>
+struct Reducer<Min, T>
+{
+    using Value = T;
+
+    using Result = T;
+
+
+    static Value first (T x) { return x; }
+
+    static void combine (Value& v, std::size_t&, T x, std::size_t) { v = x < v ? x : v; }
+
+    static Result result (Value v, std::size_t, std::size_t) { return v; }
+
+    static Result empty () { throw std::invalid_argument("The minimum of an empty range is not defined"); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        return simd::dispatch([&](auto isa){ return decltype(isa)::min(p, n); });
+    }
+};
+
+
+template <typename T>
+struct Reducer<Max, T>
+{
+    using Value = T;
+
+    using Result = T;
+
+
+    static Value first (T x) { return x; }
+
+    static void combine (Value& v, std::size_t&, T x, std::size_t) { v = v < x ? x : v; }
+
+    static Result result (Value v, std::size_t, std::size_t) { return v; }
+
+    static Result empty () { throw std::invalid_argument("The maximum of an empty range is not defined"); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        return simd::dispatch([&](auto isa){ return decltype(isa)::max(p, n); });
+    }
+};
+
+
+template <typename T>
+struct Reducer<ArgMin, T>
+{
+    using Value = T;
+
+    using Result = std::size_t;
+
+
+    static Value first (T x) { return x; }
+
+    static void combine (Value& v, std::size_t& i, T x, std::size_t r)
+    {
+        const bool smaller = x < v;
+
+        v = smaller ? x : v;
+        i = smaller ? r : i;
+    }
+
+    static Result result (Value, std::size_t i, std::size_t) { return i; }
+
+    static Result empty () { throw std::invalid_argument("The minimum of an empty range is not defined"); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t j = 1; j < n; ++j)
+            if(p[j] < p[i])
+                i = j;
+
+        return i;
+    }
+};
+
+
+template <typename T>
+struct Reducer<ArgMax, T>
+{
+    using Value = T;
+
+    using Result = std::size_t;
+
+
+    static Value first (T x) { return x; }
+
+    static void combine (Value& v, std::size_t& i, T x, std::size_t r)
+    {
+        const bool greater = v < x;
+
+        v = greater ? x : v;
+        i = greater ? r : i;
+    }
+
+    static Result result (Value, std::size_t i, std::size_t) { return i; }
+
+    static Result empty () { throw std::invalid_argument("The maximum of an empty range is not defined"); }
+
+
+    static Result run (const T* p, std::size_t n)
+    {
+        std::size_t i = 0;
+
+        for(std::size_t j = 1; j < n; ++j)
+            if(p[i] < p[j])
+                i = j;
+
+        return i;
+    }
+};
+//@}
+
+
+
+/** Sets 'v[j]' from or combines it with 'p[j * stride]' for 'j' in '[0, n)', with a loop for
+  * contiguous rows. 'r' is the position of the row among the reduced ones.
+*/
+template <class Red, bool Contiguous, typename T>
+void reduceRow (typename Red::Value* v, std::size_t* idx, const T* p, std::ptrdiff_t stride, std::size_t n,
+                std::size_t r)
+{
+    if(!r)
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            v[j] = Red::first(p[Contiguous ? std::ptrdiff_t(j) : std::ptrdiff_t(j) * stride]);
+            idx[j] = 0;
+        }
+
+    else
+        for(std::size_t j = 0; j < n; ++j)
+            Red::combine(v[j], idx[j], p[Contiguous ? std::ptrdiff_t(j) : std::ptrdiff_t(j) * stride], r);
+}
+
+
+
+/// The dimensions of a strided source, as their sizes and strides
+struct StridedDims
+{
+    std::vector<std::size_t> sizes;
+
+    std::vector<std::size_t> strides;
+
+
+    /// Number of positions
+    std::size_t count () const
+    {
+        return std::accumulate(sizes.begin(), sizes.end(), std::size_t(1), std::multiplies<std::size_t>());
+    }
+
+
+    /// Offset of the position 't' in row major order
+    std::ptrdiff_t offset (std::size_t t) const
+    {
+        std::ptrdiff_t res = 0;
+
+        for(std::size_t k = sizes.size(); k-- > 0; t /= sizes[k])
+            res += std::ptrdiff_t(t % sizes[k]) * std::ptrdiff_t(strides[k]);
+
+        return res;
+    }
+};
+
+
+
+/** Reduces the elements starting at 'data' over the dimensions 'reduced' for each position of
+  * the dimensions 'kept', writing the results in row major order over 'kept' to 'out'.
+*/
+template <class Red, typename T>
+void reduceStrided (const T* data, const StridedDims& kept, const StridedDims& reduced, typename Red::Result* out)
+{
+    const std::size_t numResults = kept.count(), count = reduced.count();
+
+    if(!numResults)
+        return;
+
+    if(!count)
+        return std::fill(out, out + numResults, Red::empty());
+
+
+    auto& pool = ThreadPool::global();
+
+
+    /// The reduced elements of each result are contiguous
+    bool contiguous = true;
+
+    for(std::size_t k = reduced.sizes.size(), stride = 1; k-- > 0; stride *= reduced.sizes[k])
+        contiguous = contiguous && reduced.strides[k] == stride;
+
+    if(contiguous)
+    {
+        const std::size_t grain = std::max<std::size_t>(numResults / (8 * pool.size()), 1);
+
+        pool.parallelFor(0, numResults, grain, [&](std::size_t first, std::size_t last){
+            for(std::size_t t = first; t < last; ++t)
+                out[t] = Red::run(data + kept.offset(t), count);
+        });
+
+        return;
+    }
+
+
+    /// The rows go along the kept dimension 'v' with the smallest stride, in chunks that fit in the L1 cache
+    std::size_t v = 0;
+
+    for(std::size_t k = 1; k < kept.sizes.size(); ++k)
+        if(kept.strides[k] < kept.strides[v])
+            v = k;
+
+    const std::size_t rowSize = kept.sizes[v];
+    const std::ptrdiff_t rowStride = kept.strides[v];
+
+    /// The positions of the rows, in the source and in 'out'
+    StridedDims outer = kept, target = kept;
+
+    for(std::size_t k = kept.sizes.size(), weight = 1; k-- > 0; weight *= kept.sizes[k])
+        target.strides[k] = weight;
+
+    outer.sizes[v] = target.sizes[v] = 1;
+
+    const std::size_t outStride = target.strides[v];
+
+    const std::size_t rows = outer.count();
+
+    std::size_t chunkSize = std::min<std::size_t>(rowSize, 1024);
+
+    if(rows < 8 * pool.size())
+        chunkSize = std::max<std::size_t>(std::min(chunkSize, rowSize * rows / (8 * pool.size())), 64);
+
+    const std::size_t chunks = (rowSize + chunkSize - 1) / chunkSize;
+
+
+    const std::size_t grain = std::max<std::size_t>(rows * chunks / (8 * pool.size()), 1);
+
+    pool.parallelFor(0, rows * chunks, grain, [&](std::size_t first, std::size_t last){
+        std::vector<typename Red::Value> acc(chunkSize);
+        std::vector<std::size_t> idx(chunkSize);
+
+        for(std::size_t t = first; t < last; ++t)
+        {
+            const std::size_t row = t / chunks, begin = (t % chunks) * chunkSize;
+            const std::size_t n = std::min(chunkSize, rowSize - begin);
+
+            const T* p = data + outer.offset(row) + std::ptrdiff_t(begin) * rowStride;
+
+            for(std::size_t r = 0; r < count; ++r)
+            {
+                if(rowStride == 1)
+                    reduceRow<Red, true>(acc.data(), idx.data(), p + reduced.offset(r), rowStride, n, r);
+
+                else
+                    reduceRow<Red, false>(acc.data(), idx.data(), p + reduced.offset(r), rowStride, n, r);
+            }
+
+
+            auto* q = out + target.offset(row) + begin * outStride;
+
+            for(std::size_t j = 0; j < n; ++j)
+                q[j * outStride] = Red::result(acc[j], idx[j], count);
+        }
+    });
+}
+
+
+
+/// The type of the result of 'reduce' for a source with 'N' dimensions, removing 'K' of them
+//@{
+template <typename R, std::size_t N, std::size_t K>
+struct ReduceResult
+{
+    using type = BasicContainer<R, ZeroShape<(N > K ? N - K : 1)>>;
+};
+
+template <typename R, std::size_t K>
+struct ReduceResult<R, 0, K>
+{
+    using type = cnt::Container<R>;
+};
+//@}
+
+
+} // namespace help
+
+
+
+/** Reduces 'c' along the dimensions 'axes' with one of the reductions above. The source can be
+  * anything with strides: a 'Container' in row or column major order, a 'ContainerView', a
+  * 'Slice' or a 'StridedView'. The result is a row major container with the other dimensions
+  * of 'c', or with a single dimension of size 1 if all of them are reduced. Its number of
+  * dimensions is fixed if the one of 'c' is.
+  *
+  * Throws 'std::invalid_argument' if an axis is not a dimension of 'c' or appears twice, and if
+  * the reduced dimensions are empty for the reductions other than 'Sum'.
+*/
+//@{
+template <class C, std::size_t K, class Op>
+auto reduce (const C& c, const std::size_t (&axes)[K], Op)
+{
+    using T = std::remove_const_t<std::remove_pointer_t<decltype(c.data())>>;
+
+    using Red = help::Reducer<Op, T>;
+
+    constexpr std::size_t N = help::staticRank<std::decay_t<C>>;
+
+    static_assert(!N || K <= N, "There are more axes than dimensions");
+
+
+    const auto sizes = c.sizes();
+    const auto strides = c.strides();
+
+    std::vector<bool> isReduced(sizes.size(), false);
+
+    for(auto axis : axes)
+    {
+        if(axis >= sizes.size() || isReduced[axis])
+            throw std::invalid_argument("The axes must be different dimensions of the container");
+
+        isReduced[axis] = true;
+    }
+
+
+    help::StridedDims kept, reduced;
+
+    for(std::size_t k = 0; k < sizes.size(); ++k)
+    {
+        auto& dims = isReduced[k] ? reduced : kept;
+
+        dims.sizes.push_back(sizes[k]);
+        dims.strides.push_back(strides[k]);
+    }
+
+    if(kept.sizes.empty())
+    {
+        kept.sizes.push_back(1);
+        kept.strides.push_back(0);
+    }
+
+
+    typename help::ReduceResult<typename Red::Result, N, K>::type res(uninitialized, kept.sizes.begin(), kept.sizes.end());
+
+    help::reduceStrided<Red>(c.data(), kept, reduced, res.data());
+
+    return res;
+}
+
+
+template <class C, class Op>
+auto reduce (const C& c, std::size_t axis, Op op)
+{
+    const std::size_t axes[] = { axis };
+
+    return reduce(c, axes, op);
+}
+//@}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_REDUCE_H
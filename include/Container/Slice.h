@@ -10,6 +10,9 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <iterator>
+
+#include "Layout.h"
 
 
 namespace cnt
@@ -19,6 +22,99 @@ namespace help
 {
 
 
+template <class Cnt>
+class Slice;
+
+
+
+/** Random access iterator over the elements of a 'Slice' whose layout is not row major, in the
+  * row major order of the dimensions of the slice. It keeps only the container and the position
+  * of the slice in it, so it can outlive the slice.
+*/
+template <class Cnt>
+class SliceIterator
+{
+public:
+
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = typename std::decay_t<Cnt>::value_type;
+
+    using difference_type = std::ptrdiff_t;
+
+    using reference = decltype(std::declval<Cnt&>()[0]);
+
+    using pointer = std::remove_reference_t<reference>*;
+
+    using index_type = typename std::decay_t<Cnt>::index_type;
+
+
+
+    SliceIterator () : c(nullptr), dims(0), first(0), p(0) {}
+
+    SliceIterator (Cnt& c, index_type dims, index_type first, difference_type p = 0) : c(&c), dims(dims), first(first), p(p) {}
+
+
+
+    reference operator * () const
+    {
+        return (*c)[Slice<Cnt>::position(*c, dims, first, p, std::false_type())];
+    }
+
+    pointer operator -> () const { return &**this; }
+
+    reference operator [] (difference_type n) const { return *(*this + n); }
+
+
+
+    SliceIterator& operator ++ () { ++p; return *this; }
+
+    SliceIterator& operator -- () { --p; return *this; }
+
+    SliceIterator operator ++ (int) { auto it = *this; ++p; return it; }
+
+    SliceIterator operator -- (int) { auto it = *this; --p; return it; }
+
+    SliceIterator& operator += (difference_type n) { p += n; return *this; }
+
+    SliceIterator& operator -= (difference_type n) { p -= n; return *this; }
+
+
+    friend SliceIterator operator + (SliceIterator it, difference_type n) { return it += n; }
+
+    friend SliceIterator operator + (difference_type n, SliceIterator it) { return it += n; }
+
+    friend SliceIterator operator - (SliceIterator it, difference_type n) { return it -= n; }
+
+    friend difference_type operator - (const SliceIterator& a, const SliceIterator& b) { return a.p - b.p; }
+
+
+    friend bool operator == (const SliceIterator& a, const SliceIterator& b) { return a.p == b.p; }
+
+    friend bool operator != (const SliceIterator& a, const SliceIterator& b) { return a.p != b.p; }
+
+    friend bool operator < (const SliceIterator& a, const SliceIterator& b) { return a.p < b.p; }
+
+    friend bool operator > (const SliceIterator& a, const SliceIterator& b) { return a.p > b.p; }
+
+    friend bool operator <= (const SliceIterator& a, const SliceIterator& b) { return a.p <= b.p; }
+
+    friend bool operator >= (const SliceIterator& a, const SliceIterator& b) { return a.p >= b.p; }
+
+
+private:
+
+    Cnt* c;                 /// The container of the slice
+
+    index_type dims;        /// Number of dimensions before the slice
+
+    index_type first;       /// Position of the first element of the slice
+
+    difference_type p;      /// Position in the slice
+};
+
+
+
     /** This class is just a proxy to access chosen dimensions of a container.
       * The only storage is are the positions to access and a reference to
       * the container that created this slice. There are a bunch of examples
@@ -41,6 +137,9 @@ namespace help
     using reference = typename Base::reference;
 
     using const_reference = typename Base::const_reference;
+
+    /// The integral type of the positions in the container (see 'BasicDimensions')
+    using index_type = typename Base::index_type;
     //@}
 
 
@@ -58,11 +157,11 @@ namespace help
     template <typename... Args, help::EnableIfIntegral< std::decay_t< Args >... > = 0 >
     Slice (Cnt& c, const Args&... args) : c(c), dims(sizeof...(Args)), first(0)
     {
-        auto iter = c.weights.begin();
+        std::size_t k = 0;
 
-        const auto& dummy = { (first += *iter++ * args, int{})..., int{} };
+        const auto& dummy = { (first += c.mapIndex(k++, args), int{})..., int{} };
 
-        last = first + (sizeof...(Args) ? c.weights[dims-1] : c.size());
+        last = first + remaining();
     }
 
 
@@ -71,13 +170,13 @@ namespace help
               help::EnableIfIterable< std::remove_reference_t< Args >... > = 0 >
     Slice (Cnt& c, const Args&... args) : c(c), dims(0), first(0)
     {
-        auto iter = c.weights.begin();
+        std::size_t k = 0;
+
+        const auto& dummy = { (first += increment(args, k), int{})... };
 
-        const auto& dummy = { (first += std::inner_product(args.begin(), args.end(), iter, 0), 
-                                                            iter += args.size())... };
-        dims = iter - c.weights.begin();
+        dims = k;
 
-        last = first + c.weights[dims-1];
+        last = first + remaining();
     }
 
 
@@ -85,9 +184,12 @@ namespace help
     template <typename U, typename V, help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
     Slice (Cnt& c, const U& begin, const V& end) : c(c), dims(std::distance(begin, end)), first(0)
     {
-        first = std::inner_product(begin, end, c.weights.begin(), 0);
+        std::size_t k = 0;
 
-        last = first + c.weights[dims-1];
+        for(auto iter = begin; iter != end; ++iter)
+            first += c.mapIndex(k++, *iter);
+
+        last = first + remaining();
     }
 
 
@@ -112,11 +214,9 @@ namespace help
     template <typename... Args>
     const_reference operator () (IntegralType, const Args&... args) const
     {
-        std::size_t pos = first;
-
-        auto iter = c.weights.begin() + dims;
+        std::size_t pos = first, k = dims;
 
-        const auto& dummy = { (pos += Base::increment(args, iter), int{})... };
+        const auto& dummy = { (pos += increment(args, k), int{})... };
 
         return c[pos];
     }
@@ -124,9 +224,14 @@ namespace help
 
     /// For iterators
     template <typename U, help::EnableIfIterator< std::decay_t< U >> = 0>
-    const_reference operator () (IteratorType, const U& begin) const
+    const_reference operator () (IteratorType, U begin) const
     {
-        return this->operator[](std::inner_product(c.weights.begin() + dims, c.weights.end(), begin(), first));
+        std::size_t pos = first;
+
+        for(std::size_t k = dims; k < c.numDimensions(); ++k, ++begin)
+            pos += c.mapIndex(k, *begin);
+
+        return c[pos];
     }
 
 
@@ -134,20 +239,22 @@ namespace help
     template <typename U>
     const_reference operator () (std::initializer_list<U> il) const
     {
-        return this->operator[](std::inner_product(c.weights.begin() + dims, c.weights.end(), il.begin(), 0));
+        return this->operator()(IteratorType{}, il.begin());
     }
 
 
 
 
-    /** Overloading the access via 'operator[]' */
+    /** Overloading the access via 'operator[]'. The elements are in row major order over the
+      * dimensions of the slice, even if the layout of the container is another one.
+    */
     //@{
-    const_reference operator [] (int p) const
+    const_reference operator [] (std::size_t p) const
     {
-        return c[first + p];
+        return c[position(c, dims, first, p, Contiguous())];
     }
 
-    reference operator [] (int p)
+    reference operator [] (std::size_t p)
     {
         return const_cast<reference>(static_cast<const Slice&>(*this)[p]);
     }
@@ -162,25 +269,125 @@ namespace help
     auto size () const      { return last - first; }
 
 
-    /** Begin and end */
+    /// Number of dimensions of the slice
+    std::size_t numDimensions () const { return c.numDimensions() - dims; }
+
+    /// Size of each dimension of the slice
+    std::vector<std::size_t> sizes () const
+    {
+        const auto& s = c.sizes();
+
+        return std::vector<std::size_t>(s.begin() + dims, s.end());
+    }
+
+    /// Strides of the dimensions of the slice, if the container has strides (see 'Container::strides')
+    std::vector<std::size_t> strides () const
+    {
+        const auto& s = c.strides();
+
+        return std::vector<std::size_t>(s.begin() + dims, s.end());
+    }
+
+    /// Pointer to the first element of the slice
+    auto data () const { return c.data() + first; }
+
+
+    /// Tells if the elements of the slice are a contiguous range, which is true for row major order
+    constexpr bool contiguous () const { return Contiguous::value; }
+
+
+    /** Begin and end. If the slice is not contiguous, the iterators follow the same order as
+      * 'operator[]'.
+    */
+    //@{
+    decltype(auto) begin ()        { return begin(c, Contiguous()); }
+
+    decltype(auto) cbegin () const { return begin(static_cast<const Cnt&>(c), Contiguous()); }
+
+    decltype(auto) end ()          { return begin() + size(); }
+
+    decltype(auto) cend () const   { return cbegin() + size(); }
+    //@}
+
+
+
+    /** Position in 'c' of the element 'p' of a slice with 'dims' fixed dimensions starting at
+      * 'first', computing the index of each dimension if the slice is not contiguous.
+    */
     //@{
-    decltype(auto) begin ()        { return c.begin() + first; }
+    static std::size_t position (const Cnt&, index_type, index_type first, std::size_t p, std::true_type)
+    {
+        return first + p;
+    }
+
+    static std::size_t position (const Cnt& c, index_type dims, index_type first, std::size_t p, std::false_type)
+    {
+        std::size_t pos = first;
 
-    decltype(auto) cbegin () const { return c.cbegin() + first; }
+        for(std::size_t k = c.numDimensions(); k-- > std::size_t(dims);)
+        {
+            pos += c.mapIndex(k, p % c.size(k));
 
-    decltype(auto) end ()          { return c.begin() + last; }
+            p /= c.size(k);
+        }
 
-    decltype(auto) cend () const   { return c.cbegin() + last; }
+        return pos;
+    }
     //@}
 
 
 private:
 
+
+    using Contiguous = std::integral_constant<bool, isRowMajor<LayoutOf<Cnt>>>;
+
+
+    /// Part of the position of the indices 'u', an integral or an iterable, from the dimension 'k'
+    //@{
+    template <typename U, help::EnableIfIntegral< std::decay_t< U > > = 0>
+    std::size_t increment (U u, std::size_t& k) const
+    {
+        return c.mapIndex(k++, u);
+    }
+
+    template <typename U, help::EnableIfIterable< std::decay_t< U > > = 0>
+    std::size_t increment (const U& u, std::size_t& k) const
+    {
+        std::size_t res = 0;
+
+        for(auto x : u)
+            res += c.mapIndex(k++, x);
+
+        return res;
+    }
+    //@}
+
+
+    /// Number of elements in the dimensions after the fixed ones
+    std::size_t remaining () const
+    {
+        std::size_t res = 1;
+
+        for(std::size_t k = dims; k < c.numDimensions(); ++k)
+            res *= c.size(k);
+
+        return res;
+    }
+
+
+    template <class C>
+    auto begin (C& owner, std::true_type) const { return owner.begin() + first; }
+
+    template <class C>
+    auto begin (C& owner, std::false_type) const { return SliceIterator<C>(owner, dims, first); }
+
+
+
     Cnt& c;             /// Reference to the creator container
 
-    int dims;           /// Number of dimensions BEFORE the slice
-    int first;          /// First element on the contiguous array
-    int last;           /// Last element on the contiguous array
+    index_type dims;    /// Number of dimensions BEFORE the slice
+    index_type first;   /// First element on the contiguous array
+    index_type last;    /// Last element on the contiguous array
 
 };
 
@@ -0,0 +1,617 @@
+/** \file Sparse.h
+  *
+  * A container of 'N' dimensions that stores only the elements that are not zero:
+  *
+  *     cnt::Sparse<float> s(1000, 1000, 1000);
+  *
+  *     s.insert(1.5f, 3, 4, 5);        // Entries are added in coordinate (COO) form
+  *     s.insert(2.0f, 999, 0, 7);
+  *     s.compress();                   // And queried in compressed sparse fiber (CSF) form
+  *
+  *     float x = s(3, 4, 5);           // 1.5
+  *     float y = s({1, 2, 3});         // 0, as the element is not stored
+  *
+  *     for(auto e : s)
+  *         std::cout << e.index[0] << " " << e.value << "\n";
+  *
+  * The compressed form is a tree with a level for each dimension. The nodes of a level are the
+  * distinct indices of the dimension for each path of indices of the previous dimensions, sorted,
+  * so an access is a binary search in each level, and the stored elements are traversed in row
+  * major order.
+*/
+
+#ifndef CNT_SPARSE_H
+#define CNT_SPARSE_H
+
+#include <stdexcept>
+
+#include "NdIndex.h"
+
+
+namespace cnt
+{
+
+
+/** Sparse container of elements of type 'T', with the sizes of the dimensions given at runtime.
+  * The elements not stored are 'T{}'. The accessors are the same as the ones of 'Container', but
+  * they return the elements by value, as there is no element to refer to for the zeros.
+*/
+template <typename T>
+class Sparse
+{
+public:
+
+    /** Some type definitions */
+    //@{
+    using value_type = T;
+    //@}
+
+
+
+    /// Iterates over the stored elements in row major order, giving their indices and values
+    template <class S, typename U>
+    class Iterator
+    {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = help::NdElement<U, 0>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = void;
+
+        using reference = value_type;
+
+
+        Iterator (S* s = nullptr, std::size_t pos = 0) : s(s), node(s ? s->numDimensions() : 0), index(node.size())
+        {
+            if(!s || node.empty())
+                return;
+
+            node.back() = pos;
+
+            for(std::size_t l = node.size() - 1; l-- > 0;)
+                node[l] = parent(l, node[l+1]);
+        }
+
+
+        /// The indices of all levels are written to the table only here
+        reference operator * () const
+        {
+            for(std::size_t l = 0; l < node.size(); ++l)
+                index[l] = s->idx[l][node[l]];
+
+            return reference{ index, s->values[node.back()] };
+        }
+
+
+        /** The next leaf is the next node of the last level. When it passes the last child of its
+          * parent, the parent is also the next node of its level, as the children of consecutive
+          * nodes are consecutive.
+        */
+        Iterator& operator ++ ()
+        {
+            ++node.back();
+
+            for(std::size_t l = node.size() - 1; l-- > 0;)
+            {
+                if(node[l+1] < s->ptr[l][node[l] + 1] || node[l] + 1 >= s->idx[l].size())
+                    break;
+
+                ++node[l];
+            }
+
+            return *this;
+        }
+
+        Iterator operator ++ (int)
+        {
+            Iterator it = *this;
+
+            ++*this;
+
+            return it;
+        }
+
+
+        bool operator == (const Iterator& it) const { return pos() == it.pos(); }
+
+        bool operator != (const Iterator& it) const { return pos() != it.pos(); }
+
+
+    private:
+
+        std::size_t pos () const { return node.empty() ? 0 : node.back(); }
+
+        /// The node of the level 'l' whose children contain the node 'x' of the level 'l + 1'
+        std::size_t parent (std::size_t l, std::size_t x) const
+        {
+            return std::upper_bound(s->ptr[l].begin(), s->ptr[l].end(), x) - s->ptr[l].begin() - 1;
+        }
+
+
+        S* s;
+
+        std::vector<std::size_t> node;                  /// Current node of each level
+
+        mutable std::vector<std::size_t> index;         /// Current index of each dimension
+    };
+
+    using iterator = Iterator<Sparse, T>;
+
+    using const_iterator = Iterator<const Sparse, const T>;
+
+
+
+// --------------------------------- Constructors ---------------------------------------------- //
+
+
+    /** An empty container with the given sizes of each dimension. There must be at least one
+      * dimension, otherwise 'std::invalid_argument' is thrown.
+    */
+    //@{
+    template <typename... Args, help::EnableIfIntegral< std::decay_t< Args >... > = 0>
+    explicit Sparse (Args... args) : Sparse(std::vector<std::size_t>{ std::size_t(args)... }) {}
+
+    template <typename U, typename V, help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
+    Sparse (const U& begin, const V& end) : Sparse(std::vector<std::size_t>(begin, end)) {}
+
+    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
+    Sparse (std::initializer_list<U> il) : Sparse(il.begin(), il.end()) {}
+
+    explicit Sparse (std::vector<std::size_t> sizes) : dimSize(std::move(sizes)), idx(dimSize.size()),
+                                                      ptr(dimSize.empty() ? 0 : dimSize.size() - 1, std::vector<std::size_t>(1, 0))
+    {
+        if(dimSize.empty())
+            throw std::invalid_argument("There must be at least one dimension");
+    }
+    //@}
+
+
+
+
+// ------------------------------------- Building ---------------------------------------------- //
+
+
+    /** Adds the element 'value' at the position given by 'args', integrals or iterables of
+      * integrals, as in 'operator()'. The element is only seen after calling 'compress'. If the
+      * same position is added more than once, the values are summed. Throws 'std::invalid_argument'
+      * if the position is not inside the container.
+    */
+    template <typename... Args, help::EnableIfIntegralOrIterable<Args...> = 0>
+    void insert (const T& value, const Args&... args)
+    {
+        const std::size_t first = cooIndex.size();
+
+        const auto& dummy = { (append(args), int{})..., int{} };
+
+        if(cooIndex.size() - first != numDimensions())
+        {
+            cooIndex.resize(first);
+
+            throw std::invalid_argument("There must be an index for each dimension");
+        }
+
+        for(std::size_t k = 0; k < numDimensions(); ++k)
+            if(cooIndex[first + k] >= dimSize[k])
+            {
+                cooIndex.resize(first);
+
+                throw std::invalid_argument("The position is outside of the container");
+            }
+
+        cooValues.push_back(value);
+    }
+
+
+    /** Builds the compressed form from the elements added by 'insert' and the ones already
+      * compressed. The positions are sorted in row major order, the values of repeated
+      * positions are summed, and the resulting zeros are not stored.
+    */
+    void compress ()
+    {
+        const std::size_t n = numDimensions();
+
+        for(auto it = begin(); it != end(); ++it)
+        {
+            const auto e = *it;
+
+            cooIndex.insert(cooIndex.end(), e.index.begin(), e.index.end());
+            cooValues.push_back(e.value);
+        }
+
+
+        std::vector<std::size_t> order(cooValues.size());
+
+        std::iota(order.begin(), order.end(), std::size_t(0));
+
+        auto position = [&](std::size_t i){ return cooIndex.begin() + i * n; };
+
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){
+            return std::lexicographical_compare(position(a), position(a) + n, position(b), position(b) + n);
+        });
+
+
+        for(auto& level : idx)
+            level.clear();
+
+        for(auto& level : ptr)
+            level.assign(1, 0);
+
+        values.clear();
+
+
+        for(std::size_t i = 0; i < order.size();)
+        {
+            std::size_t j = i;
+
+            T sum = T{};
+
+            for(; j < order.size() && std::equal(position(order[i]), position(order[i]) + n, position(order[j])); ++j)
+                sum += cooValues[order[j]];
+
+            if(sum != T{})
+                push(position(order[i]), sum);
+
+            i = j;
+        }
+
+
+        cooIndex.clear();
+        cooValues.clear();
+    }
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+    /** The same accessors of 'Container', returning 'T{}' for the elements that are not stored.
+      * Throws 'std::logic_error' if there are elements added after the last 'compress'.
+    */
+    //@{
+
+    /// Integral or iterable types
+    template <typename... Args, help::EnableIfIntegralOrIterable<Args...> = 0>
+    T operator () (const Args&... args) const
+    {
+        Cursor c = start();
+
+        const auto& dummy = { (descend(c, args), int{})..., int{} };
+
+        return get(c);
+    }
+
+
+    /// Iterators
+    template <typename U, help::EnableIfIterator<std::decay_t<U>> = 0>
+    T operator () (U begin) const
+    {
+        Cursor c = start();
+
+        for(std::size_t k = 0; k < numDimensions(); ++k, ++begin)
+            descend(c, *begin);
+
+        return get(c);
+    }
+
+
+    /// 'std::initializer_list'
+    template <typename U, help::EnableIfIntegral<std::decay_t<U>> = 0>
+    T operator () (std::initializer_list<U> il) const
+    {
+        return this->operator()(il.begin());
+    }
+
+
+    /// Tuples of integrals
+    template <typename... Args, help::EnableIfIntegral<std::decay_t<Args>...> = 0>
+    T operator () (const std::tuple<Args...>& tup) const
+    {
+        return this->operator()(tup, std::make_index_sequence<sizeof...(Args)>());
+    }
+
+    template <typename... Args, std::size_t... Js>
+    T operator () (const std::tuple<Args...>& tup, std::index_sequence<Js...>) const
+    {
+        return this->operator()(std::get<Js>(tup)...);
+    }
+    //@}
+
+
+
+
+    /// Size of each dimension
+    std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size, counting the elements that are not stored
+    std::size_t size () const
+    {
+        return std::accumulate(dimSize.begin(), dimSize.end(), std::size_t(1), std::multiplies<std::size_t>());
+    }
+
+    const std::vector<std::size_t>& sizes () const { return dimSize; }
+
+    std::size_t numDimensions () const { return dimSize.size(); }
+
+
+    /// Number of stored elements
+    std::size_t nonZeros () const { return values.size(); }
+
+
+
+    /** Begin and end, over the stored elements only. The values can be changed, but the positions
+      * can not.
+    */
+    //@{
+    iterator begin () { return iterator(this, 0); }
+
+    iterator end () { return iterator(this, values.size()); }
+
+    const_iterator begin () const { return const_iterator(this, 0); }
+
+    const_iterator end () const { return const_iterator(this, values.size()); }
+
+    const_iterator cbegin () const { return begin(); }
+
+    const_iterator cend () const { return end(); }
+    //@}
+
+
+
+    /** Elementwise operations that only touch the stored elements. With a dense container 'd'
+      * of the same sizes, each stored element 'x' at the index 'i' becomes 'x * d(i)' or 'x / d(i)'.
+      * Anything without 'sizes()' is taken as a scalar.
+    */
+    //@{
+    Sparse& operator *= (const T& x)
+    {
+        for(auto& v : values)
+            v *= x;
+
+        return *this;
+    }
+
+    Sparse& operator /= (const T& x)
+    {
+        for(auto& v : values)
+            v /= x;
+
+        return *this;
+    }
+
+    template <class D, help::EnableIfIterable<std::decay_t<decltype(std::declval<const D&>().sizes())>> = 0>
+    Sparse& operator *= (const D& d)
+    {
+        checkSizes(d);
+
+        for(auto e : *this)
+            e.value *= d(e.index);
+
+        return *this;
+    }
+
+    template <class D, help::EnableIfIterable<std::decay_t<decltype(std::declval<const D&>().sizes())>> = 0>
+    Sparse& operator /= (const D& d)
+    {
+        checkSizes(d);
+
+        for(auto e : *this)
+            e.value /= d(e.index);
+
+        return *this;
+    }
+    //@}
+
+
+
+    /// Throws 'std::invalid_argument' if the sizes of 'd' are not the same
+    template <class D>
+    void checkSizes (const D& d) const
+    {
+        const auto s = d.sizes();
+
+        if(!std::equal(dimSize.begin(), dimSize.end(), s.begin(), s.end()))
+            throw std::invalid_argument("The sizes of the containers are different");
+    }
+
+
+
+private:
+
+
+    /// A path from the root of the tree, at the node 'node' of the level 'level'
+    struct Cursor
+    {
+        std::size_t level;
+
+        std::size_t node;
+
+        bool found;
+    };
+
+
+    Cursor start () const
+    {
+        if(!cooValues.empty())
+            throw std::logic_error("There are elements added after the last call to 'compress'");
+
+        return Cursor{ 0, 0, true };
+    }
+
+
+    /** Goes to the child of the node of 'c' with the index 'x', an integral or an iterable, by a
+      * binary search among the children.
+    */
+    //@{
+    template <typename U, help::EnableIfIntegral< std::decay_t< U > > = 0>
+    void descend (Cursor& c, U x) const
+    {
+        if(!c.found || c.level >= numDimensions())
+            return void(c.found = false);
+
+        const auto& level = idx[c.level];
+
+        const std::size_t first = c.level ? ptr[c.level - 1][c.node] : 0;
+        const std::size_t last = c.level ? ptr[c.level - 1][c.node + 1] : level.size();
+
+        auto it = std::lower_bound(level.begin() + first, level.begin() + last, std::size_t(x));
+
+        c.found = it != level.begin() + last && *it == std::size_t(x);
+        c.node = it - level.begin();
+        ++c.level;
+    }
+
+    template <typename U, help::EnableIfIterable< std::decay_t< U > > = 0>
+    void descend (Cursor& c, const U& u) const
+    {
+        for(auto x : u)
+            descend(c, x);
+    }
+    //@}
+
+
+    T get (const Cursor& c) const
+    {
+        return c.found && c.level == numDimensions() ? values[c.node] : T{};
+    }
+
+
+
+    /// Appends the indices 'u', an integral or an iterable, to the last position of 'cooIndex'
+    //@{
+    template <typename U, help::EnableIfIntegral< std::decay_t< U > > = 0>
+    void append (U u) { cooIndex.push_back(std::size_t(u)); }
+
+    template <typename U, help::EnableIfIterable< std::decay_t< U > > = 0>
+    void append (const U& u) { cooIndex.insert(cooIndex.end(), std::begin(u), std::end(u)); }
+    //@}
+
+
+    /** Adds a leaf for the position starting at 'index', which is after all the stored ones.
+      * The levels where the position has the same indices as the last stored one share its nodes,
+      * and the others get a new node, which is the last child of the node of the previous level.
+    */
+    template <typename It>
+    void push (It index, const T& value)
+    {
+        const std::size_t n = numDimensions();
+
+        std::size_t l = 0;
+
+        if(!values.empty())
+            while(l < n && idx[l].back() == index[l])
+                ++l;
+
+        for(; l < n; ++l)
+        {
+            idx[l].push_back(index[l]);
+
+            if(l > 0)
+                ptr[l-1].back() = idx[l].size();
+
+            if(l < n - 1)
+                ptr[l].push_back(idx[l+1].size());
+        }
+
+        values.push_back(value);
+    }
+
+
+
+    std::vector<std::size_t> dimSize;               /// The size of each dimension
+
+
+    std::vector<std::vector<std::size_t>> idx;      /// The indices of the nodes of each level
+
+    std::vector<std::vector<std::size_t>> ptr;      /// The children of the node 'j' of the level 'l' are [ptr[l][j], ptr[l][j+1])
+
+    std::vector<T> values;                          /// The values of the leaves
+
+
+    std::vector<std::size_t> cooIndex;              /// The positions added since the last 'compress', 'numDimensions()' for each
+
+    std::vector<T> cooValues;                       /// And their values
+};
+
+
+
+
+/** Conversions between dense and sparse containers. The dense container can be anything
+  * accepted by 'ndindex'.
+*/
+//@{
+
+/// The elements of 'c' that are not zero
+template <class C>
+auto sparse (const C& c)
+{
+    using T = std::decay_t<decltype(*c.data())>;
+
+    const auto sizes = c.sizes();
+
+    Sparse<T> res(std::vector<std::size_t>(sizes.begin(), sizes.end()));
+
+    for(auto e : ndindex(c))
+        if(e.value != T{})
+            res.insert(e.value, e.index);
+
+    res.compress();
+
+    return res;
+}
+
+
+/// A row major 'Container' with the stored elements of 's' and zeros elsewhere
+template <typename T>
+Container<T> dense (const Sparse<T>& s)
+{
+    Container<T> res(s.sizes().begin(), s.sizes().end());
+
+    for(auto e : s)
+        res(e.index) = e.value;
+
+    return res;
+}
+//@}
+
+
+
+/** Sparse and dense operations, over the stored elements only. The sizes must be the same,
+  * otherwise 'std::invalid_argument' is thrown.
+*/
+//@{
+
+/// Sum of 's(i) * d(i)' over the stored elements of 's'
+template <typename T, class D>
+T dot (const Sparse<T>& s, const D& d)
+{
+    s.checkSizes(d);
+
+    T res = T{};
+
+    for(auto e : s)
+        res += e.value * d(e.index);
+
+    return res;
+}
+
+
+/// 'd(i) += alpha * s(i)' for the stored elements of 's'
+template <typename U, typename T, class D>
+void axpy (U alpha, const Sparse<T>& s, D&& d)
+{
+    s.checkSizes(d);
+
+    for(auto e : s)
+        d(e.index) += alpha * e.value;
+}
+//@}
+
+
+} // namespace cnt
+
+
+#endif // CNT_SPARSE_H
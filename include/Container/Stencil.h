@@ -0,0 +1,565 @@
+/** \file Stencil.h
+  *
+  * Stencils and convolutions over containers of any number of dimensions:
+  *
+  *     cnt::Container<float, 0, 0, 0> a(256, 256, 256), b(256, 256, 256);
+  *
+  *     cnt::DenseKernel<float, 3> laplacian({3, 3, 3}, weights);
+  *     cnt::stencil(a, b, laplacian, cnt::Boundary::clamp);
+  *
+  *     cnt::SeparableKernel<float, 3> box({1.0f / 3, 1.0f / 3, 1.0f / 3});
+  *     cnt::stencil(a, b, box, cnt::Boundary::mirror);
+  *
+  * The result is 'out(i) = sum_k w(k) * in(i + k - origin)' over the positions 'k' of the
+  * kernel, where 'origin' is its center, 'size / 2' in each dimension. The positions outside of
+  * 'in' are given by a 'Boundary'.
+  *
+  * The work is done by rows of the last dimension, split among the threads. For each row and
+  * each weight of the kernel the row of 'in' that it reads is found once, mapping the indices of
+  * the other dimensions through the boundary. So the only positions that need the boundary per
+  * element are the few at the ends of the row, and the rest of the row is a loop without
+  * branches, 'acc[j] += w * p[j]', that the compiler vectorizes.
+*/
+
+#ifndef CNT_STENCIL_H
+#define CNT_STENCIL_H
+
+#include "Strided.h"
+#include "Parallel.h"
+
+
+namespace cnt
+{
+
+
+/** What is read outside of the source, for a size of 5:
+  *
+  *     clamp:  0 0 | 0 1 2 3 4 | 4 4
+  *     wrap:   3 4 | 0 1 2 3 4 | 0 1
+  *     zero:   - - | 0 1 2 3 4 | - -       (the elements outside are 0)
+  *     mirror: 2 1 | 0 1 2 3 4 | 3 2       (the element at the edge is not repeated)
+*/
+enum class Boundary
+{
+    clamp,
+    wrap,
+    zero,
+    mirror
+};
+
+
+
+/** A kernel with a weight for each position of a block of 'N' dimensions. The weights are in
+  * row major order, and those equal to zero are skipped, so a star shaped stencil like the
+  * laplacian costs only its nonzero weights.
+*/
+template <typename T, std::size_t N>
+class DenseKernel
+{
+public:
+
+    using value_type = T;
+
+    using Sizes = std::array<std::size_t, N>;
+
+
+    /// Throws 'std::invalid_argument' if a size is 0 or if there is not a weight for each position
+    DenseKernel (const Sizes& sizes, std::vector<T> weights) : dimSize(sizes), weights_(std::move(weights))
+    {
+        std::size_t n = 1;
+
+        for(auto s : dimSize)
+            n *= s;
+
+        if(!n)
+            throw std::invalid_argument("The kernel sizes must be positive");
+
+        if(weights_.size() != n)
+            throw std::invalid_argument("There must be a weight for each position of the kernel");
+    }
+
+
+    const Sizes& sizes () const { return dimSize; }
+
+    const std::vector<T>& weights () const { return weights_; }
+
+
+    /// The position of the kernel that is multiplied by the element being computed
+    Sizes origin () const
+    {
+        Sizes res;
+
+        for(std::size_t k = 0; k < N; ++k)
+            res[k] = dimSize[k] / 2;
+
+        return res;
+    }
+
+
+private:
+
+    Sizes dimSize;
+
+    std::vector<T> weights_;
+};
+
+
+
+/** A kernel given by the product of 'N' one dimensional kernels, one for each dimension. It is
+  * applied as 'N' passes along each dimension, so a kernel of 'n' positions per dimension costs
+  * 'N * n' operations per element instead of 'n^N'.
+*/
+template <typename T, std::size_t N>
+class SeparableKernel
+{
+public:
+
+    using value_type = T;
+
+
+    /// Throws 'std::invalid_argument' if one of the kernels is empty
+    //@{
+    SeparableKernel (std::array<std::vector<T>, N> taps) : taps_(std::move(taps))
+    {
+        for(const auto& t : taps_)
+            if(t.empty())
+                throw std::invalid_argument("The kernel sizes must be positive");
+    }
+
+    /// The same kernel for every dimension
+    explicit SeparableKernel (const std::vector<T>& taps) : SeparableKernel(repeat(taps)) {}
+    //@}
+
+
+    /// The kernel of the dimension 'k'
+    const std::vector<T>& taps (std::size_t k) const { return taps_[k]; }
+
+
+private:
+
+    static std::array<std::vector<T>, N> repeat (const std::vector<T>& taps)
+    {
+        std::array<std::vector<T>, N> res;
+
+        res.fill(taps);
+
+        return res;
+    }
+
+
+    std::array<std::vector<T>, N> taps_;
+};
+
+
+
+
+namespace help
+{
+
+
+/// The index read at 'i' in a dimension of size 'n', or '-1' if the element is zero
+inline std::ptrdiff_t boundaryIndex (std::ptrdiff_t i, std::ptrdiff_t n, Boundary boundary)
+{
+    if(i >= 0 && i < n)
+        return i;
+
+    switch(boundary)
+    {
+        case Boundary::clamp:
+            return i < 0 ? 0 : n - 1;
+
+        case Boundary::wrap:
+            i %= n;
+            return i < 0 ? i + n : i;
+
+        case Boundary::mirror:
+        {
+            if(n == 1)
+                return 0;
+
+            const std::ptrdiff_t period = 2 * (n - 1);
+
+            i %= period;
+            i = i < 0 ? i + period : i;
+
+            return i < n ? i : period - i;
+        }
+
+        default:
+            return -1;
+    }
+}
+
+
+
+/// A nonzero weight of a kernel and its position relative to the origin
+template <typename T, std::size_t N>
+struct StencilTap
+{
+    std::array<std::ptrdiff_t, N> delta;
+
+    T weight;
+};
+
+
+
+/** 'acc[j] = sum_t w[t] * p[t][j * stride]' for 'j' in '[first, last)' and the 'm' rows 'p'. The
+  * rows are added four at a time, so the buffer is loaded and stored once for every four
+  * weights instead of once for each weight. The first group assigns instead of adding.
+*/
+//@{
+template <bool Contiguous, std::size_t K, typename T, typename U>
+void accumulateGroup (T* acc, const U* const* p, const T* w, std::ptrdiff_t stride,
+                      std::size_t first, std::size_t last, bool assign)
+{
+    for(std::size_t j = first; j < last; ++j)
+    {
+        const std::ptrdiff_t i = Contiguous ? std::ptrdiff_t(j) : std::ptrdiff_t(j) * stride;
+
+        T s = w[0] * p[0][i];
+
+        for(std::size_t k = 1; k < K; ++k)
+            s += w[k] * p[k][i];
+
+        acc[j] = assign ? s : acc[j] + s;
+    }
+}
+
+template <bool Contiguous, typename T, typename U>
+void accumulateRows (T* acc, const U* const* p, const T* w, std::size_t m, std::ptrdiff_t stride,
+                     std::size_t first, std::size_t last)
+{
+    std::size_t t = 0;
+
+    for(; t + 4 <= m; t += 4)
+        accumulateGroup<Contiguous, 4>(acc, p + t, w + t, stride, first, last, !t);
+
+    switch(m - t)
+    {
+        case 3: return accumulateGroup<Contiguous, 3>(acc, p + t, w + t, stride, first, last, !t);
+        case 2: return accumulateGroup<Contiguous, 2>(acc, p + t, w + t, stride, first, last, !t);
+        case 1: return accumulateGroup<Contiguous, 1>(acc, p + t, w + t, stride, first, last, !t);
+    }
+}
+
+template <typename T, typename U>
+void accumulateRows (T* acc, const U* const* p, const T* w, std::size_t m, std::ptrdiff_t stride,
+                     std::size_t first, std::size_t last)
+{
+    if(!m)
+        std::fill(acc + first, acc + last, T(0));
+
+    else if(stride == 1)
+        accumulateRows<true>(acc, p, w, m, stride, first, last);
+
+    else
+        accumulateRows<false>(acc, p, w, m, stride, first, last);
+}
+//@}
+
+
+/// 'q[j * stride] = acc[j]' for the 'n' elements of a row
+template <typename T, typename U>
+void storeRow (const T* acc, U* q, std::ptrdiff_t stride, std::size_t n)
+{
+    if(stride == 1)
+        for(std::size_t j = 0; j < n; ++j)
+            q[j] = acc[j];
+
+    else
+        for(std::size_t j = 0; j < n; ++j)
+            q[std::ptrdiff_t(j) * stride] = acc[j];
+}
+
+
+
+/** Applies the weights 'taps' to the elements of 'in', writing to 'out', both with the given
+  * sizes and their own strides. The rows of the last dimension are split among the threads,
+  * each one accumulating a row at a time in a buffer of type 'T'. The columns '[lo, hi)' read
+  * only positions inside of the row, and the ones around them go through the boundary.
+*/
+template <typename T, std::size_t N, typename U, typename V>
+void applyStencil (const U* in, const std::array<std::size_t, N>& sizes, const std::array<std::size_t, N>& inStrides,
+                   V* out, const std::array<std::size_t, N>& outStrides,
+                   const std::vector<StencilTap<T, N>>& taps, Boundary boundary)
+{
+    std::size_t rows = 1;
+
+    for(std::size_t k = 0; k + 1 < N; ++k)
+        rows *= sizes[k];
+
+    const std::size_t n = sizes[N-1];
+
+    if(!rows || !n)
+        return;
+
+
+    std::ptrdiff_t before = 0, after = 0;
+
+    for(const auto& tap : taps)
+    {
+        before = std::max(before, -tap.delta[N-1]);
+        after = std::max(after, tap.delta[N-1]);
+    }
+
+    const std::size_t lo = std::min<std::size_t>(before, n);
+    const std::size_t hi = std::max<std::size_t>(lo, n - std::min<std::size_t>(after, n));
+
+    const std::ptrdiff_t inStride = inStrides[N-1];
+
+
+    auto& pool = ThreadPool::global();
+
+    const std::size_t grain = std::max<std::size_t>(rows / (8 * pool.size()), 1);
+
+    pool.parallelFor(0, rows, grain, [&](std::size_t first, std::size_t last){
+        std::vector<T> acc(n);
+
+        std::vector<const U*> rowPtr(taps.size()), shifted(taps.size());
+
+        std::vector<T> weights(taps.size());
+
+        for(std::size_t r = first; r < last; ++r)
+        {
+            std::array<std::size_t, N> index{};
+
+            for(std::size_t k = N - 1, t = r; k-- > 0; t /= sizes[k])
+                index[k] = t % sizes[k];
+
+
+            /// The row read by each weight, or 'nullptr' if it is outside and the boundary is zero
+            for(std::size_t t = 0; t < taps.size(); ++t)
+            {
+                const U* p = in;
+
+                for(std::size_t k = 0; k + 1 < N && p; ++k)
+                {
+                    const std::ptrdiff_t i = boundaryIndex(std::ptrdiff_t(index[k]) + taps[t].delta[k], sizes[k], boundary);
+
+                    p = i < 0 ? nullptr : p + i * std::ptrdiff_t(inStrides[k]);
+                }
+
+                rowPtr[t] = p;
+            }
+
+
+            for(std::size_t j = lo ? 0 : hi; j < n; j = (j + 1 == lo ? hi : j + 1))
+            {
+                T s = T(0);
+
+                for(std::size_t t = 0; t < taps.size(); ++t)
+                {
+                    const std::ptrdiff_t i = boundaryIndex(std::ptrdiff_t(j) + taps[t].delta[N-1], n, boundary);
+
+                    if(rowPtr[t] && i >= 0)
+                        s += taps[t].weight * rowPtr[t][i * inStride];
+                }
+
+                acc[j] = s;
+            }
+
+
+            std::size_t m = 0;
+
+            for(std::size_t t = 0; t < taps.size(); ++t)
+                if(rowPtr[t])
+                {
+                    shifted[m] = rowPtr[t] + taps[t].delta[N-1] * inStride;
+                    weights[m++] = taps[t].weight;
+                }
+
+            accumulateRows(acc.data(), shifted.data(), weights.data(), m, inStride, lo, hi);
+
+
+            V* q = out;
+
+            for(std::size_t k = 0; k + 1 < N; ++k)
+                q += index[k] * outStrides[k];
+
+            storeRow(acc.data(), q, outStrides[N-1], n);
+        }
+    });
+}
+
+
+
+/** The sizes and strides of 'c' as arrays of 'N' elements. Throws 'std::invalid_argument' if
+  * the number of dimensions of 'c' is known only at runtime and is not 'N'.
+*/
+template <std::size_t N, class C>
+std::pair<std::array<std::size_t, N>, std::array<std::size_t, N>> stencilShape (const C& c)
+{
+    constexpr std::size_t R = staticRank<std::decay_t<C>>;
+
+    static_assert(!R || R == N, "The kernel must have the number of dimensions of the container");
+
+
+    const auto sizes = c.sizes();
+    const auto strides = c.strides();
+
+    if(sizes.size() != N)
+        throw std::invalid_argument("The kernel must have the number of dimensions of the container");
+
+
+    std::pair<std::array<std::size_t, N>, std::array<std::size_t, N>> res;
+
+    std::copy(sizes.begin(), sizes.end(), res.first.begin());
+    std::copy(strides.begin(), strides.end(), res.second.begin());
+
+    return res;
+}
+
+
+/// 'p' if it points to elements of type 'T', that can hold the passes of a separable kernel
+//@{
+template <typename T>
+T* bufferOf (T* p, std::true_type) { return p; }
+
+template <typename T, typename U>
+T* bufferOf (U*, std::false_type) { return nullptr; }
+
+template <typename T, typename U>
+T* bufferOf (U* p) { return bufferOf<T>(p, std::is_same<T, U>()); }
+//@}
+
+
+/// Throws 'std::invalid_argument' if the sizes of 'in' and 'out' are different
+template <std::size_t N, class C, class D>
+void checkStencil (const C& in, const D& out)
+{
+    if(stencilShape<N>(in).first != stencilShape<N>(out).first)
+        throw std::invalid_argument("The sizes of the containers are different");
+}
+
+
+} // namespace help
+
+
+
+/** Applies 'kernel' to 'in', writing the result to 'out', which must have the sizes of 'in' and
+  * must not share elements with it. Both can be anything with strides: a 'Container' in row or
+  * column major order, a 'ContainerView', a 'Slice' or a 'StridedView'. Throws
+  * 'std::invalid_argument' if the number of dimensions of the kernel is not the one of the
+  * containers, or if their sizes are different.
+*/
+//@{
+template <class C, class D, typename T, std::size_t N>
+void stencil (const C& in, D&& out, const DenseKernel<T, N>& kernel, Boundary boundary = Boundary::clamp)
+{
+    help::checkStencil<N>(in, out);
+
+    const auto src = help::stencilShape<N>(in);
+    const auto dst = help::stencilShape<N>(out);
+
+
+    std::vector<help::StencilTap<T, N>> taps;
+
+    const auto origin = kernel.origin();
+
+    std::array<std::size_t, N> pos{};
+
+    for(const auto& w : kernel.weights())
+    {
+        if(w != T(0))
+        {
+            help::StencilTap<T, N> tap;
+
+            for(std::size_t k = 0; k < N; ++k)
+                tap.delta[k] = std::ptrdiff_t(pos[k]) - std::ptrdiff_t(origin[k]);
+
+            tap.weight = w;
+
+            taps.push_back(tap);
+        }
+
+        for(std::size_t k = N; k-- > 0 && ++pos[k] == kernel.sizes()[k];)
+            pos[k] = 0;
+    }
+
+
+    help::applyStencil(in.data(), src.first, src.second, out.data(), dst.second, taps, boundary);
+}
+
+
+/** The passes go through the dimensions in order, from 'in' to a row major buffer, between two
+  * buffers and from the last buffer to 'out'. The elements are accumulated in 'T' in each pass.
+  * If 'out' is itself a row major buffer of 'T' it is one of the two, so a single buffer of the
+  * size of 'in' is allocated.
+*/
+template <class C, class D, typename T, std::size_t N>
+void stencil (const C& in, D&& out, const SeparableKernel<T, N>& kernel, Boundary boundary = Boundary::clamp)
+{
+    help::checkStencil<N>(in, out);
+
+    const auto src = help::stencilShape<N>(in);
+    const auto dst = help::stencilShape<N>(out);
+
+    const auto& sizes = src.first;
+
+
+    std::array<std::size_t, N> weights;
+
+    weights[N-1] = 1;
+
+    for(std::size_t k = N-1; k-- > 0;)
+        weights[k] = weights[k+1] * sizes[k+1];
+
+    const std::size_t n = weights[0] * sizes[0];
+
+    T* const direct = help::bufferOf<T>(out.data());
+
+    const bool reuse = direct && dst.second == weights;
+
+    std::vector<T> first(N > 1 ? n : 0), second(N > 2 && !reuse ? n : 0);
+
+    T* buffers[2] = { first.data(), second.data() };
+
+    if(reuse)
+    {
+        buffers[(N-1) % 2] = direct;
+        buffers[N % 2] = first.data();
+    }
+
+
+    auto pass = [&](std::size_t k, const auto* p, const std::array<std::size_t, N>& pStrides,
+                    auto* q, const std::array<std::size_t, N>& qStrides)
+    {
+        const auto& w = kernel.taps(k);
+
+        std::vector<help::StencilTap<T, N>> taps;
+
+        for(std::size_t i = 0; i < w.size(); ++i)
+        {
+            if(w[i] == T(0))
+                continue;
+
+            help::StencilTap<T, N> tap{};
+
+            tap.delta[k] = std::ptrdiff_t(i) - std::ptrdiff_t(w.size() / 2);
+            tap.weight = w[i];
+
+            taps.push_back(tap);
+        }
+
+        help::applyStencil(p, sizes, pStrides, q, qStrides, taps, boundary);
+    };
+
+
+    if(N == 1)
+        return pass(0, in.data(), src.second, out.data(), dst.second);
+
+    pass(0, in.data(), src.second, buffers[0], weights);
+
+    for(std::size_t k = 1; k + 1 < N; ++k)
+        pass(k, buffers[(k-1) % 2], weights, buffers[k % 2], weights);
+
+    pass(N-1, buffers[N % 2], weights, out.data(), dst.second);
+}
+//@}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_STENCIL_H
@@ -0,0 +1,598 @@
+/** \file Strided.h
+  *
+  * Strided views, selecting a fixed index, a range or a range with a step on each dimension
+  * of a 'Container', 'ContainerView' or of another strided view, without copying.
+*/
+
+#ifndef CNT_STRIDED_H
+#define CNT_STRIDED_H
+
+#include <iterator>
+#include <stdexcept>
+
+#include "View.h"
+
+
+namespace cnt
+{
+
+/** Selections for each dimension of 'strided'. An integral fixes the dimension at this index
+  * and removes it from the view, 'all' keeps the whole dimension and 'range(first, last, step)'
+  * keeps the positions 'first, first + step, ...' less than 'last'. 'strided' throws
+  * 'std::invalid_argument' for an index or a range out of the bounds of its dimension, or for
+  * a range with a step of '0'.
+*/
+//@{
+struct All {};
+
+constexpr All all{};
+
+
+struct Range
+{
+    std::size_t first;
+    std::size_t last;
+    std::size_t step;
+};
+
+constexpr Range range (std::size_t first, std::size_t last, std::size_t step = 1)
+{
+    return Range{ first, last, step };
+}
+//@}
+
+
+
+namespace help
+{
+
+
+/// The number of dimensions given by the sizes of a container, or '0' if known only at runtime
+//@{
+template <class>
+struct StaticRank : std::integral_constant<std::size_t, 0> {};
+
+template <typename U, std::size_t N>
+struct StaticRank<std::array<U, N>> : std::integral_constant<std::size_t, N> {};
+
+template <class C>
+constexpr std::size_t staticRank = StaticRank<std::decay_t<decltype(std::declval<const C&>().sizes())>>::value;
+//@}
+
+
+/// 'Shape<0, ..., 0>' with 'N' dimensions
+//@{
+template <std::size_t... Js>
+Shape<(Js * 0)...> zeroShape (std::index_sequence<Js...>);
+
+template <std::size_t N>
+using ZeroShape = decltype(zeroShape(std::make_index_sequence<N>()));
+//@}
+
+
+/// How many of the selections keep their dimension (that is, are not integrals)
+template <typename... Sels>
+constexpr std::size_t keptDimensions ()
+{
+    const bool integral[] = { false, std::is_integral_v<Sels>... };
+
+    std::size_t res = 0;
+
+    for(std::size_t i = 1; i <= sizeof...(Sels); ++i)
+        res += !integral[i];
+
+    return res;
+}
+
+
+
+
+template <typename T, std::size_t N>
+class StridedView;
+
+
+/** Iterates over the elements of a 'StridedView' in row major order. The pointer is updated
+  * incrementally: a step in the last dimension adds its stride, and only when the last dimension
+  * wraps around the carry goes to the previous ones. The iterator keeps its own copy of the sizes
+  * and strides, so it stays valid after the view it was taken from is gone.
+*/
+template <typename T, std::size_t N>
+class StridedIterator
+{
+public:
+
+    using iterator_category = std::forward_iterator_tag;
+
+    using value_type = std::remove_const_t<T>;
+
+    using difference_type = std::ptrdiff_t;
+
+    using pointer = T*;
+
+    using reference = T&;
+
+
+
+    StridedIterator () : ptr(nullptr), pos(0), sizes{}, strides{}, index{} {}
+
+    StridedIterator (T* ptr, std::size_t pos, const std::array<std::size_t, N>& sizes,
+                     const std::array<std::size_t, N>& strides) :
+                     ptr(ptr), pos(pos), sizes(sizes), strides(strides), index{} {}
+
+
+    /// Const iterators can be created from non const ones
+    template <typename U, std::enable_if_t<std::is_same_v<const U, T>, int> = 0>
+    StridedIterator (const StridedIterator<U, N>& it) : ptr(it.ptr), pos(it.pos), sizes(it.sizes),
+                                                        strides(it.strides), index(it.index) {}
+
+
+
+    reference operator * () const { return *ptr; }
+
+    pointer operator -> () const { return ptr; }
+
+
+    StridedIterator& operator ++ ()
+    {
+        ++pos;
+
+        for(std::size_t i = N; i-- > 0;)
+        {
+            ptr += strides[i];
+
+            if(++index[i] < sizes[i])
+                break;
+
+            ptr -= index[i] * strides[i];
+
+            index[i] = 0;
+        }
+
+        return *this;
+    }
+
+    StridedIterator operator ++ (int)
+    {
+        StridedIterator it = *this;
+
+        ++*this;
+
+        return it;
+    }
+
+
+    bool operator == (const StridedIterator& it) const { return pos == it.pos; }
+
+    bool operator != (const StridedIterator& it) const { return pos != it.pos; }
+
+
+
+    T* ptr;                                         /// Current element
+
+    std::size_t pos;                                /// Position in row major order
+
+    std::array<std::size_t, N> sizes;               /// Sizes of the view
+
+    std::array<std::size_t, N> strides;             /// Strides of the view
+
+    std::array<std::size_t, N> index;               /// Current index in each dimension
+};
+
+
+
+
+/** A view of 'N' dimensions given by a pointer, the size of each dimension and the distance in
+  * elements between consecutive positions of each dimension (the strides). It has the same
+  * access interface as 'Container', and it is trivially copyable. Unlike 'Slice', it does not
+  * refer to the container it was taken from, so it can be assigned, given by value to other
+  * threads and sliced again.
+  *
+  * \tparam T The type of the elements, const for read only views
+  * \tparam N The number of dimensions
+*/
+template <typename T, std::size_t N>
+class StridedView
+{
+public:
+
+    /** Some type definitions */
+    //@{
+    using value_type = std::remove_const_t<T>;
+
+    using reference = T&;
+
+    using const_reference = const T&;
+
+
+    using iterator = StridedIterator<T, N>;
+
+    using const_iterator = StridedIterator<const T, N>;
+
+
+    using Sizes = std::array<std::size_t, N>;
+    //@}
+
+
+
+// --------------------------------- Constructors ---------------------------------------------- //
+
+
+    StridedView () : data_(nullptr), dimSize{}, weights{} {}
+
+
+    /** A view of 'data' with the given sizes and strides of each dimension.
+      *
+      * \param[in] data Pointer to the first element
+      * \param[in] sizes The size of each dimension
+      * \param[in] strides The distance, in elements, between consecutive positions of each dimension
+    */
+    StridedView (T* data, const Sizes& sizes, const Sizes& strides) : data_(data), dimSize(sizes), weights(strides) {}
+
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+    /** The same accessors as in 'Container', so 'Accessor' can delegate to them */
+    //@{
+
+    /// Integral or iterable types
+    template <typename... Args>
+    const_reference operator () (IntegralType, const Args&... args) const
+    {
+        return data_[offset(std::integral_constant<bool, And_v<std::is_integral_v<Args>...>>(),
+                            std::index_sequence_for<Args...>(), args...)];
+    }
+
+
+    /// Iterators
+    template <typename U>
+    const_reference operator () (IteratorType, const U& begin) const
+    {
+        return data_[std::inner_product(weights.begin(), weights.end(), begin, std::size_t(0))];
+    }
+
+
+    /// 'std::initializer_list'
+    template <typename U>
+    const_reference operator () (std::initializer_list<U> il) const
+    {
+        return data_[std::inner_product(weights.begin(), weights.end(), il.begin(), std::size_t(0))];
+    }
+    //@}
+
+
+
+
+    /// Size of each dimension
+    constexpr std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size
+    std::size_t size () const { return std::accumulate(dimSize.begin(), dimSize.end(), std::size_t(1), std::multiplies<std::size_t>()); }
+
+    constexpr const Sizes& sizes () const { return dimSize; }
+
+    /// Distance, in elements, between consecutive positions of each dimension
+    constexpr const Sizes& strides () const { return weights; }
+
+    constexpr std::size_t numDimensions () const { return N; }
+
+
+    /// Pointer to the first element
+    T* data () const { return data_; }
+
+
+
+    /** Fixes the first dimensions at the integral indices 'args', like 'Container::slice', and
+      * returns the view of the remaining ones, which is again a 'StridedView':
+      *
+      *     auto v = strided(c);        // 'StridedView<float, 3>' of 'c'
+      *     auto row = v.slice(2, 3);   // 'StridedView<float, 1>', the same as 'v.slice(2).slice(3)'
+    */
+    template <typename... Args, EnableIfIntegral<std::decay_t<Args>...> = 0>
+    auto slice (const Args&... args) const
+    {
+        static_assert(sizeof...(Args) <= N, "There are more indices than dimensions");
+
+        return sliceAt(offset(std::true_type(), std::index_sequence_for<Args...>(), args...),
+                       std::make_index_sequence<N - sizeof...(Args)>());
+    }
+
+
+
+    /** Tells if the elements are contiguous in row major order, so the view can be traversed
+      * as the range [data(), data() + size()). Dimensions of size 1 do not matter.
+    */
+    bool contiguous () const
+    {
+        std::size_t stride = 1;
+
+        for(std::size_t i = N; i-- > 0;)
+        {
+            if(dimSize[i] == 1)
+                continue;
+
+            if(weights[i] != stride)
+                return false;
+
+            stride *= dimSize[i];
+        }
+
+        return true;
+    }
+
+
+
+    /** Begin and end, iterating in row major order */
+    //@{
+    iterator begin () const { return iterator(data_, 0, dimSize, weights); }
+
+    iterator end () const { return iterator(data_, size(), dimSize, weights); }
+
+    const_iterator cbegin () const { return begin(); }
+
+    const_iterator cend () const { return end(); }
+    //@}
+
+
+
+private:
+
+
+    /// The view of the last 'sizeof...(Js)' dimensions starting at the position 'pos'
+    template <std::size_t... Js>
+    auto sliceAt (std::size_t pos, std::index_sequence<Js...>) const
+    {
+        constexpr std::size_t K = N - sizeof...(Js);
+
+        using Res = StridedView<T, sizeof...(Js)>;
+
+        return Accessor<Res>(data_ + pos, typename Res::Sizes{{ dimSize[K + Js]... }},
+                             typename Res::Sizes{{ weights[K + Js]... }});
+    }
+
+
+    /// Position of the element, unrolled over the strides if all 'args' are integrals
+    //@{
+    template <std::size_t... Js, typename... Args>
+    std::size_t offset (std::true_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        std::size_t pos = 0;
+
+        const auto& dummy = { (pos += std::get<Js>(weights) * std::size_t(args), int{})..., int{} };
+
+        return pos;
+    }
+
+    template <std::size_t... Js, typename... Args>
+    std::size_t offset (std::false_type, std::index_sequence<Js...>, const Args&... args) const
+    {
+        return position(weights.begin(), args...);
+    }
+    //@}
+
+
+
+    T* data_;           /// The first element
+
+    Sizes dimSize;      /// The size of each dimension
+
+    Sizes weights;      /// The stride of each dimension
+};
+
+
+
+
+/** Applies the selection of a single dimension 'k' of the source. The pointer 'p' is moved to
+  * the first selected position, and if the dimension is kept, its size and stride are written
+  * at the position 'j' of the view.
+*/
+//@{
+template <typename T, class Sizes, class Strides, std::size_t N, typename U, EnableIfIntegral<U> = 0>
+inline void select (const U& u, T*& p, const Sizes& sizes, const Strides& strides, std::size_t& k,
+                    std::array<std::size_t, N>&, std::array<std::size_t, N>&, std::size_t&)
+{
+    if(std::size_t(u) >= sizes[k])
+        throw std::invalid_argument("The index is out of the bounds of the dimension");
+
+    p += std::size_t(u) * strides[k++];
+}
+
+template <typename T, class Sizes, class Strides, std::size_t N>
+inline void select (All, T*&, const Sizes& sizes, const Strides& strides, std::size_t& k,
+                    std::array<std::size_t, N>& newSizes, std::array<std::size_t, N>& newStrides, std::size_t& j)
+{
+    newSizes[j] = sizes[k];
+    newStrides[j++] = strides[k++];
+}
+
+template <typename T, class Sizes, class Strides, std::size_t N>
+inline void select (const Range& r, T*& p, const Sizes& sizes, const Strides& strides, std::size_t& k,
+                    std::array<std::size_t, N>& newSizes, std::array<std::size_t, N>& newStrides, std::size_t& j)
+{
+    if(!r.step)
+        throw std::invalid_argument("The step of a range must be positive");
+
+    if(r.first > sizes[k] || r.last > sizes[k])
+        throw std::invalid_argument("The range is out of the bounds of the dimension");
+
+    p += r.first * strides[k];
+
+    newSizes[j] = r.last > r.first ? (r.last - r.first + r.step - 1) / r.step : 0;
+    newStrides[j++] = r.step * strides[k++];
+}
+//@}
+
+
+} // namespace help
+
+
+
+/** A view of 'N' dimensions given by a pointer, sizes and strides. See 'strided'. */
+template <typename T, std::size_t N>
+using StridedView = help::Accessor<help::StridedView<T, N>>;
+
+
+
+/** Takes a strided view of 'c', which can be a 'Container', a 'ContainerView' or a 'StridedView'.
+  * There is a selection for each dimension (see 'all' and 'range'), and the dimensions after the
+  * last selection are kept whole. For example, for a 'Container<int, 0, 0, 0> c(10, 20, 30)':
+  *
+  *     strided(c, all, 2, range(1, 10, 2))  // 10 x 5 view, like 'c[:, 2, 1:10:2]' in numpy
+  *     strided(c, 3, all, 0)                // The column 'c(3, :, 0)', of 20 elements
+  *
+  * If the number of dimensions of 'c' is not known at compile time, there must be a selection
+  * for each dimension, otherwise 'std::invalid_argument' is thrown.
+*/
+template <class C, typename... Sels>
+auto strided (C& c, const Sels&... sels)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    constexpr std::size_t R = help::staticRank<std::decay_t<C>>;
+
+    static_assert(!R || sizeof...(Sels) <= R, "There are more selections than dimensions");
+
+    constexpr std::size_t N = help::keptDimensions<Sels...>() + (R ? R - sizeof...(Sels) : 0);
+
+
+    const auto& sizes = c.sizes();
+
+    const auto& strides = c.strides();
+
+    if(!R && sizes.size() != sizeof...(Sels))
+        throw std::invalid_argument("There must be a selection for each dimension");
+
+
+    T* p = c.data();
+
+    std::array<std::size_t, N> newSizes{}, newStrides{};
+
+    std::size_t k = 0, j = 0;
+
+    const auto& dummy = { (help::select(sels, p, sizes, strides, k, newSizes, newStrides, j), int{})..., int{} };
+
+    for(; j < N; ++j, ++k)
+    {
+        newSizes[j] = sizes[k];
+        newStrides[j] = strides[k];
+    }
+
+
+    return StridedView<T, N>(p, newSizes, newStrides);
+}
+
+
+
+/** A strided view of all the elements of 'c' with 'N' dimensions, for the containers whose
+  * number of dimensions is known only at runtime, like 'Container<T>' and the slices. For
+  * example, for a 'Container<float> c(10, 20, 30)':
+  *
+  *     auto v = strided<2>(c.slice(4));     // 'StridedView<float, 2>' of 'c(4, :, :)'
+  *
+  * 'std::invalid_argument' is thrown if 'c' does not have 'N' dimensions.
+*/
+template <std::size_t N, class C>
+auto strided (C&& c)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    const auto& sizes = c.sizes();
+
+    const auto& strides = c.strides();
+
+    if(sizes.size() != N)
+        throw std::invalid_argument("The number of dimensions does not match");
+
+
+    std::array<std::size_t, N> newSizes{}, newStrides{};
+
+    std::copy(sizes.begin(), sizes.end(), newSizes.begin());
+    std::copy(strides.begin(), strides.end(), newStrides.begin());
+
+    return StridedView<T, N>(c.data(), newSizes, newStrides);
+}
+
+
+
+/** A view of the elements of 'c' with the sizes 'sizes', in the order they are in memory, so
+  * a 'Container<float> c(120)' can be seen as 'reshaped(c, 4, 5, 6)' without copying. The
+  * elements of 'c' must be contiguous and the total size must be the same, otherwise
+  * 'std::invalid_argument' is thrown.
+*/
+template <class C, typename... Ints, help::EnableIfIntegral<Ints...> = 0>
+auto reshaped (C&& c, Ints... sizes)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    constexpr std::size_t N = sizeof...(Ints);
+
+
+    if(!help::contiguous(c, 0))
+        throw std::invalid_argument("The elements must be contiguous");
+
+    const std::array<std::size_t, N> newSizes = {{ std::size_t(sizes)... }};
+
+    if(std::accumulate(newSizes.begin(), newSizes.end(), std::size_t(1), std::multiplies<std::size_t>()) != c.size())
+        throw std::invalid_argument("The total size must be the same");
+
+
+    std::array<std::size_t, N> newStrides;
+
+    for(std::size_t k = N, stride = 1; k-- > 0; stride *= newSizes[k])
+        newStrides[k] = stride;
+
+    return StridedView<T, N>(c.data(), newSizes, newStrides);
+}
+
+
+
+/** Calls 'f' for each element of the view, in row major order. If the view is contiguous,
+  * this is a loop over a pointer. Otherwise the last dimension is the inner loop, with its
+  * stride, and only the outer dimensions are traversed by a 'StridedIterator'.
+*/
+//@{
+template <typename T, class F>
+F for_each (const help::StridedView<T, 0>& v, F f)
+{
+    f(*v.data());
+
+    return f;
+}
+
+template <typename T, std::size_t N, class F>
+F for_each (const help::StridedView<T, N>& v, F f)
+{
+    if(v.contiguous())
+        return std::for_each(v.data(), v.data() + v.size(), f);
+
+
+    std::array<std::size_t, N-1> sizes, strides;
+
+    std::copy(v.sizes().begin(), v.sizes().end() - 1, sizes.begin());
+    std::copy(v.strides().begin(), v.strides().end() - 1, strides.begin());
+
+    help::StridedView<T, N-1> rows(v.data(), sizes, strides);
+
+
+    const std::size_t n = v.size(N-1), stride = v.strides()[N-1];
+
+    for(auto it = rows.begin(); it != rows.end(); ++it)
+    {
+        T* p = &*it;
+
+        for(std::size_t i = 0; i < n; ++i, p += stride)
+            f(*p);
+    }
+
+    return f;
+}
+//@}
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_STRIDED_H
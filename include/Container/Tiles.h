@@ -0,0 +1,242 @@
+/** \file Tiles.h
+  *
+  * Traversal of a container by blocks of a fixed shape, so the elements used together stay in
+  * the L1 or L2 cache:
+  *
+  *     cnt::Container<float, 0, 0> c(1000, 1000);
+  *
+  *     for(auto tile : cnt::tiles(c, 64, 64))
+  *         for(int i = 0; i < tile.size(0); ++i)
+  *             for(int j = 0; j < tile.size(1); ++j)
+  *                 tile(i, j) *= 2.0f;
+  *
+  *     cnt::parallel_for_tiles(cnt::tiles(c, 64, 64), [](auto tile){ cnt::for_each(tile, ...); });
+  *
+  * Each tile is a 'StridedView' of the source. The tiles at the end of a dimension whose size is
+  * not a multiple of the block size are smaller, so every element is in exactly one tile.
+*/
+
+#ifndef CNT_TILES_H
+#define CNT_TILES_H
+
+#include "Strided.h"
+#include "Parallel.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+/** The tiles of a strided source of 'N' dimensions, in row major order over the grid of tiles.
+  * The tiles are created on demand, so the range is cheap to copy, and a tile can be taken by
+  * its position with 'operator[]', which is how the tiles are split among threads.
+*/
+template <typename T, std::size_t N>
+class TileRange
+{
+public:
+
+    using Sizes = std::array<std::size_t, N>;
+
+    using value_type = Accessor<StridedView<T, N>>;
+
+
+
+    /// Iterates over the tiles, returning them by value
+    class iterator
+    {
+    public:
+
+        using iterator_category = std::input_iterator_tag;
+
+        using value_type = TileRange::value_type;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = void;
+
+        using reference = value_type;
+
+
+        iterator (const TileRange* range = nullptr, std::size_t pos = 0) : range(range), pos(pos) {}
+
+
+        value_type operator * () const { return (*range)[pos]; }
+
+        iterator& operator ++ () { ++pos; return *this; }
+
+        iterator operator ++ (int) { return iterator(range, pos++); }
+
+
+        bool operator == (const iterator& it) const { return pos == it.pos; }
+
+        bool operator != (const iterator& it) const { return pos != it.pos; }
+
+
+    private:
+
+        const TileRange* range;
+
+        std::size_t pos;
+    };
+
+    using const_iterator = iterator;
+
+
+
+    /** The tiles of the elements starting at 'data', with the given sizes and strides, in blocks
+      * of 'shape'. Throws 'std::invalid_argument' if a block size is 0.
+    */
+    TileRange (T* data, const Sizes& sizes, const Sizes& strides, const Sizes& shape) :
+               data_(data), dimSize(sizes), weights(strides), shape_(shape), numTiles(1)
+    {
+        for(std::size_t k = 0; k < N; ++k)
+        {
+            if(!shape[k])
+                throw std::invalid_argument("The tile sizes must be positive");
+
+            counts[k] = (sizes[k] + shape[k] - 1) / shape[k];
+
+            numTiles *= counts[k];
+        }
+    }
+
+
+
+    /// Total number of tiles
+    std::size_t size () const { return numTiles; }
+
+    /// Number of tiles along the dimension 'k'
+    std::size_t size (int k) const { return counts[k]; }
+
+    /// Size of the full tiles
+    const Sizes& shape () const { return shape_; }
+
+
+
+    /// Index in the source of the first element of the tile 't'
+    Sizes origin (std::size_t t) const
+    {
+        Sizes res;
+
+        for(std::size_t k = N; k-- > 0; t /= counts[k])
+            res[k] = (t % counts[k]) * shape_[k];
+
+        return res;
+    }
+
+
+    /// The tile 't', smaller than 'shape()' at the last positions of each dimension
+    value_type operator [] (std::size_t t) const
+    {
+        const Sizes first = origin(t);
+
+        Sizes sizes;
+
+        T* p = data_;
+
+        for(std::size_t k = 0; k < N; ++k)
+        {
+            sizes[k] = std::min(shape_[k], dimSize[k] - first[k]);
+
+            p += first[k] * weights[k];
+        }
+
+        return value_type(p, sizes, weights);
+    }
+
+
+
+    /** Begin and end */
+    //@{
+    iterator begin () const { return iterator(this, 0); }
+
+    iterator end () const { return iterator(this, numTiles); }
+    //@}
+
+
+
+private:
+
+    T* data_;           /// The first element of the source
+
+    Sizes dimSize;      /// The sizes of the source
+
+    Sizes weights;      /// The strides of the source
+
+    Sizes shape_;       /// The sizes of the full tiles
+
+    Sizes counts;       /// The number of tiles along each dimension
+
+    std::size_t numTiles;
+};
+
+
+} // namespace help
+
+
+
+/** The tiles of 'c' in blocks of 'shape', which has a size for each dimension of 'c'. The source
+  * can be anything with strides: a 'Container' in row or column major order, a 'ContainerView',
+  * a 'StridedView' or a temporary like 'c.slice(2)' or 'strided(c, all, range(0, 64, 2))'. If the number of dimensions of 'c' is known only at runtime and is not
+  * 'N', 'std::invalid_argument' is thrown.
+*/
+//@{
+template <class C, std::size_t N>
+auto tiles (C&& c, const std::array<std::size_t, N>& shape)
+{
+    using T = std::remove_pointer_t<decltype(c.data())>;
+
+    constexpr std::size_t R = help::staticRank<std::decay_t<C>>;
+
+    static_assert(!R || R == N, "There must be a tile size for each dimension");
+
+
+    const auto sizes = c.sizes();
+    const auto strides = c.strides();
+
+    if(sizes.size() != N)
+        throw std::invalid_argument("There must be a tile size for each dimension");
+
+
+    std::array<std::size_t, N> newSizes, newStrides;
+
+    std::copy(sizes.begin(), sizes.end(), newSizes.begin());
+    std::copy(strides.begin(), strides.end(), newStrides.begin());
+
+    return help::TileRange<T, N>(c.data(), newSizes, newStrides, shape);
+}
+
+template <class C, typename... Ints, help::EnableIfIntegral<Ints...> = 0>
+auto tiles (C&& c, Ints... shape)
+{
+    return tiles(c, std::array<std::size_t, sizeof...(Ints)>{ std::size_t(shape)... });
+}
+//@}
+
+
+
+/** Calls 'f(tile)' for each tile of 'range' in parallel, in no specific order. The tiles are
+  * disjoint, so 'f' can write to its tile without synchronization.
+*/
+template <typename T, std::size_t N, class F>
+void parallel_for_tiles (const help::TileRange<T, N>& range, F f)
+{
+    auto& pool = ThreadPool::global();
+
+    const std::size_t grain = std::max<std::size_t>(range.size() / (8 * pool.size()), 1);
+
+    pool.parallelFor(0, range.size(), grain, [&](std::size_t first, std::size_t last){
+        for(std::size_t t = first; t < last; ++t)
+            f(range[t]);
+    });
+}
+
+
+} // namespace cnt
+
+
+#endif // CNT_TILES_H
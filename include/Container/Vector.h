@@ -7,20 +7,92 @@
 #define CNT_VECTOR_H
 
 
+#include <utility>
+
 #include "Helpers.h"
 
 
 namespace cnt
 {
 
-/** 'cnt::Vector' inherits from 'std::vector<T>' if it is not supplied with compile time size
+/** Tag to construct a container whose elements are default initialized instead of value
+  * initialized, so the elements of trivial types are left unwritten, like in
+  * 'Container<float> c(cnt::uninitialized, 4096, 4096)'. The memory is not touched until the
+  * elements are written, which is faster when they are all going to be overwritten, and lets
+  * 'parallel_fill' decide which thread touches each page first.
+*/
+struct Uninitialized {};
+
+constexpr Uninitialized uninitialized{};
+
+
+
+namespace help
+{
+
+/** Adapts the allocator 'Alloc' to default initialize the elements constructed without
+  * arguments, so 'std::vector::resize(n)' leaves the elements of trivial types unwritten.
+  * Everything else is done by 'Alloc'. 'Container' keeps its elements with this adaptor over
+  * the allocator it is given, and value initializes them explicitly, with 'resize(n, T())',
+  * except in the constructors taking 'Uninitialized'.
+*/
+template <class Alloc>
+struct InitAllocator : public Alloc
+{
+    using Traits = std::allocator_traits<Alloc>;
+
+
+    template <typename U>
+    struct rebind { using other = InitAllocator<typename Traits::template rebind_alloc<U>>; };
+
+
+    InitAllocator () = default;
+
+    InitAllocator (const Alloc& alloc) : Alloc(alloc) {}
+
+    template <class B>
+    InitAllocator (const InitAllocator<B>& alloc) : Alloc(static_cast<const B&>(alloc)) {}
+
+
+
+    template <typename U>
+    void construct (U* p)
+    {
+        ::new(static_cast<void*>(p)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct (U* p, Args&&... args)
+    {
+        Traits::construct(*this, p, std::forward<Args>(args)...);
+    }
+};
+
+
+template <class A, class B>
+bool operator == (const InitAllocator<A>& a, const InitAllocator<B>& b)
+{
+    return static_cast<const A&>(a) == static_cast<const B&>(b);
+}
+
+template <class A, class B>
+bool operator != (const InitAllocator<A>& a, const InitAllocator<B>& b) { return !(a == b); }
+
+} // namespace help
+
+
+
+
+/** 'cnt::Vector' inherits from 'std::vector<T, Alloc>' if it is not supplied with compile time size
   * or if the given compile time size is greater than the value defined at 'cnt::help::maxSize',
   * for maximum stack size allocation. Otherwise it inherits from 'std::array<T, N>'.
+  *
+  * \tparam Alloc The allocator of the 'std::vector'. See 'Allocator.h' for aligned and huge page ones.
 */
-template <typename T, std::size_t N = 0>
-struct Vector : public help::SelectType<T, N>
+template <typename T, std::size_t N = 0, class Alloc = std::allocator<T>>
+struct Vector : public help::SelectType<T, N, Alloc>
 {
-    using Base = help::SelectType<T, N>;
+    using Base = help::SelectType<T, N, Alloc>;
 
     using Base::Base;   /// Inherits all constructors of std::vector. std::array has no constructor
 
@@ -35,7 +107,15 @@ struct Vector : public help::SelectType<T, N>
 
     /// If compile time size 'N' is greater than 'help::maxSize', initialize the 'std::vector' with this size
     template <std::size_t M = Size, help::EnableIfVector<M> = 0>
-    Vector () : Base(Size) {}
+    Vector () : Base(Size, T()) {}
+
+    /// Same as above, but the elements are default initialized if 'Alloc' is an 'InitAllocator'
+    template <std::size_t M = Size, help::EnableIfVector<M> = 0>
+    explicit Vector (Uninitialized) : Base(Size) {}
+
+    /// The elements of the 'std::array' are default initialized
+    template <std::size_t M = Size, help::EnableIfArray<M> = 0>
+    explicit Vector (Uninitialized) {}
 
 
     /// For std::array aggregate initialization
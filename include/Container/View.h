@@ -0,0 +1,246 @@
+/** \file View.h
+  *
+  * A non-owning view over memory that is not managed by a 'Container', with the
+  * same interface to access the elements and to take slices.
+*/
+
+#ifndef CNT_VIEW_H
+#define CNT_VIEW_H
+
+#include "Container.h"
+
+
+namespace cnt
+{
+
+namespace help
+{
+
+
+template <typename T, class S>
+class View;
+
+
+/** Interprets a contiguous buffer given by a pointer as a multidimensional array in row major
+  * order. The view does not own the buffer: it is only a pointer plus the 'Dimensions', so it
+  * is trivially copyable and creating one does not allocate or touch the elements. For a static
+  * shape the view is a single pointer.
+  *
+  * \tparam T The type of the elements. Use a const type for read only buffers.
+  * \tparam Is The compile time size of each dimension or '0' for each dimension whose size is
+  *         given at runtime (see 'Dimensions'). The number of dimensions must be known.
+*/
+template <typename T, std::size_t... Is>
+class View<T, Shape<Is...>> : public Dimensions<Is...>
+{
+public:
+
+    static_assert(sizeof...(Is), "The number of dimensions of a 'View' must be given at compile time");
+
+
+    /** Some type definitions */
+    //@{
+    using Dims = Dimensions<Is...>;
+
+
+    using value_type = std::remove_const_t<T>;
+
+    using reference = T&;
+
+    using const_reference = const T&;
+
+
+    using iterator = T*;
+
+    using const_iterator = const T*;
+
+
+    static constexpr std::size_t Size = help::multiply_v<Is...>;
+    //@}
+
+
+
+    friend class Slice<View>;           /// Friend definition for the 'Slice' class
+    friend class Slice<const View>;     /// Friend definition for the 'Slice' class
+
+
+
+
+// --------------------------------- Constructors ---------------------------------------------- //
+
+
+    /// An empty view
+    View () : data_(nullptr) {}
+
+
+    /// For a static shape, only the pointer is needed
+    template <std::size_t M = Size, std::enable_if_t<(M > 0), int> = 0>
+    explicit View (T* data) : data_(data) {}
+
+
+    /** The size of each dimension is given by integrals, like in 'View<int, 0, 0>(p, 3, 4)'.
+      * There must be as many sizes as dimensions.
+    */
+    template <typename... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIntegral< std::decay_t< Args >... > = 0 >
+    View (T* data, Args... args) : Dims{ std::size_t(args)... }, data_(data)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Is), "There must be one size for each dimension");
+    }
+
+
+    /// The sizes are given by iterables of integrals, like 'View<int, 0, 0, 0>(p, c.sizes())'
+    template <class... Args, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              std::enable_if_t<sizeof...(Args), int> = 0,
+              help::EnableIfIterable< std::remove_reference_t< Args >... > = 0>
+    View (T* data, const Args&... args) : Dims(help::concat(args...)), data_(data) {}
+
+
+    /// The sizes are given by the range [begin, end) of integrals
+    template <typename U, typename V, std::size_t M = Size, help::EnableIfZero< M > = 0,
+              help::EnableIfIterator< std::decay_t< U >, std::decay_t< V > > = 0>
+    View (T* data, const U& begin, const V& end) : Dims(begin, end), data_(data) {}
+
+
+    /// The sizes are given by a 'std::initializer_list'
+    template<typename U, std::size_t M = Size, help::EnableIfZero< M > = 0,
+             help::EnableIfIntegral<std::decay_t<U>> = 0>
+    View (T* data, std::initializer_list<U> il) : View(data, il.begin(), il.end()) {}
+
+
+
+
+// ------------------------------- Access - operator() --------------------------------------------- //
+
+
+    /** The same accessors as in 'Container', so 'Accessor' can delegate to them */
+    //@{
+
+    /// Integral or iterable types
+    template <typename... Args>
+    const_reference operator () (IntegralType, const Args&... args) const
+    {
+        return data_[Dims::offset(args...)];
+    }
+
+
+    /// Iterators
+    template <typename U>
+    const_reference operator () (IteratorType, const U& begin) const
+    {
+        return data_[std::inner_product(weights.begin(), weights.end(), begin, std::size_t(0))];
+    }
+
+
+    /// 'std::initializer_list'
+    template <typename U>
+    const_reference operator () (std::initializer_list<U> il) const
+    {
+        return data_[std::inner_product(weights.begin(), weights.end(), il.begin(), std::size_t(0))];
+    }
+    //@}
+
+
+
+    /** Access to the 'p'th element of the buffer */
+    //@{
+    const_reference operator [] (std::size_t p) const { return data_[p]; }
+
+    reference operator [] (std::size_t p) { return data_[p]; }
+    //@}
+
+
+
+
+    /// Size of each dimension
+    constexpr std::size_t size (int p) const { return dimSize[p]; }
+
+    /// Total size
+    constexpr std::size_t size ()      const { return dimSize[0] * weights[0]; }
+
+    constexpr auto sizes ()            const { return dimSize; }
+
+    /// Distance, in elements, between consecutive positions of each dimension
+    constexpr auto strides ()          const { return weights; }
+
+    constexpr std::size_t numDimensions () const { return numDimensions_; }
+
+
+
+    /** Pointer to the buffer, and begin and end */
+    //@{
+    T* data () const { return data_; }
+
+
+    iterator begin () const { return data_; }
+
+    iterator end () const { return data_ + size(); }
+
+    const_iterator cbegin () const { return data_; }
+
+    const_iterator cend () const { return data_ + size(); }
+    //@}
+
+
+
+
+//---------------------------------- Slice ---------------------------------------------- //
+
+
+    /** Takes a 'Slice' of the view, exactly like 'Container::slice'.
+      *
+      * \param[in] args Variadic integral arguments defining the dimensions to 'take a slice'.
+    */
+    //@{
+    template <typename... Args>
+    auto slice (const Args&... args) const
+    {
+        return Accessor<Slice<const View>>(*this, args...);
+    }
+
+    template <typename... Args>
+    auto slice (const Args&... args)
+    {
+        return Accessor<Slice<View>>(*this, args...);
+    }
+    //@}
+
+
+
+private:
+
+
+    /// The number of dimensions, their sizes and weights are defined in 'Dimensions'
+    //@{
+    using Dims::numDimensions_;
+
+    using Dims::dimSize;
+
+    using Dims::weights;
+
+    using Dims::mapIndex;
+    //@}
+
+
+    T* data_;       /// The viewed buffer
+
+};
+
+
+} // namespace help
+
+
+
+/** A non-owning view over a buffer, with the same access interface as 'Container'. For example,
+  * 'ContainerView<float, 0, 0, 0> v(ptr, 4, 5, 6)' views 'ptr' as a 4 x 5 x 6 array, and
+  * 'ContainerView<const int, 3, 4> w(ptr)' as a read only 3 x 4 array.
+*/
+template <typename T, std::size_t... Is>
+using ContainerView = help::Accessor<help::View<T, Shape<Is...>>>;
+
+
+
+} // namespace cnt
+
+
+#endif // CNT_VIEW_H
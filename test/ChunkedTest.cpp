@@ -0,0 +1,206 @@
+#include <random>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Container/Chunked.h"
+
+
+namespace
+{
+	TEST(ChunkedTest, Codec)
+	{
+		std::mt19937 gen(3);
+
+		std::vector<float> smooth(10000);
+		std::vector<std::uint16_t> noise(777);
+		std::vector<double> zeros(4096, 0.0);
+
+		for(std::size_t i = 0; i < smooth.size(); ++i)
+			smooth[i] = float(i / 100);
+
+		for(auto& x : noise)
+			x = std::uint16_t(gen());
+
+
+		auto roundTrip = [](const auto& v){
+			using T = typename std::decay_t<decltype(v)>::value_type;
+
+			const auto code = cnt::help::encodeChunk(v.data(), v.size());
+
+			std::vector<T> res(v.size());
+
+			cnt::help::decodeChunk(code, res.data(), res.size());
+
+			EXPECT_EQ(res, v);
+
+			return code.size();
+		};
+
+		EXPECT_LT(roundTrip(smooth), smooth.size() * sizeof(float) / 10);
+		EXPECT_LT(roundTrip(zeros), zeros.size() * sizeof(double) / 100);
+		roundTrip(noise);
+		roundTrip(std::vector<char>{ 'a' });
+		roundTrip(std::vector<int>{});
+
+
+		auto code = cnt::help::encodeChunk(smooth.data(), smooth.size());
+
+		code.resize(code.size() / 2);
+
+		EXPECT_THROW(cnt::help::decodeChunk(code, smooth.data(), smooth.size()), std::runtime_error);
+	}
+
+
+
+	TEST(ChunkedTest, Access)
+	{
+		cnt::Chunked<int> c({10, 11, 12}, {4, 3, 5}, 2);
+
+		EXPECT_EQ(c.size(), 1320);
+		EXPECT_EQ(c.numChunks(), 3 * 4 * 3);
+		EXPECT_EQ(c.compressedBytes(), 0);
+		EXPECT_EQ(c(9, 10, 11), 0);
+
+
+		for(int i = 0; i < 10; ++i)
+			for(int j = 0; j < 11; ++j)
+				for(int k = 0; k < 12; ++k)
+					c(i, j, k) = i * 1000 + j * 100 + k;
+
+		const auto& cc = c;
+
+		for(int i = 0; i < 10; ++i)
+			for(int j = 0; j < 11; ++j)
+				for(int k = 0; k < 12; ++k)
+					EXPECT_EQ(cc(i, j, k), i * 1000 + j * 100 + k);
+
+
+		EXPECT_EQ(int(c(std::vector<int>{ 7, 8 }, 9)), 7809);
+		EXPECT_EQ(cc(std::vector<int>{ 7, 8, 9 }), 7809);
+
+		c(0, 0, 0) = c(9, 10, 11);
+
+		EXPECT_EQ(cc(0, 0, 0), 9 * 1000 + 10 * 100 + 11);
+
+		c(1, 2, 3) += 7;
+		c(1, 2, 3) -= 3;
+		c(1, 2, 3) *= 2;
+		c(1, 2, 3) /= 4;
+
+		EXPECT_EQ(cc(1, 2, 3), (1203 + 4) * 2 / 4);
+
+		c.flush();
+
+		EXPECT_GT(c.compressedBytes(), 0);
+
+
+		EXPECT_THROW(c(10, 0, 0), std::invalid_argument);
+		EXPECT_THROW(cc(0, 0), std::invalid_argument);
+		EXPECT_THROW(cc(0, 0, 0, 0), std::invalid_argument);
+		EXPECT_THROW(cnt::Chunked<int>({}, {}), std::invalid_argument);
+		EXPECT_THROW(cnt::Chunked<int>({2, 3}, {2}), std::invalid_argument);
+		EXPECT_THROW(cnt::Chunked<int>({2, 3}, {2, 0}), std::invalid_argument);
+	}
+
+
+
+	TEST(ChunkedTest, ReadWrite)
+	{
+		cnt::Container<double, 0, 0, 0> a(13, 17, 9);
+
+		for(std::size_t i = 0; i < a.size(0); ++i)
+			for(std::size_t j = 0; j < a.size(1); ++j)
+				for(std::size_t k = 0; k < a.size(2); ++k)
+					a(i, j, k) = std::sin(0.1 * i) + j * 0.5 - k;
+
+		auto c = cnt::chunked(a, {4, 8, 3}, 3);
+
+		EXPECT_EQ(cnt::dense(c).sizes(), std::vector<std::size_t>({13, 17, 9}));
+		EXPECT_TRUE(std::equal(a.begin(), a.end(), cnt::dense(c).begin()));
+
+
+		/// The cached chunks must be seen by the reads, and the reads must be seen by the cache
+		c(5, 9, 1) = 42.0;
+		c(12, 16, 8) = -1.0;
+
+		auto box = c.read({2, 3, 1}, {12, 16, 7});
+
+		for(std::size_t i = 0; i < box.size(0); ++i)
+			for(std::size_t j = 0; j < box.size(1); ++j)
+				for(std::size_t k = 0; k < box.size(2); ++k)
+					EXPECT_EQ(box(i, j, k), i + 2 == 5 && j + 3 == 9 && k + 1 == 1 ? 42.0 : a(i + 2, j + 3, k + 1));
+
+		for(auto& x : box)
+			x = -x;
+
+		c.write({1, 1, 2}, box);
+
+		EXPECT_EQ(double(c(12, 16, 8)), -1.0);
+
+		for(std::size_t i = 0; i < box.size(0); ++i)
+			for(std::size_t j = 0; j < box.size(1); ++j)
+				for(std::size_t k = 0; k < box.size(2); ++k)
+					EXPECT_EQ(double(c(i + 1, j + 1, k + 2)), box(i, j, k));
+
+		EXPECT_EQ(double(c(0, 0, 0)), a(0, 0, 0));
+		EXPECT_EQ(double(c(11, 14, 8)), a(11, 14, 8));
+
+
+		const auto s = c.slice(4);
+
+		static_assert(std::is_const<decltype(c.slice(4))>::value, "A slice is a copy, so it can not be written");
+
+		ASSERT_EQ(s.sizes(), std::vector<std::size_t>({17, 9}));
+
+		for(std::size_t j = 0; j < 17; ++j)
+			for(std::size_t k = 0; k < 9; ++k)
+				EXPECT_EQ(s(j, k), double(c(4, j, k)));
+
+
+		EXPECT_EQ(c.read({3, 3, 3}, {3, 5, 5}).size(), 0);
+		EXPECT_THROW(c.read({0, 0, 0}, {14, 1, 1}), std::invalid_argument);
+		EXPECT_THROW(c.read({2, 0, 0}, {1, 1, 1}), std::invalid_argument);
+		EXPECT_THROW(c.write({10, 0, 0}, box), std::invalid_argument);
+		EXPECT_THROW(c.slice(13), std::invalid_argument);
+		EXPECT_THROW(cnt::Chunked<int>({5}, {2}).slice(0), std::invalid_argument);
+	}
+
+
+
+	TEST(ChunkedTest, Concurrent)
+	{
+		cnt::Chunked<int> c({32, 32}, {4, 4}, 3);
+
+		std::vector<std::thread> threads;
+
+		for(int t = 0; t < 4; ++t)
+			threads.emplace_back([&c, t]{
+				for(int r = 0; r < 20; ++r)
+					for(int i = 8 * t; i < 8 * t + 8; ++i)
+						for(int j = 0; j < 32; ++j)
+							c(i, j) = r * 10000 + i * 100 + j;
+			});
+
+		for(auto& t : threads)
+			t.join();
+
+
+		const auto& cc = c;
+
+		const auto all = cc.read({0, 0}, {32, 32});
+
+		for(int i = 0; i < 32; ++i)
+			for(int j = 0; j < 32; ++j)
+				EXPECT_EQ(all(i, j), 190000 + i * 100 + j);
+
+
+		std::vector<int> seen(32);
+
+		cnt::ThreadPool::global().parallelFor(0, 32, 1, [&](std::size_t b, std::size_t e){
+			for(std::size_t i = b; i < e; ++i)
+				seen[i] = cc.read({i, 0}, {i + 1, 32})(0, 31) - cc(i, 0);
+		});
+
+		EXPECT_EQ(seen, std::vector<int>(32, 31));
+	}
+}
@@ -1,6 +1,7 @@
 #include <list>
 #include <set>
 #include <random>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "Container/Container.h"
@@ -101,5 +102,269 @@ namespace
 	}
 
 
-} // namespace
+	TEST(ContainerTest, StaticShape)
+	{
+		static_assert(sizeof(cnt::Container<float, 4, 4>) == 16 * sizeof(float), "");
+		static_assert(sizeof(cnt::Container<char, 3, 5, 7>) == 3 * 5 * 7, "");
+
+
+		cnt::Container<int, 7, 3, 6, 2> c;
+
+		cnt::Container<int> d(7, 3, 6, 2);
+
+		std::iota(c.begin(), c.end(), 0);
+		std::iota(d.begin(), d.end(), 0);
+
+
+		EXPECT_EQ(c.numDimensions(), 4);
+
+		EXPECT_EQ(c(5, 2, 4, 1), d(5, 2, 4, 1));
+		EXPECT_EQ(c(5, 2), d(5, 2));
+		EXPECT_EQ(c(std::vector<int>{5, 2}, 4, 1), d(5, 2, 4, 1));
+		EXPECT_EQ(c.slice(5, 2)(4, 1), d(5, 2, 4, 1));
+	}
+
+
+	TEST(ContainerTest, FixedRank)
+	{
+		static_assert(sizeof(cnt::Container<float, 0, 0>) == sizeof(std::vector<float>) + 4 * sizeof(std::size_t), "");
+
+
+		cnt::Container<int, 0, 0, 0, 0> a(7, 3, 6, 2);
+		cnt::Container<int, 0, 0, 0, 0> b({7, 3, 6, 2});
+		cnt::Container<int, 0, 0, 0, 0> c(std::vector<int>{7, 3}, std::list<long>{6, 2});
+
+		cnt::Container<int> d(7, 3, 6, 2);
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(d.begin(), d.end(), 0);
+
+
+		EXPECT_EQ(a.numDimensions(), 4);
+
+		for(int i = 0; i < 4; ++i)
+		{
+			EXPECT_EQ(b.size(i), d.size(i));
+			EXPECT_EQ(c.size(i), d.size(i));
+		}
+
+		EXPECT_EQ(a.size(), d.size());
+		EXPECT_EQ(a(5, 2, 4, 1), d(5, 2, 4, 1));
+		EXPECT_EQ(a(std::vector<int>{5, 2}, 4, 1), d(5, 2, 4, 1));
+		EXPECT_EQ(a({5, 2, 4, 1}), d(5, 2, 4, 1));
+		EXPECT_EQ(a.slice(5)(2, 4, 1), d(5, 2, 4, 1));
+
+
+		/// There must be exactly one size for each dimension
+		EXPECT_THROW((cnt::Container<int, 0, 0>({3, 4, 5})), std::invalid_argument);
+		EXPECT_THROW((cnt::Container<int, 0, 0, 0>({3, 4})), std::invalid_argument);
+		EXPECT_THROW((cnt::Container<int, 0, 0, 0>(std::vector<int>{3, 4}, std::list<long>{5, 6})), std::invalid_argument);
+		EXPECT_THROW((cnt::Container<int, 0>(std::vector<int>{3, 4, 5, 6, 7, 8})), std::invalid_argument);
+
+		const std::size_t sizes[] = { 3, 4, 5 };
+
+		EXPECT_THROW((cnt::Container<int, 0, 0>(std::begin(sizes), std::end(sizes))), std::invalid_argument);
+		EXPECT_THROW((cnt::ContainerView<int, 0, 0>(a.data(), std::begin(sizes), std::end(sizes))), std::invalid_argument);
+		EXPECT_THROW((cnt::ContainerView<int, 0, 0, 0, 0>(a.data(), {7, 3})), std::invalid_argument);
+	}
+
+
+	TEST(ContainerTest, Reshape)
+	{
+		cnt::Container<int> a(120);
+		cnt::Container<int, 0, 0> b(6, 20);
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(b.begin(), b.end(), 0);
+
+		const int* data = a.data();
+
+
+		a.reshape(4, 5, 6);
+
+		EXPECT_EQ(a.numDimensions(), 3);
+		EXPECT_EQ(a.size(1), 5);
+		EXPECT_EQ(a(2, 3, 4), 2 * 30 + 3 * 6 + 4);
+		EXPECT_EQ(a.slice(3)(1, 1), 3 * 30 + 7);
+		EXPECT_EQ(a.data(), data);
+
+		a.reshape({ 10, 12 });
+
+		EXPECT_EQ(a.numDimensions(), 2);
+		EXPECT_EQ(a(7, 11), 95);
+
+		const std::vector<int> sizes = { 12, 10 };
+
+		b.reshape(sizes.begin(), sizes.end());
+
+		EXPECT_EQ(b.size(0), 12);
+		EXPECT_EQ(b(11, 9), 119);
+
+
+		EXPECT_THROW(a.reshape(7, 17), std::invalid_argument);
+		EXPECT_THROW(b.reshape(2, 3, 20), std::invalid_argument);
+		EXPECT_EQ(a.size(0), 10);
+	}
+
+
+
+	TEST(ContainerTest, ResizeOuter)
+	{
+		cnt::Container<int, 0, 0> a(0, 8);
+		cnt::Container<int> b(2, 3, 4);
+
+		std::iota(b.begin(), b.end(), 0);
+
+
+		for(int i = 0; i < 100; ++i)
+		{
+			a.resizeOuter(i + 1);
+
+			for(int j = 0; j < 8; ++j)
+				a(i, j) = 8 * i + j;
+		}
+
+		EXPECT_EQ(a.size(0), 100);
+		EXPECT_EQ(a.size(), 800);
+		EXPECT_LE(a.capacity(), 2 * 800);
+
+		for(int i = 0; i < 800; ++i)
+			EXPECT_EQ(a[i], i);
+
 
+		b.resizeOuter(5);
+
+		EXPECT_EQ(b.size(0), 5);
+		EXPECT_EQ(b(1, 2, 3), 23);
+		EXPECT_EQ(b(4, 2, 3), 0);
+
+		b.resizeOuter(1);
+
+		EXPECT_EQ(b.size(), 12);
+		EXPECT_EQ(b(0, 2, 3), 11);
+	}
+
+
+
+	TEST(ContainerTest, Allocator)
+	{
+		auto aligned = [](const void* p, std::size_t alignment){ return reinterpret_cast<std::uintptr_t>(p) % alignment == 0; };
+
+
+		cnt::BasicContainer<float, cnt::Shape<>, cnt::AlignedAllocator<float>> a(13, 7, 3);
+		cnt::BasicContainer<double, cnt::Shape<0, 0>, cnt::AlignedAllocator<double, 256>> b(100, 37);
+		cnt::BasicContainer<char, cnt::Shape<1000, 200>, cnt::AlignedAllocator<char, 128>> c;
+		cnt::BasicContainer<int, cnt::Shape<>, cnt::HugePageAllocator<int>> d(1 << 10, 1 << 10);
+
+
+		EXPECT_TRUE(aligned(a.data(), 64));
+		EXPECT_TRUE(aligned(b.data(), 256));
+		EXPECT_TRUE(aligned(c.data(), 128));
+		EXPECT_TRUE(aligned(d.data(), 1 << 21));
+
+		EXPECT_EQ(a.size(), 13 * 7 * 3);
+		EXPECT_EQ(b.size(), 100 * 37);
+		EXPECT_EQ(c.size(), 1000 * 200);
+		EXPECT_EQ(d.size(), 1 << 20);
+
+
+		using Aligned = cnt::AlignedAllocator<double, 256>;
+
+		static_assert(std::is_same<decltype(b)::allocator_type, Aligned>::value, "");
+		static_assert(std::is_same<decltype(b.get_allocator()), Aligned>::value, "");
+
+
+		std::iota(d.begin(), d.end(), 0);
+
+		EXPECT_EQ(d(3, 5), 3 * 1024 + 5);
+		EXPECT_EQ(std::count(a.begin(), a.end(), 0.0f), a.size());
+	}
+
+
+
+	TEST(ContainerTest, Uninitialized)
+	{
+		cnt::Container<int> a(cnt::uninitialized, 4, 5, 6);
+		cnt::Container<float, 0, 0> b(cnt::uninitialized, std::vector<int>{ 7, 8 });
+		cnt::Container<double, 3, 4> c(cnt::uninitialized);
+		cnt::BasicContainer<char, cnt::Shape<1000, 200>> d(cnt::uninitialized);
+		cnt::BasicContainer<float, cnt::Shape<0, 0>, cnt::AlignedAllocator<float>> e(cnt::uninitialized, 9, 10);
+		cnt::Container<std::string> f(cnt::uninitialized, 2, 3);
+
+		EXPECT_EQ(a.sizes(), std::vector<std::size_t>({ 4, 5, 6 }));
+		EXPECT_EQ(b.size(1), 8);
+		EXPECT_EQ(c.size(), 12);
+		EXPECT_EQ(d.size(), 200000);
+		EXPECT_EQ(e.size(), 90);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(e.data()) % 64, 0);
+		EXPECT_EQ(f(1, 2), "");
+
+
+		std::iota(a.begin(), a.end(), 0);
+
+		EXPECT_EQ(a(3, 4, 5), 119);
+
+
+		/// Only the construction skips the initialization
+		a.resizeOuter(6);
+
+		EXPECT_EQ(a(5, 4, 5), 0);
+
+		cnt::Container<int> g(10, 10);
+
+		EXPECT_EQ(std::count(g.begin(), g.end(), 0), 100);
+
+
+		/// A container made inside the construction of an uninitialized one is value initialized
+		struct Inner
+		{
+			Inner () : c(3, 4) {}
+
+			cnt::Container<int> c;
+		};
+
+		cnt::Container<Inner> h(cnt::uninitialized, 2);
+
+		EXPECT_EQ(std::count(h(1).c.begin(), h(1).c.end(), 0), 12);
+	}
+
+
+
+	TEST(ContainerTest, IndexType)
+	{
+		using Small = cnt::BasicContainer<int, cnt::Shape<0, 0, 0>, std::allocator<int>, cnt::RowMajor, std::uint32_t>;
+		using Tiny = cnt::BasicContainer<char, cnt::Shape<0, 0>, std::allocator<char>, cnt::RowMajor, std::uint16_t>;
+
+		Small a(4, 5, 6);
+		cnt::Container<int, 0, 0, 0> b(4, 5, 6);
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(b.begin(), b.end(), 0);
+
+		EXPECT_TRUE((std::is_same<decltype(a.sizes()), std::array<std::uint32_t, 3>>::value));
+		EXPECT_LT(sizeof(a.slice(0)), sizeof(b.slice(0)));
+		EXPECT_EQ(a(3, 4, 5), b(3, 4, 5));
+		EXPECT_EQ(a(std::vector<int>{ 2, 3 }, 4), b(2, 3, 4));
+		EXPECT_EQ(a.slice(2, 1)[3], b.slice(2, 1)[3]);
+		EXPECT_EQ(a.slice(3).size(), 30);
+		EXPECT_TRUE(std::equal(a.slice(1).begin(), a.slice(1).end(), b.slice(1).begin()));
+
+
+		/// The positions past 2^15 are kept, the sizes that do not fit are rejected
+		Tiny c(250, 250);
+
+		c(249, 249) = 'x';
+
+		EXPECT_EQ(c.slice(249)[249], 'x');
+		EXPECT_EQ(c.slice(249).data() - c.data(), 249 * 250);
+
+		EXPECT_THROW(Tiny(300, 300), std::invalid_argument);
+		EXPECT_THROW(Tiny(70000, 1), std::invalid_argument);
+		EXPECT_THROW(c.resizeOuter(263), std::invalid_argument);
+		EXPECT_THROW(c.reshape(300, 300), std::invalid_argument);
+
+		c.resizeOuter(262);
+
+		EXPECT_EQ(c.size(), 65500);
+	}
+}
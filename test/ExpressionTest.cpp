@@ -0,0 +1,109 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Expression.h"
+
+
+namespace
+{
+	TEST(ExpressionTest, Arithmetic)
+	{
+		std::mt19937 gen(std::random_device{}());
+
+		auto random = [&]{ return std::uniform_real_distribution<double>(1.0, 2.0)(gen); };
+
+
+		cnt::Container<double> a(6, 7, 8), b(6, 7, 8), c(6, 7, 8), d(6, 7, 8), e(6, 7, 8), r(6, 7, 8);
+
+		std::generate(a.begin(), a.end(), random);
+		std::generate(b.begin(), b.end(), random);
+		std::generate(c.begin(), c.end(), random);
+		std::generate(d.begin(), d.end(), random);
+		std::generate(e.begin(), e.end(), random);
+
+
+		r = a * b + c * d - e;
+
+		for(int i = 0; i < r.size(); ++i)
+			EXPECT_DOUBLE_EQ(r[i], a[i] * b[i] + c[i] * d[i] - e[i]);
+
+
+		r = 2.0 * a / 4 - (-b) + 1;
+
+		for(int i = 0; i < r.size(); ++i)
+			EXPECT_DOUBLE_EQ(r[i], 2.0 * a[i] / 4 + b[i] + 1);
+
+
+		r = cnt::sqrt(a) + cnt::exp(-b) * cnt::pow(c, 2.0) - cnt::max(d, e);
+
+		for(int i = 0; i < r.size(); ++i)
+			EXPECT_NEAR(r[i], std::sqrt(a[i]) + std::exp(-b[i]) * std::pow(c[i], 2.0) - std::max(d[i], e[i]), 1e-12);
+	}
+
+
+
+	TEST(ExpressionTest, CompoundAssignment)
+	{
+		cnt::Container<int, 4, 5> a, b;
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(b.begin(), b.end(), 10);
+
+		a += b;
+		a *= 2;
+		a -= b * 2;
+		a /= 2;
+
+		for(int i = 0; i < a.size(); ++i)
+			EXPECT_EQ(a[i], i);
+	}
+
+
+
+	TEST(ExpressionTest, Slices)
+	{
+		cnt::Container<float> a(5, 6, 7);
+		cnt::Container<float, 0, 0> b(6, 7);
+
+		std::iota(a.begin(), a.end(), 0.0f);
+		std::iota(b.begin(), b.end(), 0.0f);
+
+		cnt::ContainerView<float, 6, 7> v(b.data());
+
+
+		a.slice(2) = a.slice(1) + b * 2.0f - v;
+
+		for(int j = 0; j < 6; ++j)
+			for(int k = 0; k < 7; ++k)
+				EXPECT_EQ(a(2, j, k), a(1, j, k) + b(j, k));
+	}
+
+
+
+	TEST(ExpressionTest, Sizes)
+	{
+		cnt::Container<double> a(3, 4), b(4, 4), c(3, 4);
+
+		EXPECT_THROW(a + b, std::invalid_argument);
+		EXPECT_THROW(c = a * b, std::invalid_argument);
+		EXPECT_THROW(b += a, std::invalid_argument);
+		EXPECT_NO_THROW(c = a * 3.0 - c);
+
+
+		/// The same total size is not enough: the shapes must match
+		cnt::Container<int> d(2, 3), e(3, 2), f(2, 3), g(6);
+
+		EXPECT_THROW(d + e, std::invalid_argument);
+		EXPECT_THROW(f = d + e, std::invalid_argument);
+		EXPECT_THROW(f += e, std::invalid_argument);
+		EXPECT_THROW(f = -e, std::invalid_argument);
+		EXPECT_THROW((cnt::Container<int>(2, 3, 1) + d), std::invalid_argument);
+		EXPECT_THROW(f = g + e, std::invalid_argument);
+		EXPECT_THROW(f = (g + 1) * e, std::invalid_argument);
+		EXPECT_NO_THROW(f = d + g);
+		EXPECT_NO_THROW(f = g + d);
+		EXPECT_NO_THROW(f += 2 * d);
+	}
+
+
+} // namespace
@@ -0,0 +1,166 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Gemm.h"
+#include "Container/Permute.h"
+
+
+namespace
+{
+	/// The product with the triple loop over 'operator()'
+	template <class A, class B>
+	cnt::Container<double, 0, 0> naive (const A& a, const B& b)
+	{
+		cnt::Container<double, 0, 0> c(a.size(0), b.size(1));
+
+		for(std::size_t i = 0; i < a.size(0); ++i)
+			for(std::size_t j = 0; j < b.size(1); ++j)
+			{
+				double s = 0.0;
+
+				for(std::size_t p = 0; p < a.size(1); ++p)
+					s += a(i, p) * b(p, j);
+
+				c(i, j) = s;
+			}
+
+		return c;
+	}
+
+
+	template <class C>
+	void randomize (C& c, int seed)
+	{
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		for(auto& x : c)
+			x = dist(gen);
+	}
+
+
+
+	TEST(GemmTest, Product)
+	{
+		for(auto isa : { cnt::Isa::Scalar, cnt::bestIsa() })
+		{
+			cnt::activeIsa() = isa;
+
+			for(auto sizes : { std::array<std::size_t, 3>{ 1, 1, 1 }, std::array<std::size_t, 3>{ 7, 13, 5 },
+							   std::array<std::size_t, 3>{ 130, 300, 70 }, std::array<std::size_t, 3>{ 50, 3, 2100 } })
+			{
+				cnt::Container<double, 0, 0> a(sizes[0], sizes[1]), b(sizes[1], sizes[2]);
+
+				randomize(a, 1);
+				randomize(b, 2);
+
+				auto c = cnt::matmul(a, b);
+				auto d = naive(a, b);
+
+				static_assert(std::is_same<decltype(c), cnt::Container<double, 0, 0>>::value, "");
+
+				ASSERT_EQ(c.size(0), sizes[0]);
+				ASSERT_EQ(c.size(1), sizes[2]);
+
+				for(std::size_t i = 0; i < c.size(); ++i)
+					EXPECT_NEAR(c.begin()[i], d.begin()[i], 1e-10);
+
+
+				auto e = d;
+
+				cnt::gemm(2.0, a, b, -1.0, e);
+
+				for(std::size_t i = 0; i < c.size(); ++i)
+					EXPECT_NEAR(e.begin()[i], d.begin()[i], 1e-10);
+			}
+		}
+
+		cnt::activeIsa() = cnt::bestIsa();
+
+
+		cnt::Container<float, 0, 0> a(20, 30), b(30, 40), c(20, 40);
+
+		randomize(a, 3);
+		randomize(b, 4);
+
+		cnt::matmul(a, b, c);
+
+		auto d = naive(a, b);
+
+		for(std::size_t i = 0; i < c.size(); ++i)
+			EXPECT_NEAR(c.begin()[i], d.begin()[i], 1e-4);
+
+
+		EXPECT_THROW(cnt::matmul(a, a), std::invalid_argument);
+		EXPECT_THROW(cnt::matmul(a, b, a), std::invalid_argument);
+		EXPECT_THROW(cnt::matmul(cnt::Container<float>(2, 2, 2, 2), cnt::Container<float>(2, 2, 2, 2)), std::invalid_argument);
+	}
+
+
+
+	TEST(GemmTest, Strided)
+	{
+		cnt::Container<double, 0, 0> a(40, 30), b(50, 40);
+		cnt::BasicContainer<double, cnt::Shape<0, 0>, std::allocator<double>, cnt::ColumnMajor> c(30, 50);
+
+		randomize(a, 5);
+		randomize(b, 6);
+
+		auto at = cnt::permuted(a, {1, 0});
+		auto bt = cnt::permuted(b, {1, 0});
+
+		cnt::matmul(at, bt, c);
+
+		auto d = naive(at, bt);
+
+		for(std::size_t i = 0; i < 30; ++i)
+			for(std::size_t j = 0; j < 50; ++j)
+				EXPECT_NEAR(c(i, j), d(i, j), 1e-10);
+
+
+		auto s = cnt::strided(a, cnt::range(0, 40, 3), cnt::range(1, 30, 2));
+		auto e = cnt::matmul(s, cnt::strided(b, cnt::range(0, 15), cnt::all));
+		auto f = naive(s, cnt::strided(b, cnt::range(0, 15), cnt::all));
+
+		for(std::size_t i = 0; i < e.size(); ++i)
+			EXPECT_NEAR(e.begin()[i], f.begin()[i], 1e-10);
+	}
+
+
+
+	TEST(GemmTest, Batched)
+	{
+		cnt::Container<float, 0, 0, 0> a(5, 9, 17), b(5, 17, 11);
+
+		randomize(a, 7);
+		randomize(b, 8);
+
+		auto c = cnt::matmul(a, b);
+
+		static_assert(std::is_same<decltype(c), cnt::Container<float, 0, 0, 0>>::value, "");
+
+		for(std::size_t t = 0; t < 5; ++t)
+		{
+			auto d = naive(a.slice(t), b.slice(t));
+
+			for(std::size_t i = 0; i < 9; ++i)
+				for(std::size_t j = 0; j < 11; ++j)
+					EXPECT_NEAR(c(t, i, j), d(i, j), 1e-4);
+		}
+
+
+		cnt::Container<float> e(5, 9, 17), f(5, 17, 11);
+
+		std::copy(a.begin(), a.end(), e.begin());
+		std::copy(b.begin(), b.end(), f.begin());
+
+		auto g = cnt::matmul(e, f);
+
+		EXPECT_EQ(g.numDimensions(), 3);
+		EXPECT_TRUE(std::equal(c.begin(), c.end(), g.begin(), g.end()));
+
+		EXPECT_THROW(cnt::matmul(a, cnt::Container<float, 0, 0, 0>(4, 17, 11)), std::invalid_argument);
+	}
+
+
+} // namespace
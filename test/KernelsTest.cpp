@@ -0,0 +1,115 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Kernels.h"
+#include "Container/Strided.h"
+
+
+namespace
+{
+	std::vector<cnt::Isa> supportedIsas ()
+	{
+		std::vector<cnt::Isa> isas;
+
+		for(auto isa : { cnt::Isa::Scalar, cnt::Isa::SSE, cnt::Isa::AVX2, cnt::Isa::AVX512 })
+			if(isa <= cnt::bestIsa())
+				isas.push_back(isa);
+
+		return isas;
+	}
+
+
+
+	TEST(KernelsTest, Reductions)
+	{
+		std::mt19937 gen(std::random_device{}());
+
+		for(auto isa : supportedIsas())
+		{
+			cnt::activeIsa() = isa;
+
+			for(int n : { 0, 1, 7, 33, 1000 })
+			{
+				cnt::Container<double> a(n), b(n);
+				cnt::Container<int> c(n);
+
+				std::generate(a.begin(), a.end(), [&]{ return std::uniform_real_distribution<double>(-1.0, 1.0)(gen); });
+				std::generate(b.begin(), b.end(), [&]{ return std::uniform_real_distribution<double>(-1.0, 1.0)(gen); });
+				std::generate(c.begin(), c.end(), [&]{ return std::uniform_int_distribution<int>(-100, 100)(gen); });
+
+
+				EXPECT_NEAR(cnt::sum(a), std::accumulate(a.begin(), a.end(), 0.0), 1e-9);
+				EXPECT_NEAR(cnt::dot(a, b), std::inner_product(a.begin(), a.end(), b.begin(), 0.0), 1e-9);
+				EXPECT_NEAR(cnt::norm(a), std::sqrt(std::inner_product(a.begin(), a.end(), a.begin(), 0.0)), 1e-9);
+
+				EXPECT_EQ(cnt::sum(c), std::accumulate(c.begin(), c.end(), 0));
+				EXPECT_EQ(cnt::dot(c, c), std::inner_product(c.begin(), c.end(), c.begin(), 0));
+
+				if(n)
+				{
+					EXPECT_EQ(cnt::min(a), *std::min_element(a.begin(), a.end()));
+					EXPECT_EQ(cnt::max(a), *std::max_element(a.begin(), a.end()));
+					EXPECT_EQ(cnt::min(c), *std::min_element(c.begin(), c.end()));
+					EXPECT_EQ(cnt::max(c), *std::max_element(c.begin(), c.end()));
+				}
+			}
+		}
+
+		cnt::activeIsa() = cnt::bestIsa();
+
+
+		cnt::Container<float> e(0);
+
+		EXPECT_THROW(cnt::min(e), std::invalid_argument);
+		EXPECT_THROW(cnt::dot(cnt::Container<float>(3), cnt::Container<float>(4)), std::invalid_argument);
+	}
+
+
+
+	TEST(KernelsTest, Elementwise)
+	{
+		for(auto isa : supportedIsas())
+		{
+			cnt::activeIsa() = isa;
+
+			cnt::Container<float, 0, 0> x(5, 37), y(5, 37);
+
+			std::iota(x.begin(), x.end(), 0.0f);
+
+			cnt::fill(y, 1.0f);
+			cnt::axpy(2.0f, x, y);
+
+			for(std::size_t i = 0; i < y.size(); ++i)
+				EXPECT_EQ(y[i], 2.0f * i + 1.0f);
+
+
+			cnt::fill(y.slice(2), 0.0f);
+
+			EXPECT_EQ(cnt::sum(y.slice(2)), 0.0f);
+			EXPECT_EQ(cnt::sum(y.slice(3)), cnt::sum(x.slice(3)) * 2.0f + 37.0f);
+		}
+
+		cnt::activeIsa() = cnt::bestIsa();
+	}
+
+
+
+	TEST(KernelsTest, Views)
+	{
+		cnt::Container<int> c(6, 7, 8);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		cnt::ContainerView<const int, 0, 0> v(c.data() + 7*8, 7, 8);
+
+		EXPECT_EQ(cnt::sum(v), std::accumulate(c.begin() + 7*8, c.begin() + 2*7*8, 0));
+		EXPECT_EQ(cnt::max(v), 2*7*8 - 1);
+
+		EXPECT_EQ(cnt::sum(cnt::strided(c, cnt::range(2, 4), cnt::all, cnt::all)),
+				  std::accumulate(c.begin() + 2*7*8, c.begin() + 4*7*8, 0));
+
+		EXPECT_THROW(cnt::sum(cnt::strided(c, cnt::all, 3, cnt::all)), std::invalid_argument);
+	}
+
+
+} // namespace
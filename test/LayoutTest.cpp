@@ -0,0 +1,156 @@
+#include <set>
+
+#include "gtest/gtest.h"
+#include "Container/Expression.h"
+
+
+namespace
+{
+	template <class L, std::size_t... Is>
+	using Cnt = cnt::BasicContainer<int, cnt::Shape<Is...>, std::allocator<int>, L>;
+
+
+	template <class C>
+	void checkLayout (C& c)
+	{
+		std::set<const int*> positions;
+
+		for(int i = 0; i < c.size(0); ++i)
+			for(int j = 0; j < c.size(1); ++j)
+			{
+				c(i, j) = 100 * i + j;
+
+				positions.insert(&c(i, j));
+			}
+
+		EXPECT_EQ(positions.size(), c.size());
+		EXPECT_EQ(*positions.begin(), &*c.begin());
+
+
+		for(int i = 0; i < c.size(0); ++i)
+		{
+			auto s = c.slice(i);
+
+			EXPECT_EQ(s.size(), c.size(1));
+
+			for(int j = 0; j < c.size(1); ++j)
+			{
+				EXPECT_EQ(s(j), 100 * i + j);
+				EXPECT_EQ(s[j], 100 * i + j);
+				EXPECT_EQ(*(s.begin() + j), 100 * i + j);
+			}
+		}
+
+		std::vector<int> expected;
+
+		for(int i = 0; i < c.size(0); ++i)
+			for(int j = 0; j < c.size(1); ++j)
+				expected.push_back(100 * i + j);
+
+		auto all = c.slice();
+
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), all.begin()));
+		EXPECT_EQ(std::distance(all.begin(), all.end()), c.size());
+	}
+
+
+
+	TEST(LayoutTest, Access)
+	{
+		Cnt<cnt::RowMajor, 0, 0> a(16, 32);
+		Cnt<cnt::ColumnMajor, 0, 0> b(16, 32);
+		Cnt<cnt::Tiled<4, 8>> c(16, 32);
+		Cnt<cnt::Morton, 0, 0> d(16, 32);
+		Cnt<cnt::Tiled<4, 4>, 16, 32> e;
+
+		checkLayout(a);
+		checkLayout(b);
+		checkLayout(c);
+		checkLayout(d);
+		checkLayout(e);
+
+
+		EXPECT_EQ(&b(1, 0) - &b[0], 1);
+		EXPECT_EQ(&b(0, 1) - &b[0], 16);
+		EXPECT_EQ(b.strides()[1], 16);
+
+		EXPECT_EQ(&c(0, 4) - &c[0], 4);
+		EXPECT_EQ(&c(1, 0) - &c[0], 8);
+		EXPECT_EQ(&c(0, 8) - &c[0], 32);
+		EXPECT_EQ(&c(4, 0) - &c[0], 4 * 32);
+
+		EXPECT_EQ(&d(0, 1) - &d[0], 1);
+		EXPECT_EQ(&d(1, 0) - &d[0], 2);
+		EXPECT_EQ(&d(1, 1) - &d[0], 3);
+		EXPECT_EQ(&d(0, 2) - &d[0], 4);
+	}
+
+
+
+	TEST(LayoutTest, Dimensions)
+	{
+		Cnt<cnt::Tiled<2, 4, 4>> a(6, 8, 12);
+		Cnt<cnt::Morton> b(4, 8, 2);
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(b.begin(), b.end(), 0);
+
+		std::set<int> va, vb;
+
+		for(int i = 0; i < 6; ++i)
+			for(int j = 0; j < 8; ++j)
+				for(int k = 0; k < 12; ++k)
+				{
+					va.insert(a(i, j, k));
+
+					EXPECT_EQ(a(i, std::vector<int>{j, k}), a(i, j, k));
+					EXPECT_EQ(a({i, j, k}), a(i, j, k));
+					EXPECT_EQ(a.slice(i, j)(k), a(i, j, k));
+					EXPECT_EQ(a.slice(std::vector<int>{i})(j, k), a(i, j, k));
+				}
+
+		for(int i = 0; i < 4; ++i)
+			for(int j = 0; j < 8; ++j)
+				for(int k = 0; k < 2; ++k)
+					vb.insert(b(i, j, k));
+
+		EXPECT_EQ(va.size(), a.size());
+		EXPECT_EQ(vb.size(), b.size());
+
+
+		EXPECT_THROW((Cnt<cnt::Tiled<4, 4>>(6, 8)), std::invalid_argument);
+		EXPECT_THROW((Cnt<cnt::Tiled<4, 4>>(8, 8, 8)), std::invalid_argument);
+		EXPECT_THROW((Cnt<cnt::Morton>(4, 6)), std::invalid_argument);
+	}
+
+
+
+	TEST(LayoutTest, Expressions)
+	{
+		Cnt<cnt::Tiled<4, 4>, 0, 0> a(8, 12), b(8, 12);
+		cnt::Container<int, 0, 0> r(8, 12);
+
+		std::iota(r.begin(), r.end(), 0);
+
+
+		a.slice() = r + 0;
+		b = a * 2;
+
+		for(int i = 0; i < 8; ++i)
+			for(int j = 0; j < 12; ++j)
+				EXPECT_EQ(b(i, j), 2 * r(i, j));
+
+
+		r = b.slice() - a.slice();
+		a.slice(3) = r.slice(2) * 0;
+
+		for(int i = 0; i < 8; ++i)
+			for(int j = 0; j < 12; ++j)
+			{
+				EXPECT_EQ(r(i, j), 12 * i + j);
+				EXPECT_EQ(a(i, j), i == 3 ? 0 : 12 * i + j);
+			}
+	}
+
+
+} // namespace
@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "Container/Mapped.h"
+
+
+namespace
+{
+	TEST(MappedTest, CreateAndOpen)
+	{
+		std::string path = ::testing::TempDir() + "cnt_mapped_test.cnt";
+
+		{
+			cnt::MappedContainer<float, 0, 0, 0> a(path, 7, 3, 6);
+
+			EXPECT_EQ(a.size(), 7*3*6);
+			EXPECT_EQ(a.header().rank, 3);
+			EXPECT_EQ(std::count(a.begin(), a.end(), 0.0f), a.size());
+
+			std::iota(a.begin(), a.end(), 0.0f);
+
+			a(5, 2, 4) = -1.0f;
+
+			a.flush();
+		}
+
+
+		cnt::MappedContainer<const float, 0, 0, 0> b(path);
+		cnt::MappedContainer<float, 7, 3, 6> c(path);
+
+		EXPECT_EQ(b.size(0), 7);
+		EXPECT_EQ(b.size(1), 3);
+		EXPECT_EQ(b.size(2), 6);
+
+		EXPECT_EQ(b(5, 2, 4), -1.0f);
+		EXPECT_EQ(b({1, 2, 3}), 1*18 + 2*6 + 3);
+		EXPECT_EQ(c.slice(1)(2, 3), 1*18 + 2*6 + 3);
+
+
+		c(0, 0, 0) = 10.0f;
+
+		EXPECT_EQ(b(0, 0, 0), 10.0f);
+
+		std::remove(path.c_str());
+	}
+
+
+
+	TEST(MappedTest, Validation)
+	{
+		std::string path = ::testing::TempDir() + "cnt_mapped_validation.cnt";
+
+		{
+			cnt::MappedContainer<int, 4, 5> a(path, 4, 5);
+
+			EXPECT_THROW((cnt::MappedContainer<int, 4, 5>(path, 5, 4)), std::invalid_argument);
+		}
+
+		EXPECT_THROW((cnt::MappedContainer<float, 4, 5>(path)), std::runtime_error);
+		EXPECT_THROW((cnt::MappedContainer<int, 0, 0, 0>(path)), std::runtime_error);
+		EXPECT_THROW((cnt::MappedContainer<int, 5, 4>(path)), std::runtime_error);
+		EXPECT_NO_THROW((cnt::MappedContainer<const int, 0, 0>(path)));
+
+		EXPECT_THROW((cnt::MappedContainer<int, 0, 0>(path + ".missing")), std::system_error);
+
+
+		/// Corrupt headers: data overlapping the header, and sizes whose product overflows
+		auto patch = [&](long offset, std::uint64_t value){
+			std::FILE* f = std::fopen(path.c_str(), "r+b");
+
+			std::fseek(f, offset, SEEK_SET);
+			std::fwrite(&value, sizeof(value), 1, f);
+			std::fclose(f);
+		};
+
+		const long sizes = sizeof(cnt::MappedHeader);
+
+		const std::uint64_t dataOffset = cnt::MappedContainer<const int, 0, 0>(path).header().dataOffset;
+
+		patch(offsetof(cnt::MappedHeader, dataOffset), sizeof(cnt::MappedHeader));
+
+		EXPECT_THROW((cnt::MappedContainer<const int, 0, 0>(path)), std::runtime_error);
+
+		patch(offsetof(cnt::MappedHeader, dataOffset), dataOffset);
+		patch(sizes, 8);
+		patch(sizes + 8, std::uint64_t(1) << 62);
+		patch(sizes + 16, std::uint64_t(1) << 62);
+
+		EXPECT_THROW((cnt::MappedContainer<const int, 0, 0>(path)), std::runtime_error);
+
+		std::remove(path.c_str());
+	}
+
+
+} // namespace
@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+#include "Container/NdIndex.h"
+
+
+namespace
+{
+	TEST(NdIndexTest, Containers)
+	{
+		cnt::Container<int, 0, 0, 0> a(3, 4, 5);
+		cnt::Container<int> b(3, 4, 5);
+		cnt::BasicContainer<int, cnt::Shape<3, 4, 5>, std::allocator<int>, cnt::ColumnMajor> c;
+
+		std::iota(a.begin(), a.end(), 0);
+		std::iota(b.begin(), b.end(), 0);
+		std::iota(c.begin(), c.end(), 0);
+
+
+		static_assert(std::is_same<std::decay_t<decltype((*cnt::ndindex(a).begin()).index)>, std::array<std::size_t, 3>>::value, "");
+		static_assert(std::is_same<std::decay_t<decltype((*cnt::ndindex(b).begin()).index)>, std::vector<std::size_t>>::value, "");
+
+
+		int count = 0;
+
+		for(auto e : cnt::ndindex(a))
+		{
+			EXPECT_EQ(&e.value, &a(e.index[0], e.index[1], e.index[2]));
+			EXPECT_EQ(e.value, count++);
+		}
+
+		EXPECT_EQ(count, a.size());
+
+
+		count = 0;
+
+		for(auto e : cnt::ndindex(b))
+		{
+			EXPECT_EQ(&e.value, &b(e.index));
+			e.value = -e.value;
+			++count;
+		}
+
+		EXPECT_EQ(count, b.size());
+		EXPECT_EQ(b(2, 3, 4), -59);
+
+
+		std::size_t i = 0, j = 0, k = 0;
+
+		for(auto e : cnt::ndindex(c))
+		{
+			EXPECT_EQ(e.index[0], i);
+			EXPECT_EQ(e.index[1], j);
+			EXPECT_EQ(e.index[2], k);
+			EXPECT_EQ(&e.value, &c(i, j, k));
+
+			k = (k + 1) % 5;
+			j = (j + !k) % 4;
+			i += !k && !j;
+		}
+
+		EXPECT_EQ(i, 3);
+	}
+
+
+
+	TEST(NdIndexTest, Views)
+	{
+		cnt::Container<int> c(4, 5, 6, 7);
+
+		std::iota(c.begin(), c.end(), 0);
+
+
+		auto s = c.slice(2, 3);
+
+		EXPECT_EQ(s.numDimensions(), 2);
+
+		int count = 0;
+
+		for(auto e : cnt::ndindex(s))
+		{
+			EXPECT_EQ(e.index.size(), 2);
+			EXPECT_EQ(&e.value, &c(2, 3, e.index[0], e.index[1]));
+			++count;
+		}
+
+		EXPECT_EQ(count, 6 * 7);
+
+
+		auto v = cnt::strided(c, cnt::range(1, 4, 2), 2, cnt::all, cnt::range(6, 0));
+
+		EXPECT_EQ(cnt::ndindex(v).size(), 0);
+		EXPECT_TRUE(cnt::ndindex(v).begin() == cnt::ndindex(v).end());
+
+
+		auto w = cnt::strided(c, cnt::range(1, 4, 2), 2, cnt::all, cnt::range(0, 7, 3));
+
+		count = 0;
+
+		for(auto e : cnt::ndindex(w))
+		{
+			EXPECT_EQ(&e.value, &c(1 + 2 * e.index[0], 2, e.index[1], 3 * e.index[2]));
+			++count;
+		}
+
+		EXPECT_EQ(count, 2 * 6 * 3);
+
+
+		/// The iterators do not depend on the range they were taken from
+		auto it = cnt::ndindex(w).begin();
+
+		++it;
+
+		EXPECT_EQ(&(*it).value, &c(1, 2, 0, 3));
+
+		cnt::Container<int> r(2, 3, 4);
+
+		auto jt = cnt::ndindex(r).begin(), kt = jt;
+
+		for(int i = 0; i < 5; ++i)
+			++jt;
+
+		EXPECT_EQ(&(*jt).value, &r(0, 1, 1));
+		EXPECT_EQ((*jt).index, std::vector<std::size_t>({ 0, 1, 1 }));
+		EXPECT_EQ(&(*kt).value, &r(0, 0, 0));
+		EXPECT_TRUE(++kt != cnt::ndindex(r).end());
+
+
+		auto x = cnt::strided(c, 1, 2, 3, 4);
+
+		count = 0;
+
+		for(auto e : cnt::ndindex(x))
+		{
+			EXPECT_EQ(&e.value, &c(1, 2, 3, 4));
+			++count;
+		}
+
+		EXPECT_EQ(count, 1);
+	}
+
+
+} // namespace
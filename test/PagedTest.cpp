@@ -0,0 +1,130 @@
+#include <numeric>
+
+#include "gtest/gtest.h"
+#include "Container/Paged.h"
+
+
+namespace
+{
+	TEST(PagedTest, Access)
+	{
+		const std::string path = ::testing::TempDir() + "cnt_paged_test.bin";
+
+		/// Room for 3 slabs of 5 x 6 ints
+		cnt::PagedContainer<int, 0, 0, 0> a(path, 3 * 5 * 6 * sizeof(int), 20, 5, 6);
+
+		EXPECT_EQ(a.size(), 20 * 5 * 6);
+		EXPECT_EQ(a.size(0), 20);
+		EXPECT_EQ(a.maxResidentSlabs(), 3);
+		EXPECT_EQ(a(19, 4, 5), 0);
+
+
+		for(int i = 0; i < 20; ++i)
+			for(int j = 0; j < 5; ++j)
+				for(int k = 0; k < 6; ++k)
+					a(i, j, k) = i * 100 + j * 10 + k;
+
+		EXPECT_LE(a.residentSlabs(), 3);
+
+
+		/// Backwards, so the slabs are evicted again before being read
+		const auto& ca = a;
+
+		for(int i = 19; i >= 0; --i)
+			for(int j = 0; j < 5; ++j)
+				for(int k = 0; k < 6; ++k)
+					EXPECT_EQ(ca(i, j, k), i * 100 + j * 10 + k);
+
+		EXPECT_EQ(ca({7, 3, 2}), 732);
+		EXPECT_EQ(ca(std::vector<int>{ 7, 3 }, 2), 732);
+
+		a(0, 0, 0) = a(19, 4, 5);
+
+		EXPECT_EQ(ca(0, 0, 0), 1945);
+
+
+		a.flush();
+
+		EXPECT_EQ(ca(13, 2, 1), 1321);
+
+
+		EXPECT_THROW((cnt::PagedContainer<int, 0, 0>(path, 100, 3)), std::invalid_argument);
+		EXPECT_THROW((cnt::PagedContainer<int, 2, 3>(path, 100, 3, 2)), std::invalid_argument);
+		EXPECT_THROW((cnt::PagedContainer<int, 0, 0>(::testing::TempDir() + "no/such/dir/x.bin", 100, 3, 4)), std::system_error);
+	}
+
+
+
+	TEST(PagedTest, Slice)
+	{
+		const std::string path = ::testing::TempDir() + "cnt_paged_test.bin";
+
+		cnt::PagedContainer<double, 0, 0, 0> a(path, 2 * 4 * 4 * sizeof(double), 10, 4, 4);
+
+		{
+			auto s = a.slice(3);
+
+			std::iota(s.begin(), s.end(), 0.0);
+
+			/// The other slabs go through memory, but the slab 3 stays there
+			for(int i = 0; i < 10; ++i)
+				if(i != 3)
+					a(i, 1, 1) = i;
+
+			EXPECT_EQ(s(2, 3), 11.0);
+			EXPECT_EQ(double(a(3, 2, 3)), 11.0);
+
+			auto t = s;
+
+			s = a.slice(4);
+
+			EXPECT_EQ(t(1, 1), 5.0);
+			EXPECT_EQ(s(1, 1), 4.0);
+			EXPECT_EQ(t.slice(1)(2), 6.0);
+
+			EXPECT_GE(a.residentSlabs(), 2);
+		}
+
+
+		for(int i = 0; i < 10; ++i)
+			if(i != 3)
+				a(i, 0, 0) = -i;
+
+		EXPECT_LE(a.residentSlabs(), 2);
+
+		const auto& ca = a;
+		const auto s = ca.slice(3);
+
+		for(std::size_t j = 0; j < 4; ++j)
+			for(std::size_t k = 0; k < 4; ++k)
+				EXPECT_EQ(s(j, k), j * 4.0 + k);
+
+		for(int i = 0; i < 10; ++i)
+			if(i != 3)
+			{
+				EXPECT_EQ(ca(i, 1, 1), i);
+				EXPECT_EQ(ca(i, 0, 0), -i);
+			}
+	}
+
+
+
+	TEST(PagedTest, StaticShape)
+	{
+		const std::string path = ::testing::TempDir() + "cnt_paged_test.bin";
+
+		cnt::PagedContainer<float, 8, 3, 2> a(path, 1);
+
+		EXPECT_EQ(a.maxResidentSlabs(), 1);
+
+		for(int i = 0; i < 8; ++i)
+			a.slice(i)(2, 1) = float(i);
+
+		for(int i = 7; i >= 0; --i)
+			EXPECT_EQ(float(a(i, 2, 1)), float(i));
+
+		cnt::PagedContainer<float, 8, 3, 2> b(path, 1, std::vector<int>{ 8, 3, 2 });
+
+		EXPECT_EQ(b(7, 2, 1), 0.0f);
+	}
+}
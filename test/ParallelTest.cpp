@@ -0,0 +1,162 @@
+#include <random>
+#include <set>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "Container/Parallel.h"
+
+
+namespace
+{
+	TEST(ParallelTest, ThreadPool)
+	{
+		cnt::ThreadPool pool(4);
+
+		EXPECT_EQ(pool.size(), 4);
+
+
+		std::vector<std::atomic<int>> visited(10000);
+
+		pool.parallelFor(0, visited.size(), 7, [&](std::size_t first, std::size_t last){
+			EXPECT_LE(last - first, 7);
+
+			for(std::size_t i = first; i < last; ++i)
+				visited[i] += 1;
+		});
+
+		EXPECT_TRUE(std::all_of(visited.begin(), visited.end(), [](const auto& x){ return x == 1; }));
+
+
+		std::atomic<int> count{0};
+
+		pool.parallelFor(0, 8, 1, [&](std::size_t, std::size_t){
+			pool.parallelFor(0, 100, 3, [&](std::size_t first, std::size_t last){ count += last - first; });
+		});
+
+		EXPECT_EQ(count, 800);
+
+
+		EXPECT_THROW(pool.parallelFor(0, 100, 1, [](std::size_t first, std::size_t){
+			if(first == 42)
+				throw std::runtime_error("");
+		}), std::runtime_error);
+
+
+		cnt::ThreadPool single(1);
+
+		int serial = 0;
+
+		single.parallelFor(0, 100, 10, [&](std::size_t first, std::size_t last){ serial += last - first; });
+
+		EXPECT_EQ(serial, 100);
+
+
+		/// The fixed schedule gives the same positions to the same threads in every call
+		std::vector<std::thread::id> first(1000), second(1000);
+
+		auto record = [&](std::vector<std::thread::id>& ids){
+			pool.parallelForFixed(0, ids.size(), [&](std::size_t b, std::size_t e){
+				for(std::size_t i = b; i < e; ++i)
+					ids[i] = std::this_thread::get_id();
+			});
+		};
+
+		record(first);
+		record(second);
+
+		EXPECT_EQ(first, second);
+		EXPECT_EQ(first.back(), std::this_thread::get_id());
+		EXPECT_EQ(std::set<std::thread::id>(first.begin(), first.end()).size(), 4);
+
+
+		count = 0;
+
+		pool.parallelFor(0, 8, 1, [&](std::size_t, std::size_t){
+			pool.parallelForFixed(0, 100, [&](std::size_t first, std::size_t last){ count += last - first; });
+		});
+
+		EXPECT_EQ(count, 800);
+
+		EXPECT_THROW(pool.parallelForFixed(0, 100, [](std::size_t first, std::size_t){
+			if(first == 25)
+				throw std::runtime_error("");
+		}), std::runtime_error);
+	}
+
+
+
+	TEST(ParallelTest, Algorithms)
+	{
+		cnt::Container<int> a(37, 11, 5), b(37, 11, 5), c(37, 11, 5);
+
+		std::iota(a.begin(), a.end(), 0);
+
+
+		cnt::parallel_transform(a, b, [](int x){ return 2 * x; });
+
+		for(int i = 0; i < b.size(); ++i)
+			EXPECT_EQ(b[i], 2 * i);
+
+
+		cnt::parallel_transform(a, b, c, [](int x, int y){ return x + y; });
+
+		for(int i = 0; i < c.size(); ++i)
+			EXPECT_EQ(c[i], 3 * i);
+
+
+		cnt::parallel_for_each(c.slice(4), [](int& x){ x = -1; });
+
+		EXPECT_TRUE(std::all_of(c.slice(4).begin(), c.slice(4).end(), [](int x){ return x == -1; }));
+		EXPECT_EQ(c(3, 10, 4), 3 * (3*11*5 + 10*5 + 4));
+		EXPECT_EQ(c(5, 0, 0), 3 * 5*11*5);
+
+
+		EXPECT_EQ(cnt::parallel_reduce(a, 0), std::accumulate(a.begin(), a.end(), 0));
+		EXPECT_EQ(cnt::parallel_reduce(a.slice(7), 0), std::accumulate(a.slice(7).begin(), a.slice(7).end(), 0));
+		EXPECT_EQ(cnt::parallel_reduce(b, 0, [](int x, int y){ return std::max(x, y); }), 2 * (a.size() - 1));
+
+		EXPECT_EQ(cnt::parallel_reduce(cnt::Container<int>(0), 5), 5);
+
+
+		cnt::Container<int> d(cnt::uninitialized, 37, 11, 5);
+
+		cnt::parallel_fill(d, 7);
+		cnt::parallel_for_each(d, [](int& x){ x += 1; }, cnt::Schedule::fixed);
+		cnt::parallel_transform(d, d, [](int x){ return x - 1; }, cnt::Schedule::fixed);
+
+		EXPECT_EQ(cnt::parallel_reduce(d, 0, std::plus<>(), cnt::Schedule::fixed), 7 * d.size());
+
+		cnt::parallel_fill(d.slice(2), -7);
+
+		EXPECT_EQ(std::count(d.begin(), d.end(), 7), d.size() - 11 * 5);
+		EXPECT_EQ(std::count(d.slice(2).begin(), d.slice(2).end(), -7), 11 * 5);
+
+		EXPECT_THROW(cnt::parallel_transform(a, cnt::Container<int>(3), [](int x){ return x; }), std::invalid_argument);
+	}
+
+
+
+	TEST(ParallelTest, Uneven)
+	{
+		cnt::Container<double, 0, 0> a(1000, 3);
+
+		std::iota(a.begin(), a.end(), 0.0);
+
+
+		cnt::parallel_for_each(a, [](double& x){
+			int n = int(x) % 100 == 0 ? 100000 : 1;
+
+			double s = x;
+
+			for(int i = 0; i < n; ++i)
+				s = std::sqrt(s * s);
+
+			x = s + 1.0;
+		});
+
+		for(int i = 0; i < a.size(); ++i)
+			EXPECT_NEAR(a[i], i + 1.0, 1e-6);
+	}
+
+
+} // namespace
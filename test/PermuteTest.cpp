@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "Container/Permute.h"
+
+
+namespace
+{
+	TEST(PermuteTest, View)
+	{
+		cnt::Container<int> c(4, 5, 6);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		auto v = cnt::permuted(c, {2, 0, 1});
+
+		static_assert(std::is_same<decltype(v), cnt::StridedView<int, 3>>::value, "");
+
+		EXPECT_EQ(v.size(0), 6);
+		EXPECT_EQ(v.size(1), 4);
+		EXPECT_EQ(v.size(2), 5);
+
+		for(int i = 0; i < 6; ++i)
+			for(int j = 0; j < 4; ++j)
+				for(int k = 0; k < 5; ++k)
+					EXPECT_EQ(v(i, j, k), c(j, k, i));
+
+		v(1, 2, 3) = -1;
+
+		EXPECT_EQ(c(2, 3, 1), -1);
+
+
+		EXPECT_THROW(cnt::permuted(c, {0, 0, 1}), std::invalid_argument);
+		EXPECT_THROW(cnt::permuted(c, {0, 3, 1}), std::invalid_argument);
+		EXPECT_THROW(cnt::permuted(c, {1, 0}), std::invalid_argument);
+	}
+
+
+
+	TEST(PermuteTest, Materialize)
+	{
+		cnt::Container<int, 0, 0, 0, 0> c(3, 5, 37, 41);
+		cnt::Container<double, 0, 0> d(100, 70);
+		cnt::BasicContainer<int, cnt::Shape<0, 0>, std::allocator<int>, cnt::ColumnMajor> e(20, 30);
+
+		std::iota(c.begin(), c.end(), 0);
+		std::iota(d.begin(), d.end(), 0.0);
+		std::iota(e.begin(), e.end(), 0);
+
+
+		const std::size_t perms[][4] = { {0, 2, 3, 1}, {3, 2, 1, 0}, {0, 1, 2, 3}, {1, 3, 0, 2} };
+
+		for(const auto& p : perms)
+		{
+			auto r = cnt::permute(c, p);
+			auto v = cnt::permuted(c, p);
+
+			static_assert(std::is_same<decltype(r), cnt::Container<int, 0, 0, 0, 0>>::value, "");
+
+			for(int k = 0; k < 4; ++k)
+				EXPECT_EQ(r.size(k), c.size(p[k]));
+
+			EXPECT_TRUE(std::equal(r.begin(), r.end(), v.begin()));
+		}
+
+
+		auto t = cnt::permute(d, {1, 0});
+
+		for(int i = 0; i < 70; ++i)
+			for(int j = 0; j < 100; ++j)
+				EXPECT_EQ(t(i, j), d(j, i));
+
+
+		auto f = cnt::permute(e, {1, 0});
+
+		EXPECT_TRUE(std::equal(f.begin(), f.end(), e.begin()));
+
+
+		cnt::Container<double, 70, 100> g;
+		cnt::Container<double> h(100, 70);
+
+		cnt::permute(d, {1, 0}, g);
+
+		EXPECT_TRUE(std::equal(g.begin(), g.end(), t.begin()));
+		EXPECT_THROW(cnt::permute(d, {1, 0}, h), std::invalid_argument);
+	}
+
+
+} // namespace
@@ -0,0 +1,170 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Reduce.h"
+
+
+namespace
+{
+	TEST(ReduceTest, Axes)
+	{
+		std::mt19937 gen(3);
+		std::uniform_int_distribution<int> dist(-100, 100);
+
+		cnt::Container<int, 0, 0, 0> c(5, 6, 7);
+
+		for(auto& x : c)
+			x = dist(gen);
+
+
+		auto s0 = cnt::reduce(c, 0, cnt::Sum());
+		auto s1 = cnt::reduce(c, 1, cnt::Max());
+		auto s2 = cnt::reduce(c, 2, cnt::ArgMax());
+		auto m1 = cnt::reduce(c, 1, cnt::Mean());
+		auto a0 = cnt::reduce(c, 0, cnt::ArgMin());
+		auto n2 = cnt::reduce(c, 2, cnt::Min());
+
+		static_assert(std::is_same<decltype(s0), cnt::Container<int, 0, 0>>::value, "");
+		static_assert(std::is_same<decltype(s2), cnt::Container<std::size_t, 0, 0>>::value, "");
+		static_assert(std::is_same<decltype(m1), cnt::Container<double, 0, 0>>::value, "");
+
+		EXPECT_EQ(s0.size(0), 6);
+		EXPECT_EQ(s0.size(1), 7);
+		EXPECT_EQ(s1.size(0), 5);
+		EXPECT_EQ(s1.size(1), 7);
+		EXPECT_EQ(s2.size(1), 6);
+
+
+		for(int i = 0; i < 5; ++i)
+			for(int j = 0; j < 6; ++j)
+				for(int k = 0; k < 7; ++k)
+				{
+					int sum = 0, max = c(i, 0, k), argMin = 0, min = c(i, j, 0);
+					std::size_t argMax = 0;
+
+					for(int a = 0; a < 5; ++a)
+					{
+						sum += c(a, j, k);
+
+						if(c(a, j, k) < c(argMin, j, k))
+							argMin = a;
+					}
+
+					for(int b = 0; b < 6; ++b)
+						max = std::max(max, c(i, b, k));
+
+					for(int d = 0; d < 7; ++d)
+					{
+						if(c(i, j, argMax) < c(i, j, d))
+							argMax = d;
+
+						min = std::min(min, c(i, j, d));
+					}
+
+					double mean = 0.0;
+
+					for(int b = 0; b < 6; ++b)
+						mean += c(i, b, k);
+
+					EXPECT_EQ(s0(j, k), sum);
+					EXPECT_EQ(s1(i, k), max);
+					EXPECT_EQ(s2(i, j), argMax);
+					EXPECT_DOUBLE_EQ(m1(i, k), mean / 6);
+					EXPECT_EQ(a0(j, k), argMin);
+					EXPECT_EQ(n2(i, j), min);
+				}
+
+
+		auto t = cnt::reduce(c, {0, 2}, cnt::Sum());
+		auto u = cnt::reduce(c, {2, 0}, cnt::ArgMax());
+		auto all = cnt::reduce(c, {0, 1, 2}, cnt::Sum());
+
+		static_assert(std::is_same<decltype(t), cnt::Container<int, 0>>::value, "");
+		static_assert(std::is_same<decltype(all), cnt::Container<int, 0>>::value, "");
+
+		EXPECT_EQ(all.size(), 1);
+		EXPECT_EQ(all(0), std::accumulate(c.begin(), c.end(), 0));
+
+		for(int j = 0; j < 6; ++j)
+		{
+			int sum = 0;
+			std::size_t argMax = 0;
+
+			for(int i = 0; i < 5; ++i)
+				for(int k = 0; k < 7; ++k)
+				{
+					sum += c(i, j, k);
+
+					if(c(argMax / 7, j, argMax % 7) < c(i, j, k))
+						argMax = 7 * i + k;
+				}
+
+			EXPECT_EQ(t(j), sum);
+			EXPECT_EQ(u(j), argMax);
+		}
+
+
+		EXPECT_THROW(cnt::reduce(c, 3, cnt::Sum()), std::invalid_argument);
+		EXPECT_THROW(cnt::reduce(c, {1, 1}, cnt::Sum()), std::invalid_argument);
+	}
+
+
+
+	TEST(ReduceTest, Layouts)
+	{
+		std::mt19937 gen(4);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		cnt::BasicContainer<double, cnt::Shape<0, 0, 0>, std::allocator<double>, cnt::ColumnMajor> c(9, 3, 1500);
+		cnt::Container<double> d(9, 3, 1500);
+
+		for(int i = 0; i < 9; ++i)
+			for(int j = 0; j < 3; ++j)
+				for(int k = 0; k < 1500; ++k)
+					c(i, j, k) = d(i, j, k) = dist(gen);
+
+
+		for(std::size_t axis = 0; axis < 3; ++axis)
+		{
+			auto a = cnt::reduce(c, axis, cnt::Sum());
+			auto b = cnt::reduce(d, axis, cnt::Sum());
+			auto e = cnt::reduce(c, axis, cnt::ArgMax());
+			auto f = cnt::reduce(d, axis, cnt::ArgMax());
+
+			static_assert(std::is_same<decltype(b), cnt::Container<double>>::value, "");
+
+			ASSERT_EQ(a.size(), b.size());
+			ASSERT_EQ(b.numDimensions(), 2);
+
+			for(std::size_t i = 0; i < a.size(); ++i)
+			{
+				EXPECT_NEAR(a.begin()[i], b.begin()[i], 1e-9);
+				EXPECT_EQ(e.begin()[i], f.begin()[i]);
+			}
+		}
+
+
+		auto s = cnt::strided(d, cnt::range(1, 9, 3), cnt::all, cnt::range(0, 1500, 7));
+		auto r = cnt::reduce(s, 2, cnt::Max());
+
+		for(int i = 0; i < 3; ++i)
+			for(int j = 0; j < 3; ++j)
+			{
+				double max = s(i, j, 0);
+
+				for(std::size_t k = 0; k < s.size(2); ++k)
+					max = std::max(max, s(i, j, k));
+
+				EXPECT_EQ(r(i, j), max);
+			}
+
+
+		cnt::Container<float, 0, 0> e(4, 0);
+
+		EXPECT_EQ(cnt::reduce(e, 0, cnt::Sum()).size(), 0);
+		EXPECT_EQ(cnt::reduce(e, 1, cnt::Sum())(2), 0.0f);
+		EXPECT_THROW(cnt::reduce(e, 1, cnt::Max()), std::invalid_argument);
+	}
+
+
+} // namespace
@@ -4,6 +4,7 @@
 
 #include "gtest/gtest.h"
 #include "Container/Container.h"
+#include "Container/Expression.h"
 
 
 namespace
@@ -74,4 +75,38 @@ namespace
 
 
 
-}
\ No newline at end of file
+	TEST(SliceTest, Static)
+	{
+		cnt::Container<int, 4, 5, 6> v;
+
+		std::iota(v.begin(), v.end(), 0);
+
+		const auto& cv = v;
+
+		auto a = v.slice<2>();
+		auto b = cv.slice<3, 4>();
+
+		EXPECT_TRUE((std::is_same<decltype(a), cnt::ContainerView<int, 5, 6>>::value));
+		EXPECT_TRUE((std::is_same<decltype(b), cnt::ContainerView<const int, 6>>::value));
+		EXPECT_TRUE((std::is_same<cnt::help::LeafTraits<decltype(a)>::StaticShape, cnt::Shape<5, 6>>::value));
+		EXPECT_EQ(sizeof(a), sizeof(int*));
+
+		EXPECT_EQ(a.data(), v.slice(2).data());
+		EXPECT_EQ(b.data(), v.slice(3, 4).data());
+		EXPECT_EQ(a(4, 5), v(2, 4, 5));
+		EXPECT_EQ(b(1), v(3, 4, 1));
+		EXPECT_TRUE(std::equal(a.begin(), a.end(), v.slice(2).begin()));
+
+
+		a(1, 2) = -1;
+
+		EXPECT_EQ(v(2, 1, 2), -1);
+
+
+		cnt::Container<int, 5, 6> c;
+
+		c = v.slice<0>() + v.slice<1>();
+
+		EXPECT_EQ(c(4, 5), v(0, 4, 5) + v(1, 4, 5));
+	}
+}
@@ -0,0 +1,167 @@
+#include <random>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "Container/Sparse.h"
+#include "Container/Kernels.h"
+
+
+namespace
+{
+	TEST(SparseTest, Access)
+	{
+		cnt::Sparse<double> s(10, 20, 30);
+
+		s.insert(1.5, 3, 4, 5);
+		s.insert(2.0, 9, 0, 7);
+		s.insert(-1.0, std::vector<int>{ 3, 4 }, 6);
+		s.insert(0.5, 3, 4, 5);
+		s.insert(4.0, 0, 0, 0);
+		s.insert(4.0, 0, 0, 1);
+		s.insert(-4.0, 0, 0, 1);
+
+		EXPECT_THROW(s(3, 4, 5), std::logic_error);
+
+		s.compress();
+
+
+		EXPECT_EQ(s.nonZeros(), 4);
+		EXPECT_EQ(s.size(), 6000);
+
+		EXPECT_EQ(s(3, 4, 5), 2.0);
+		EXPECT_EQ(s(3, 4, 6), -1.0);
+		EXPECT_EQ(s(0, 0, 1), 0.0);
+		EXPECT_EQ(s(3, 4, 7), 0.0);
+		EXPECT_EQ(s(3, 5, 5), 0.0);
+		EXPECT_EQ(s({9, 0, 7}), 2.0);
+		EXPECT_EQ(s(std::vector<int>{ 9, 0 }, 7), 2.0);
+		EXPECT_EQ(s(std::make_tuple(0, 0, 0)), 4.0);
+
+		const int idx[] = { 3, 4, 6 };
+
+		EXPECT_EQ(s(std::begin(idx)), -1.0);
+
+
+		s.insert(1.0, 5, 5, 5);
+		s.compress();
+
+		EXPECT_EQ(s.nonZeros(), 5);
+		EXPECT_EQ(s(5, 5, 5), 1.0);
+		EXPECT_EQ(s(3, 4, 5), 2.0);
+
+
+		EXPECT_THROW(s.insert(1.0, 10, 0, 0), std::invalid_argument);
+		EXPECT_THROW(s.insert(1.0, 1, 0), std::invalid_argument);
+		EXPECT_THROW(cnt::Sparse<int>(std::vector<std::size_t>{}), std::invalid_argument);
+	}
+
+
+
+	TEST(SparseTest, Iteration)
+	{
+		std::mt19937 gen(42);
+
+		cnt::Sparse<int> s(7, 8, 9, 10);
+
+		std::map<std::vector<std::size_t>, int> expected;
+
+		for(int i = 0; i < 300; ++i)
+		{
+			std::vector<std::size_t> idx = { gen() % 7, gen() % 8, gen() % 9, gen() % 10 };
+
+			s.insert(i + 1, idx);
+			expected[idx] += i + 1;
+		}
+
+		s.compress();
+
+		EXPECT_EQ(s.nonZeros(), expected.size());
+
+
+		auto it = expected.begin();
+
+		for(auto e : s)
+		{
+			EXPECT_EQ(std::vector<std::size_t>(e.index.begin(), e.index.end()), it->first);
+			EXPECT_EQ(e.value, it->second);
+			EXPECT_EQ(s(e.index), it->second);
+			++it;
+		}
+
+		EXPECT_TRUE(it == expected.end());
+
+
+		cnt::Sparse<int> empty(3, 3);
+
+		empty.compress();
+
+		EXPECT_TRUE(empty.begin() == empty.end());
+		EXPECT_EQ(empty(1, 1), 0);
+	}
+
+
+
+	TEST(SparseTest, Dense)
+	{
+		cnt::Container<double, 0, 0, 0> d(5, 6, 7);
+
+		std::fill(d.begin(), d.end(), 0.0);
+
+		d(1, 2, 3) = 1.0;
+		d(4, 5, 6) = 2.0;
+		d(0, 0, 0) = 3.0;
+
+		auto s = cnt::sparse(d);
+
+		EXPECT_EQ(s.nonZeros(), 3);
+		EXPECT_EQ(s(4, 5, 6), 2.0);
+
+		auto e = cnt::dense(s);
+
+		EXPECT_TRUE(std::equal(d.begin(), d.end(), e.begin(), e.end()));
+
+		auto t = cnt::sparse(d.slice(1));
+
+		EXPECT_EQ(t.numDimensions(), 2);
+		EXPECT_EQ(t(2, 3), 1.0);
+
+
+		cnt::Container<double, 0, 0, 0> w(5, 6, 7);
+
+		std::iota(w.begin(), w.end(), 0.0);
+
+		EXPECT_EQ(cnt::dot(s, w), 1.0 * w(1, 2, 3) + 2.0 * w(4, 5, 6));
+
+		cnt::axpy(2.0, s, w);
+
+		EXPECT_EQ(w(1, 2, 3), 1 * 42 + 2 * 7 + 3 + 2.0);
+		EXPECT_EQ(w(1, 2, 4), 1 * 42 + 2 * 7 + 4);
+
+		s *= w;
+
+		EXPECT_EQ(s(0, 0, 0), 3.0 * 6.0);
+		EXPECT_EQ(s.nonZeros(), 3);
+
+		s *= 0.5;
+
+		EXPECT_EQ(s(0, 0, 0), 9.0);
+
+		EXPECT_THROW(cnt::dot(s, cnt::Container<double>(5, 6)), std::invalid_argument);
+
+
+		/// Scalars of other types than the elements
+		cnt::Sparse<float> f({3, 4});
+
+		f.insert(3.0f, 1, 2);
+		f.compress();
+
+		f *= 2.0;
+		f *= 2;
+		f /= 4.0;
+
+		EXPECT_EQ(f(1, 2), 3.0f);
+		EXPECT_THROW(f *= cnt::Container<float>(4, 3), std::invalid_argument);
+	}
+
+
+} // namespace
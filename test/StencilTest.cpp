@@ -0,0 +1,224 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Stencil.h"
+
+
+namespace
+{
+	/// The index read at 'i' in a dimension of size 'n', or '-1' for zero, following each boundary literally
+	int reference (int i, int n, cnt::Boundary boundary)
+	{
+		while(i < 0 || i >= n)
+		{
+			if(boundary == cnt::Boundary::zero)
+				return -1;
+
+			if(boundary == cnt::Boundary::clamp)
+				i = i < 0 ? 0 : n - 1;
+
+			else if(boundary == cnt::Boundary::wrap)
+				i = i < 0 ? i + n : i - n;
+
+			else if(n == 1)
+				i = 0;
+
+			else
+				i = i < 0 ? -i : 2 * (n - 1) - i;
+		}
+
+		return i;
+	}
+
+
+	/// The stencil of a 3 x 3 x 3 kernel with nested loops over 'operator()'
+	template <class C>
+	cnt::Container<double, 0, 0, 0> naive (const C& in, const std::vector<double>& w, cnt::Boundary boundary)
+	{
+		const int n0 = in.size(0), n1 = in.size(1), n2 = in.size(2);
+
+		cnt::Container<double, 0, 0, 0> out(n0, n1, n2);
+
+		for(int i = 0; i < n0; ++i)
+			for(int j = 0; j < n1; ++j)
+				for(int k = 0; k < n2; ++k)
+				{
+					double s = 0.0;
+
+					for(int a = 0; a < 3; ++a)
+						for(int b = 0; b < 3; ++b)
+							for(int c = 0; c < 3; ++c)
+							{
+								int x = reference(i + a - 1, n0, boundary);
+								int y = reference(j + b - 1, n1, boundary);
+								int z = reference(k + c - 1, n2, boundary);
+
+								if(x >= 0 && y >= 0 && z >= 0)
+									s += w[9 * a + 3 * b + c] * in(x, y, z);
+							}
+
+					out(i, j, k) = s;
+				}
+
+		return out;
+	}
+
+
+	const cnt::Boundary boundaries[] = { cnt::Boundary::clamp, cnt::Boundary::wrap, cnt::Boundary::zero, cnt::Boundary::mirror };
+
+
+
+	TEST(StencilTest, Dense)
+	{
+		std::mt19937 gen(1);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		std::vector<double> w(27);
+
+		for(auto& x : w)
+			x = dist(gen);
+
+		w[4] = 0.0;
+
+		const cnt::DenseKernel<double, 3> kernel({3, 3, 3}, w);
+
+
+		for(auto sizes : { std::array<int, 3>{ 5, 6, 7 }, std::array<int, 3>{ 1, 2, 9 }, std::array<int, 3>{ 3, 1, 1 } })
+		{
+			cnt::Container<double, 0, 0, 0> in(sizes[0], sizes[1], sizes[2]), out(sizes[0], sizes[1], sizes[2]);
+
+			for(auto& x : in)
+				x = dist(gen);
+
+			for(auto boundary : boundaries)
+			{
+				cnt::stencil(in, out, kernel, boundary);
+
+				auto expected = naive(in, w, boundary);
+
+				for(std::size_t i = 0; i < out.size(); ++i)
+					EXPECT_NEAR(out.begin()[i], expected.begin()[i], 1e-12);
+			}
+		}
+
+
+		cnt::BasicContainer<double, cnt::Shape<0, 0, 0>, std::allocator<double>, cnt::ColumnMajor> in(4, 5, 6);
+		cnt::Container<double, 0, 0, 0> out(4, 5, 6);
+
+		for(auto& x : in)
+			x = dist(gen);
+
+		cnt::stencil(in, out, kernel, cnt::Boundary::mirror);
+
+		auto expected = naive(in, w, cnt::Boundary::mirror);
+
+		for(std::size_t i = 0; i < out.size(); ++i)
+			EXPECT_NEAR(out.begin()[i], expected.begin()[i], 1e-12);
+	}
+
+
+
+	TEST(StencilTest, Separable)
+	{
+		std::mt19937 gen(2);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		std::array<std::vector<double>, 3> taps = { std::vector<double>{ 1, 2, 1 }, std::vector<double>{ -1, 0, 1 }, std::vector<double>{ 0.25, 0.5, 0.25 } };
+
+		std::vector<double> w(27);
+
+		for(int a = 0; a < 3; ++a)
+			for(int b = 0; b < 3; ++b)
+				for(int c = 0; c < 3; ++c)
+					w[9 * a + 3 * b + c] = taps[0][a] * taps[1][b] * taps[2][c];
+
+
+		cnt::Container<double, 0, 0, 0> in(6, 5, 8), out(6, 5, 8);
+
+		for(auto& x : in)
+			x = dist(gen);
+
+		for(auto boundary : boundaries)
+		{
+			cnt::stencil(in, out, cnt::SeparableKernel<double, 3>(taps), boundary);
+
+			auto expected = naive(in, w, boundary);
+
+			for(std::size_t i = 0; i < out.size(); ++i)
+				EXPECT_NEAR(out.begin()[i], expected.begin()[i], 1e-12);
+		}
+
+
+		cnt::BasicContainer<double, cnt::Shape<0, 0, 0>, std::allocator<double>, cnt::ColumnMajor> col(6, 5, 8);
+
+		cnt::stencil(in, col, cnt::SeparableKernel<double, 3>(taps), cnt::Boundary::wrap);
+
+		auto expected = naive(in, w, cnt::Boundary::wrap);
+
+		for(int i = 0; i < 6; ++i)
+			for(int j = 0; j < 5; ++j)
+				for(int k = 0; k < 8; ++k)
+					EXPECT_NEAR(col(i, j, k), expected(i, j, k), 1e-12);
+
+
+		cnt::Container<float, 0, 0> a(4, 4), b(4, 4);
+
+		std::iota(a.begin(), a.end(), 0.0f);
+
+		cnt::stencil(a, b, cnt::SeparableKernel<float, 2>({ 1.0f, 1.0f, 1.0f }), cnt::Boundary::zero);
+
+		EXPECT_EQ(b(0, 0), 0 + 1 + 4 + 5);
+		EXPECT_EQ(b(1, 1), 0 + 1 + 2 + 4 + 5 + 6 + 8 + 9 + 10);
+
+
+		cnt::Container<float> c(7), d(7);
+
+		std::iota(c.begin(), c.end(), 0.0f);
+
+		cnt::stencil(c, d, cnt::SeparableKernel<float, 1>({ 1.0f, 0.0f, 0.0f, 0.0f, 0.0f }), cnt::Boundary::wrap);
+
+		EXPECT_EQ(d(0), 5.0f);
+		EXPECT_EQ(d(3), 1.0f);
+	}
+
+
+
+	TEST(StencilTest, Views)
+	{
+		cnt::Container<float, 0, 0, 0> c(3, 6, 6), d(3, 6, 6);
+
+		std::iota(c.begin(), c.end(), 0.0f);
+		std::fill(d.begin(), d.end(), -1.0f);
+
+		const cnt::DenseKernel<float, 2> shift({1, 3}, { 0.0f, 0.0f, 1.0f });
+
+		cnt::stencil(c.slice(1), d.slice(1), shift, cnt::Boundary::clamp);
+
+		EXPECT_EQ(d(1, 2, 3), c(1, 2, 4));
+		EXPECT_EQ(d(1, 2, 5), c(1, 2, 5));
+		EXPECT_EQ(d(0, 2, 3), -1.0f);
+
+
+		auto v = cnt::strided(c, 2, cnt::range(0, 6, 2), cnt::all);
+		cnt::Container<float, 0, 0> e(3, 6);
+
+		cnt::stencil(v, e, cnt::DenseKernel<float, 2>({3, 1}, { 1.0f, 0.0f, 0.0f }), cnt::Boundary::wrap);
+
+		EXPECT_EQ(e(0, 1), c(2, 4, 1));
+		EXPECT_EQ(e(1, 1), c(2, 0, 1));
+
+
+		const cnt::DenseKernel<float, 3> one({1, 1, 1}, { 1.0f });
+		const std::array<std::size_t, 2> square = { 2, 2 }, empty = { 0, 2 };
+
+		cnt::Container<float> f(2, 3, 4);
+
+		EXPECT_THROW(cnt::stencil(f, c, one), std::invalid_argument);
+		EXPECT_THROW(cnt::stencil(f, f, shift), std::invalid_argument);
+		EXPECT_THROW((cnt::DenseKernel<float, 2>(square, { 1.0f })), std::invalid_argument);
+		EXPECT_THROW((cnt::DenseKernel<float, 2>(empty, {})), std::invalid_argument);
+		EXPECT_THROW((cnt::SeparableKernel<float, 2>(std::vector<float>{})), std::invalid_argument);
+	}
+
+
+} // namespace
@@ -0,0 +1,211 @@
+#include <list>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/Strided.h"
+#include "Container/Parallel.h"
+
+
+namespace
+{
+	TEST(StridedTest, Creation)
+	{
+		static_assert(std::is_trivially_copyable<cnt::StridedView<int, 3>>::value, "");
+
+
+		cnt::Container<int, 0, 0, 0> c(10, 20, 30);
+		cnt::Container<int> d(10, 20, 30);
+		cnt::Container<int, 10, 20, 30> e;
+
+		auto a = cnt::strided(c, cnt::all, 2, cnt::range(1, 10, 2));
+		auto b = cnt::strided(d, 3, cnt::all, 0);
+		auto f = cnt::strided(e, cnt::range(2, 8));
+		auto g = cnt::strided(c, 1, 2, 3);
+
+
+		static_assert(std::is_same<decltype(a), cnt::StridedView<int, 2>>::value, "");
+		static_assert(std::is_same<decltype(b), cnt::StridedView<int, 1>>::value, "");
+		static_assert(std::is_same<decltype(f), cnt::StridedView<int, 3>>::value, "");
+		static_assert(std::is_same<decltype(g), cnt::StridedView<int, 0>>::value, "");
+
+		EXPECT_EQ(a.size(0), 10);
+		EXPECT_EQ(a.size(1), 5);
+		EXPECT_EQ(b.size(), 20);
+		EXPECT_EQ(f.size(0), 6);
+		EXPECT_EQ(f.size(2), 30);
+		EXPECT_EQ(g.size(), 1);
+
+		EXPECT_THROW(cnt::strided(d, 3), std::invalid_argument);
+		EXPECT_THROW(cnt::strided(c, cnt::range(0, 4, 0)), std::invalid_argument);
+		EXPECT_THROW(cnt::strided(c, cnt::range(0, 11), cnt::all), std::invalid_argument);
+		EXPECT_THROW(cnt::strided(c, cnt::range(12, 0)), std::invalid_argument);
+		EXPECT_THROW(cnt::strided(c, cnt::all, 20), std::invalid_argument);
+		EXPECT_THROW(cnt::strided(d, -1, 0, 0), std::invalid_argument);
+		EXPECT_EQ(cnt::strided(c, cnt::range(10, 10)).size(), 0);
+	}
+
+
+
+	TEST(StridedTest, Access)
+	{
+		cnt::Container<int> c(10, 20, 30);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		auto a = cnt::strided(c, cnt::all, 2, cnt::range(1, 10, 2));
+		auto b = cnt::strided(a, cnt::range(3, 10, 3));
+
+
+		EXPECT_EQ(a(4, 3), c(4, 2, 7));
+		EXPECT_EQ(a({4, 3}), c(4, 2, 7));
+		EXPECT_EQ(a(std::vector<int>{4, 3}), c(4, 2, 7));
+		EXPECT_EQ(a(std::make_tuple(4, 3)), c(4, 2, 7));
+		EXPECT_EQ(b(2, 1), c(9, 2, 3));
+
+
+		a(4, 3) = -1;
+
+		EXPECT_EQ(c(4, 2, 7), -1);
+	}
+
+
+
+	TEST(StridedTest, Looping)
+	{
+		cnt::Container<int> c(6, 7, 8);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		auto a = cnt::strided(c, cnt::range(1, 6, 2), cnt::all, cnt::range(0, 8, 3));
+
+		std::vector<int> expected;
+
+		for(int i = 1; i < 6; i += 2)
+			for(int j = 0; j < 7; ++j)
+				for(int k = 0; k < 8; k += 3)
+					expected.push_back(c(i, j, k));
+
+
+		EXPECT_TRUE(std::equal(expected.begin(), expected.end(), a.begin()));
+		EXPECT_EQ(std::distance(a.begin(), a.end()), expected.size());
+
+
+		/// The iterators do not depend on the view they were taken from
+		auto it = cnt::strided(c, 2, cnt::all, cnt::range(1, 8, 3)).begin();
+
+		++it;
+		++it;
+		++it;
+
+		EXPECT_EQ(*it, c(2, 1, 1));
+
+		std::vector<int> visited;
+
+		cnt::for_each(a, [&](int x){ visited.push_back(x); });
+
+		EXPECT_EQ(visited, expected);
+	}
+
+
+
+	TEST(StridedTest, Contiguous)
+	{
+		cnt::Container<int> c(6, 7, 8);
+
+		std::iota(c.begin(), c.end(), 0);
+
+
+		auto a = cnt::strided(c, cnt::range(2, 4), cnt::all, cnt::all);
+		auto b = cnt::strided(c, 3, cnt::range(0, 1), cnt::all);
+		auto d = cnt::strided(c, cnt::all, cnt::range(0, 3), cnt::all);
+		auto e = cnt::strided(c, cnt::all, cnt::all, 5);
+
+		EXPECT_TRUE(a.contiguous());
+		EXPECT_TRUE(b.contiguous());
+		EXPECT_FALSE(d.contiguous());
+		EXPECT_FALSE(e.contiguous());
+
+
+		int sum = 0;
+
+		cnt::for_each(a, [&](int x){ sum += x; });
+
+		EXPECT_EQ(sum, std::accumulate(c.begin() + 2*7*8, c.begin() + 4*7*8, 0));
+	}
+
+
+	TEST(StridedTest, Reshaped)
+	{
+		cnt::Container<int> c(120);
+		cnt::Container<int, 0, 0> d(10, 12);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		auto a = cnt::reshaped(c, 4, 5, 6);
+		auto b = cnt::reshaped(c.slice(), 120);
+
+		static_assert(std::is_same<decltype(a), cnt::StridedView<int, 3>>::value, "");
+
+		EXPECT_EQ(a(2, 3, 4), 2 * 30 + 3 * 6 + 4);
+		EXPECT_EQ(b(119), 119);
+		EXPECT_TRUE(a.contiguous());
+
+		a(1, 1, 1) = -1;
+
+		EXPECT_EQ(c[37], -1);
+
+
+		auto v = cnt::strided(d, cnt::range(0, 10, 2));
+
+		EXPECT_THROW(cnt::reshaped(c, 7, 17), std::invalid_argument);
+		EXPECT_THROW(cnt::reshaped(v, 60), std::invalid_argument);
+	}
+
+
+
+	TEST(StridedTest, Slice)
+	{
+		static_assert(std::is_trivially_copy_assignable<cnt::StridedView<const int, 2>>::value, "");
+
+
+		cnt::Container<int> c(6, 7, 8);
+		cnt::Container<int, 6, 7, 8> d;
+
+		std::iota(c.begin(), c.end(), 0);
+		std::iota(d.begin(), d.end(), 0);
+
+		auto a = cnt::strided<3>(c);
+		auto b = cnt::strided<2>(c.slice(4));
+		auto e = cnt::strided(d, cnt::range(1, 6, 2), cnt::all, cnt::range(0, 8, 3));
+
+		static_assert(std::is_same<decltype(a.slice(1)), cnt::StridedView<int, 2>>::value, "");
+		static_assert(std::is_same<decltype(a.slice(1, 2, 3)), cnt::StridedView<int, 0>>::value, "");
+
+		EXPECT_EQ(a.slice(2)(3, 4), c(2, 3, 4));
+		EXPECT_EQ(a.slice(2).slice(3)(4), c(2, 3, 4));
+		EXPECT_EQ(a.slice(2, 3, 4)(), c(2, 3, 4));
+		EXPECT_EQ(b(5, 6), c(4, 5, 6));
+		EXPECT_EQ(b.slice(5).data(), &c(4, 5, 0));
+		EXPECT_EQ(e.slice(2)(3, 1), d(5, 3, 3));
+		EXPECT_EQ(e.slice(1).slice(6).size(), 3);
+		EXPECT_EQ(e.slice(1).slice(6).strides()[0], 3);
+
+		EXPECT_THROW(cnt::strided<2>(c), std::invalid_argument);
+
+
+		/// Views are values: they can be assigned and given to other threads
+		auto row = a.slice(0, 0);
+
+		row = b.slice(1);
+
+		EXPECT_EQ(row(2), c(4, 1, 2));
+
+		cnt::ThreadPool::global().parallelFor(0, 6, 1, [a](std::size_t first, std::size_t last){
+			for(std::size_t i = first; i < last; ++i)
+				cnt::for_each(a.slice(i), [](int& x){ x = -x; });
+		});
+
+		EXPECT_EQ(c(5, 6, 7), -(5 * 56 + 6 * 8 + 7));
+		EXPECT_EQ(std::count_if(c.begin(), c.end(), [](int x){ return x > 0; }), 0);
+	}
+}
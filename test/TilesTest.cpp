@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "Container/Tiles.h"
+
+
+namespace
+{
+	TEST(TilesTest, Shapes)
+	{
+		cnt::Container<int, 0, 0> c(10, 7);
+		cnt::Container<int> d(4, 5, 6);
+		cnt::Container<int, 8, 8> e;
+
+		auto a = cnt::tiles(c, 4, 3);
+		auto b = cnt::tiles(d, std::array<std::size_t, 3>{ 2, 2, 4 });
+		auto f = cnt::tiles(e, 8, 8);
+
+
+		static_assert(std::is_same<decltype(a[0]), cnt::StridedView<int, 2>>::value, "");
+
+		EXPECT_EQ(a.size(), 9);
+		EXPECT_EQ(a.size(0), 3);
+		EXPECT_EQ(a.size(1), 3);
+		EXPECT_EQ(b.size(), 2 * 3 * 2);
+		EXPECT_EQ(f.size(), 1);
+
+		EXPECT_EQ(a[0].size(0), 4);
+		EXPECT_EQ(a[0].size(1), 3);
+		EXPECT_EQ(a[8].size(0), 2);
+		EXPECT_EQ(a[8].size(1), 1);
+		EXPECT_EQ(a.origin(5)[0], 4);
+		EXPECT_EQ(a.origin(5)[1], 6);
+
+		EXPECT_THROW(cnt::tiles(d, 2, 2), std::invalid_argument);
+		EXPECT_THROW(cnt::tiles(c, 0, 2), std::invalid_argument);
+	}
+
+
+
+	TEST(TilesTest, Traversal)
+	{
+		cnt::Container<int> c(9, 10, 11);
+
+		std::iota(c.begin(), c.end(), 0);
+
+		auto range = cnt::tiles(c, 4, 4, 4);
+
+		cnt::Container<int> count(9, 10, 11);
+
+		std::size_t t = 0;
+
+		for(auto tile : range)
+		{
+			const auto first = range.origin(t++);
+
+			for(int i = 0; i < tile.size(0); ++i)
+				for(int j = 0; j < tile.size(1); ++j)
+					for(int k = 0; k < tile.size(2); ++k)
+					{
+						EXPECT_EQ(tile(i, j, k), c(first[0] + i, first[1] + j, first[2] + k));
+
+						++count(first[0] + i, first[1] + j, first[2] + k);
+					}
+		}
+
+		EXPECT_EQ(t, range.size());
+		EXPECT_TRUE(std::all_of(count.begin(), count.end(), [](int x){ return x == 1; }));
+
+
+		auto v = cnt::strided(c, cnt::range(1, 9, 2), 3, cnt::all);
+		auto sub = cnt::tiles(v, 3, 5);
+
+		EXPECT_EQ(sub.size(), 2 * 3);
+		EXPECT_EQ(sub[5](0, 0), c(7, 3, 10));
+		EXPECT_EQ(sub[5].size(1), 1);
+
+
+		/// Temporary slices and views
+		auto slice = cnt::tiles(c.slice(2), 4, 4);
+
+		EXPECT_EQ(slice.size(), 3 * 3);
+		EXPECT_EQ(slice[4](1, 2), c(2, 5, 6));
+
+		auto every = cnt::tiles(cnt::strided(c, cnt::all, cnt::range(0, 10, 2), cnt::all), 4, 2, 8);
+
+		EXPECT_EQ(every.size(), 3 * 3 * 2);
+		EXPECT_EQ(every[every.size() - 1](0, 0, 2), c(8, 8, 10));
+	}
+
+
+
+	TEST(TilesTest, Parallel)
+	{
+		cnt::Container<int, 0, 0> c(1000, 300);
+		cnt::BasicContainer<int, cnt::Shape<0, 0>, std::allocator<int>, cnt::ColumnMajor> d(200, 150);
+
+		std::fill(c.begin(), c.end(), 1);
+		std::fill(d.begin(), d.end(), 1);
+
+
+		cnt::parallel_for_tiles(cnt::tiles(c, 64, 64), [](auto tile){
+			cnt::for_each(tile, [](int& x){ x *= 2; });
+		});
+
+		cnt::parallel_for_tiles(cnt::tiles(d, 16, 16), [](auto tile){
+			for(int i = 0; i < tile.size(0); ++i)
+				for(int j = 0; j < tile.size(1); ++j)
+					tile(i, j) += 1;
+		});
+
+		EXPECT_TRUE(std::all_of(c.begin(), c.end(), [](int x){ return x == 2; }));
+		EXPECT_TRUE(std::all_of(d.begin(), d.end(), [](int x){ return x == 2; }));
+	}
+
+
+} // namespace
@@ -0,0 +1,99 @@
+#include <list>
+#include <set>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "Container/View.h"
+
+
+namespace
+{
+	TEST(ViewTest, Creation)
+	{
+		static_assert(std::is_trivially_copyable<cnt::ContainerView<int, 2, 3>>::value, "");
+		static_assert(std::is_trivially_copyable<cnt::ContainerView<int, 0, 0, 0>>::value, "");
+		static_assert(sizeof(cnt::ContainerView<float, 4, 4>) == sizeof(float*), "");
+
+
+		std::vector<int> buffer(2*3*4*5);
+
+		cnt::ContainerView<int, 2, 3, 4, 5> a(buffer.data());
+		cnt::ContainerView<int, 0, 0, 0, 0> b(buffer.data(), 2, 3, 4, 5);
+		cnt::ContainerView<int, 0, 0, 0, 0> c(buffer.data(), {2, 3, 4, 5});
+		cnt::ContainerView<int, 0, 0, 0, 0> d(buffer.data(), std::vector<int>{2, 3}, std::list<long>{4, 5});
+		const auto sizes = b.sizes();
+		cnt::ContainerView<const int, 0, 0, 0, 0> e(buffer.data(), sizes.begin(), sizes.end());
+
+
+		for(int i = 0; i < 4; ++i)
+		{
+			EXPECT_EQ(a.size(i), b.size(i));
+			EXPECT_EQ(c.size(i), b.size(i));
+			EXPECT_EQ(d.size(i), b.size(i));
+			EXPECT_EQ(e.size(i), b.size(i));
+		}
+
+		EXPECT_EQ(a.size(), buffer.size());
+		EXPECT_EQ(b.size(), buffer.size());
+		EXPECT_EQ(e.data(), buffer.data());
+		EXPECT_EQ(e.end(), buffer.data() + buffer.size());
+	}
+
+
+
+	TEST(ViewTest, Access)
+	{
+		cnt::Container<int> v(7, 3, 6, 2);
+
+		std::iota(v.begin(), v.end(), 0);
+
+		cnt::ContainerView<int, 7, 3, 6, 2> a(v.data());
+		cnt::ContainerView<const int, 0, 0, 0, 0> b(v.data(), v.sizes());
+
+		int arr[] = {5, 2, 4, 1};
+
+		int x = v(5, 2, 4, 1);
+
+
+		EXPECT_EQ(a(5, 2, 4, 1), x);
+		EXPECT_EQ(b(5, 2, 4, 1), x);
+		EXPECT_EQ(b({5, 2, 4, 1}), x);
+		EXPECT_EQ(b(std::vector<int>{5, 2, 4, 1}), x);
+		EXPECT_EQ(b(std::set<int>{5}, 2, 4, std::list<int>{1}), x);
+		EXPECT_EQ(b(std::make_tuple(5, 2, 4, 1)), x);
+		EXPECT_EQ(b(&arr[0]), x);
+
+
+		a(5, 2, 4, 1) = -10;
+
+		EXPECT_EQ(v(5, 2, 4, 1), -10);
+		EXPECT_EQ(b(5, 2, 4, 1), -10);
+	}
+
+
+
+	TEST(ViewTest, Slice)
+	{
+		std::mt19937 gen(std::random_device{}());
+
+		std::vector<int> buffer(15*10*3*17);
+
+		std::generate(buffer.begin(), buffer.end(), [&]{ return std::uniform_int_distribution<>(0, 100)(gen); });
+
+
+		cnt::ContainerView<int, 0, 0, 0, 0> v(buffer.data(), 15, 10, 3, 17);
+
+		auto slc = v.slice(11, 4);
+
+		slc(2, 5) = 1000;
+
+
+		EXPECT_EQ(slc.size(), 3*17);
+		EXPECT_EQ(v(11, 4, 2, 5), 1000);
+
+		for(int i = 0, j = (11*10 + 4)*3*17; i < slc.size(); ++i, ++j)
+			EXPECT_EQ(slc[i], buffer[j]);
+	}
+
+
+} // namespace